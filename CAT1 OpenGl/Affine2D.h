@@ -0,0 +1,223 @@
+// Affine2D.h
+//
+// 2D affine transforms (translate, rotate, scale) for whole point arrays.
+// The programs used to move points one at a time, with a cos()/sin() call
+// for every rotated point. Here a transform is a single 2x3 matrix: the
+// pieces are composed once with then(), and the matrix is applied to all
+// points in one pass.
+//
+// Points can be kept in structure-of-arrays form (separate x and y arrays,
+// PointsSoA) or interleaved as x, y pairs (the Point structs of the
+// programs, vertex buffers). Both are transformed 8 floats at a time with
+// AVX2, 4 at a time with SSE4.1, or one at a time otherwise, following the
+// conventions of DDASimd.h. Interleaved pairs stay interleaved: each x
+// and y is duplicated into both lanes of its pair. Under FMA the first
+// product of each row is fused explicitly (affineDot), so scalar and
+// vector results still match. Output may be the input array itself,
+// which transforms in place without a second buffer.
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+// p * x + q * y + t. The compiler would fuse some of these products on its
+// own when FMA is available, and not the same ones in scalar and vector
+// code, so the fused form is written out.
+inline float affineDot(float p, float x, float q, float y, float t) {
+#if defined(__FMA__)
+    return std::fma(p, x, q * y) + t;
+#else
+    return p * x + q * y + t;
+#endif
+}
+
+#if defined(__AVX2__)
+inline __m256 affineDot8(__m256 p, __m256 x, __m256 q, __m256 y, __m256 t) {
+#if defined(__FMA__)
+    return _mm256_add_ps(_mm256_fmadd_ps(p, x, _mm256_mul_ps(q, y)), t);
+#else
+    return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p, x), _mm256_mul_ps(q, y)), t);
+#endif
+}
+#elif defined(__SSE4_1__)
+inline __m128 affineDot4(__m128 p, __m128 x, __m128 q, __m128 y, __m128 t) {
+#if defined(__FMA__)
+    return _mm_add_ps(_mm_fmadd_ps(p, x, _mm_mul_ps(q, y)), t);
+#else
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(p, x), _mm_mul_ps(q, y)), t);
+#endif
+}
+#endif
+
+// x' = a * x + b * y + tx
+// y' = c * x + d * y + ty
+struct Affine2D {
+    float a = 1.0f, b = 0.0f, tx = 0.0f;
+    float c = 0.0f, d = 1.0f, ty = 0.0f;
+
+    static Affine2D identity() { return Affine2D(); }
+
+    static Affine2D translation(float dx, float dy) {
+        Affine2D m;
+        m.tx = dx;
+        m.ty = dy;
+        return m;
+    }
+
+    static Affine2D scaling(float sx, float sy) {
+        Affine2D m;
+        m.a = sx;
+        m.d = sy;
+        return m;
+    }
+
+    static Affine2D scaling(float s) { return scaling(s, s); }
+
+    // Counter-clockwise by angle radians about the origin
+    static Affine2D rotation(double angle) {
+        Affine2D m;
+        m.a = float(std::cos(angle));
+        m.b = float(-std::sin(angle));
+        m.c = -m.b;
+        m.d = m.a;
+        return m;
+    }
+
+    // Rotation and scaling about (cx, cy) instead of the origin
+    static Affine2D rotationAbout(double angle, float cx, float cy) {
+        return translation(-cx, -cy).then(rotation(angle)).then(translation(cx, cy));
+    }
+
+    static Affine2D scalingAbout(float sx, float sy, float cx, float cy) {
+        return translation(-cx, -cy).then(scaling(sx, sy)).then(translation(cx, cy));
+    }
+
+    // This transform followed by next
+    Affine2D then(const Affine2D &next) const {
+        Affine2D m;
+        m.a = next.a * a + next.b * c;
+        m.b = next.a * b + next.b * d;
+        m.tx = next.a * tx + next.b * ty + next.tx;
+        m.c = next.c * a + next.d * c;
+        m.d = next.c * b + next.d * d;
+        m.ty = next.c * tx + next.d * ty + next.ty;
+        return m;
+    }
+
+    void apply(float x, float y, float &outX, float &outY) const {
+        float nx = affineDot(a, x, b, y, tx);
+        float ny = affineDot(c, x, d, y, ty);
+        outX = nx;
+        outY = ny;
+    }
+};
+
+// Points in structure-of-arrays layout
+struct PointsSoA {
+    std::vector<float> x, y;
+
+    size_t size() const { return x.size(); }
+
+    void reserve(size_t n) {
+        x.reserve(n);
+        y.reserve(n);
+    }
+
+    void push_back(float px, float py) {
+        x.push_back(px);
+        y.push_back(py);
+    }
+};
+
+// (outX[i], outY[i]) = m applied to (x[i], y[i]) for count points.
+// outX / outY may be x / y themselves.
+inline void transformPoints(const Affine2D &m, const float *x, const float *y, float *outX, float *outY,
+                            size_t count) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 a = _mm256_set1_ps(m.a), b = _mm256_set1_ps(m.b), tx = _mm256_set1_ps(m.tx);
+    const __m256 c = _mm256_set1_ps(m.c), d = _mm256_set1_ps(m.d), ty = _mm256_set1_ps(m.ty);
+    for (; i + 8 <= count; i += 8) {
+        __m256 px = _mm256_loadu_ps(x + i), py = _mm256_loadu_ps(y + i);
+        _mm256_storeu_ps(outX + i, affineDot8(a, px, b, py, tx));
+        _mm256_storeu_ps(outY + i, affineDot8(c, px, d, py, ty));
+    }
+#elif defined(__SSE4_1__)
+    const __m128 a = _mm_set1_ps(m.a), b = _mm_set1_ps(m.b), tx = _mm_set1_ps(m.tx);
+    const __m128 c = _mm_set1_ps(m.c), d = _mm_set1_ps(m.d), ty = _mm_set1_ps(m.ty);
+    for (; i + 4 <= count; i += 4) {
+        __m128 px = _mm_loadu_ps(x + i), py = _mm_loadu_ps(y + i);
+        _mm_storeu_ps(outX + i, affineDot4(a, px, b, py, tx));
+        _mm_storeu_ps(outY + i, affineDot4(c, px, d, py, ty));
+    }
+#endif
+    for (; i < count; i++) m.apply(x[i], y[i], outX[i], outY[i]);
+}
+
+inline void transformPoints(const Affine2D &m, const PointsSoA &in, PointsSoA &out) {
+    out.x.resize(in.size());
+    out.y.resize(in.size());
+    transformPoints(m, in.x.data(), in.y.data(), out.x.data(), out.y.data(), in.size());
+}
+
+inline void transformPointsInPlace(const Affine2D &m, PointsSoA &points) {
+    transformPoints(m, points.x.data(), points.y.data(), points.x.data(), points.y.data(), points.size());
+}
+
+// Interleaved x0, y0, x1, y1, ... for count points; out may be xy itself
+inline void transformInterleaved(const Affine2D &m, const float *xy, float *out, size_t count) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    // Each register holds 4 points: x' in the even lanes, y' in the odd ones
+    const __m256 ac = _mm256_setr_ps(m.a, m.c, m.a, m.c, m.a, m.c, m.a, m.c);
+    const __m256 bd = _mm256_setr_ps(m.b, m.d, m.b, m.d, m.b, m.d, m.b, m.d);
+    const __m256 t = _mm256_setr_ps(m.tx, m.ty, m.tx, m.ty, m.tx, m.ty, m.tx, m.ty);
+    for (; i + 4 <= count; i += 4) {
+        __m256 p = _mm256_loadu_ps(xy + 2 * i);
+        __m256 px = _mm256_moveldup_ps(p), py = _mm256_movehdup_ps(p); // x0 x0 x1 x1 ..., y0 y0 y1 y1 ...
+        _mm256_storeu_ps(out + 2 * i, affineDot8(ac, px, bd, py, t));
+    }
+#elif defined(__SSE4_1__)
+    const __m128 ac = _mm_setr_ps(m.a, m.c, m.a, m.c);
+    const __m128 bd = _mm_setr_ps(m.b, m.d, m.b, m.d);
+    const __m128 t = _mm_setr_ps(m.tx, m.ty, m.tx, m.ty);
+    for (; i + 2 <= count; i += 2) {
+        __m128 p = _mm_loadu_ps(xy + 2 * i);
+        __m128 px = _mm_moveldup_ps(p), py = _mm_movehdup_ps(p);
+        _mm_storeu_ps(out + 2 * i, affineDot4(ac, px, bd, py, t));
+    }
+#endif
+    for (; i < count; i++) m.apply(xy[2 * i], xy[2 * i + 1], out[2 * i], out[2 * i + 1]);
+}
+
+// Any vertex type with members x and y. Plain { float x, y; } structs go
+// through transformInterleaved(); out may be in itself.
+template <class Vertex>
+void transformPoints(const Affine2D &m, const Vertex *in, Vertex *out, size_t count) {
+    constexpr bool packed = std::is_standard_layout<Vertex>::value && std::is_same<decltype(Vertex::x), float>::value &&
+                            std::is_same<decltype(Vertex::y), float>::value && sizeof(Vertex) == 2 * sizeof(float) &&
+                            offsetof(Vertex, x) == 0 && offsetof(Vertex, y) == sizeof(float);
+    if constexpr (packed) {
+        transformInterleaved(m, &in->x, &out->x, count);
+    }
+    else {
+        for (size_t i = 0; i < count; i++) {
+            float x, y;
+            m.apply(float(in[i].x), float(in[i].y), x, y);
+            out[i].x = x;
+            out[i].y = y;
+        }
+    }
+}
+
+template <class Vertex>
+void transformPointsInPlace(const Affine2D &m, Vertex *points, size_t count) {
+    transformPoints(m, points, points, count);
+}
@@ -0,0 +1,133 @@
+// ArcTessellation.h
+//
+// Circles and arcs as line loops and triangle fans with just enough
+// segments for the size they appear on screen. The programs used a fixed
+// count (100 segments, or a vertex per degree) whatever the radius, so small
+// markers sent hundreds of vertices and very large circles still showed
+// corners. Here the count comes from a pixel tolerance: a chord of a circle
+// of radius r pixels spanning angle t leaves the arc by r (1 - cos(t / 2)),
+// and the segments are made short enough to keep that under the tolerance.
+// The radius in pixels comes from the orthographic projection (OrthoView).
+//
+// Counts are rounded up to a power of two, a level of detail, and the unit
+// circle points of every level are computed once and kept in tables. An arc
+// uses the table points that fall inside it plus its two exact ends, so
+// arcs that meet (the slices of a pie) share their end points exactly.
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+const int ARC_MIN_LEVEL = 3;  // 8 segments around a full circle
+const int ARC_MAX_LEVEL = 12; // 4096 segments, enough up to a radius of about 850000 pixels
+
+// glOrtho(left, right, bottom, top) shown in a width x height pixel viewport
+struct OrthoView {
+    double left, right, bottom, top;
+    int width, height;
+
+    // Pixels per world unit. The larger of the two axes, so the tolerance
+    // holds in both directions when the scales differ.
+    double pixelsPerUnit() const {
+        double sx = width / std::fabs(right - left), sy = height / std::fabs(top - bottom);
+        return sx > sy ? sx : sy;
+    }
+};
+
+// Level (log2 of the segments around a full circle) for a circle of
+// radius world units, so no chord strays more than tolerance pixels
+inline int arcLevel(double radius, const OrthoView &view, double tolerance = 0.25) {
+    double pixels = std::fabs(radius) * view.pixelsPerUnit();
+    if (!(pixels > tolerance)) return ARC_MIN_LEVEL;
+    double halfStep = std::acos(1.0 - tolerance / pixels); // Largest t / 2 allowed
+    double segments = 3.14159265358979323846 / halfStep;
+    int level = ARC_MIN_LEVEL;
+    while (level < ARC_MAX_LEVEL && double(1 << level) < segments) level++;
+    return level;
+}
+
+// Unit circle at level: cos, sin pairs for the 2^level angles k 2 pi / 2^level.
+// Every level is a subsample of the finest one, so a point has the same
+// coordinates at all levels.
+inline const std::vector<float> &unitCircleTable(int level) {
+    struct Tables {
+        std::vector<float> levels[ARC_MAX_LEVEL + 1];
+
+        Tables() {
+            const size_t finest = size_t(1) << ARC_MAX_LEVEL;
+            std::vector<float> &top = levels[ARC_MAX_LEVEL];
+            top.resize(2 * finest);
+            for (size_t k = 0; k < finest; k++) {
+                double angle = 2.0 * 3.14159265358979323846 * double(k) / double(finest);
+                top[2 * k] = float(std::cos(angle));
+                top[2 * k + 1] = float(std::sin(angle));
+            }
+            for (int level = ARC_MIN_LEVEL; level < ARC_MAX_LEVEL; level++) {
+                size_t count = size_t(1) << level, stride = finest / count;
+                levels[level].resize(2 * count);
+                for (size_t k = 0; k < count; k++) {
+                    levels[level][2 * k] = top[2 * k * stride];
+                    levels[level][2 * k + 1] = top[2 * k * stride + 1];
+                }
+            }
+        }
+    };
+    static const Tables tables; // Built on first use
+    if (level < ARC_MIN_LEVEL) level = ARC_MIN_LEVEL;
+    if (level > ARC_MAX_LEVEL) level = ARC_MAX_LEVEL;
+    return tables.levels[level];
+}
+
+// Full circle at level, 2^level x, y pairs appended to xy (no repeated
+// first point: draw with GL_LINE_LOOP, or add the centre for a fan).
+// Returns the number of points added.
+inline size_t tessellateCircle(float cx, float cy, float radius, int level, std::vector<float> &xy) {
+    const std::vector<float> &table = unitCircleTable(level);
+    size_t count = table.size() / 2;
+    xy.reserve(xy.size() + 2 * count);
+    for (size_t k = 0; k < count; k++) {
+        xy.push_back(cx + radius * table[2 * k]);
+        xy.push_back(cy + radius * table[2 * k + 1]);
+    }
+    return count;
+}
+
+// Arc counter-clockwise from angle start to end (radians, end >= start;
+// more than a full turn is cut to one), both ends included, appended to xy
+// as x, y pairs. The points between are the table points of level that lie
+// strictly inside the arc. Returns the number of points added.
+inline size_t tessellateArc(float cx, float cy, float radius, double start, double end, int level,
+                            std::vector<float> &xy) {
+    const std::vector<float> &table = unitCircleTable(level);
+    const long long count = (long long)(table.size() / 2);
+    const double step = 2.0 * 3.14159265358979323846 / double(count);
+    if (end - start > 2.0 * 3.14159265358979323846) end = start + 2.0 * 3.14159265358979323846;
+    if (end < start) end = start;
+
+    size_t before = xy.size();
+    xy.push_back(cx + radius * float(std::cos(start)));
+    xy.push_back(cy + radius * float(std::sin(start)));
+    // Table points clear of both ends by a sliver of a step, so an end that
+    // lands on a table angle is not emitted twice
+    const double margin = 1e-6 * step;
+    long long first = (long long)std::floor((start + margin) / step) + 1;
+    long long last = (long long)std::ceil((end - margin) / step) - 1;
+    for (long long k = first; k <= last; k++) {
+        long long i = ((k % count) + count) % count;
+        xy.push_back(cx + radius * table[2 * i]);
+        xy.push_back(cy + radius * table[2 * i + 1]);
+    }
+    xy.push_back(cx + radius * float(std::cos(end)));
+    xy.push_back(cy + radius * float(std::sin(end)));
+    return (xy.size() - before) / 2;
+}
+
+// Pie slice as a triangle fan: the centre, then the arc
+inline size_t tessellateSector(float cx, float cy, float radius, double start, double end, int level,
+                               std::vector<float> &xy) {
+    xy.push_back(cx);
+    xy.push_back(cy);
+    return 1 + tessellateArc(cx, cy, radius, start, end, level, xy);
+}
@@ -0,0 +1,148 @@
+// FloodFill.h
+//
+// Seed fill over a software raster (PixelMask).
+// Any of the rasterizers can draw a boundary into the mask, since it
+// provides the usual plot(x, y) and fillRow(x0, x1, y). floodFill() then
+// replaces the region of equal cells around a seed, with 4- or
+// 8-connectivity.
+//
+// The fill is a span-stack scanline fill in the manner of Heckbert ("A Seed
+// Fill Algorithm", Graphics Gems 1990). Each stack entry is a run of pixels
+// still to be continued into the row above or below, never a single pixel,
+// and nothing recurses. The stack is a heap-allocated std::vector with no
+// cap: it holds at most three entries per run written, so its worst case
+// (a comb or maze of one-pixel runs) still grows with the area filled.
+// For an open region it stays at a few entries per boundary crossing of a
+// scanline, where a recursive pixel fill would need one call stack frame
+// per pixel. FloodFillStats::maxStack reports the depth a fill reached.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Cell values used by the fills in this folder
+const uint8_t MASK_EMPTY = 0;
+const uint8_t MASK_BOUNDARY = 1;
+const uint8_t MASK_FILLED = 2;
+
+// One byte per pixel over the window xMin..xMax, yMin..yMax
+struct PixelMask {
+    int width, height;
+    int originX, originY; // Pixel (x, y) is stored at (x + originX, y + originY)
+    uint8_t value = MASK_BOUNDARY; // Written by plot() and fillRow()
+    std::vector<uint8_t> cells;
+
+    PixelMask(int xMin, int xMax, int yMin, int yMax)
+        : width(std::max(0, xMax - xMin + 1)), height(std::max(0, yMax - yMin + 1)), originX(-xMin), originY(-yMin),
+          cells(size_t(width) * height, MASK_EMPTY) {}
+
+    bool contains(int x, int y) const {
+        return unsigned(x + originX) < unsigned(width) && unsigned(y + originY) < unsigned(height);
+    }
+
+    uint8_t at(int x, int y) const { return cells[size_t(y + originY) * width + (x + originX)]; }
+
+    void plot(int x, int y) {
+        if (contains(x, y)) cells[size_t(y + originY) * width + (x + originX)] = value;
+    }
+
+    void fillRow(int x0, int x1, int y) {
+        if (x0 > x1) std::swap(x0, x1);
+        if (unsigned(y + originY) >= unsigned(height)) return;
+        x0 = std::max(x0 + originX, 0);
+        x1 = std::min(x1 + originX, width - 1);
+        if (x0 > x1) return;
+        uint8_t *row = &cells[size_t(y + originY) * width];
+        std::fill(row + x0, row + x1 + 1, value);
+    }
+};
+
+// What a fill did: pixels changed, spans written and the deepest the span stack got
+struct FloodFillStats {
+    size_t pixels = 0;
+    size_t spans = 0;
+    size_t maxStack = 0;
+};
+
+// No-op span callback for floodFill()
+struct IgnoreSpans {
+    void operator()(int, int, int) const {}
+};
+
+// Replace the cells connected to (seedX, seedY) that hold the seed's value
+// with fill (must differ from it). connectivity is 4 or 8; with 8 the fill
+// also passes diagonal gaps, so it leaks through a 4-connected boundary.
+// onSpan(x0, x1, y) is called for every run written, in mask coordinates.
+template <class OnSpan = IgnoreSpans>
+FloodFillStats floodFill(PixelMask &mask, int seedX, int seedY, uint8_t fill, int connectivity = 4,
+                         OnSpan onSpan = OnSpan()) {
+    FloodFillStats stats;
+    if (!mask.contains(seedX, seedY)) return stats;
+    uint8_t target = mask.at(seedX, seedY);
+    if (target == fill) return stats;
+
+    // Work in storage coordinates
+    const int w = mask.width, h = mask.height;
+    uint8_t *cells = mask.cells.data();
+    const int reach = (connectivity == 8) ? 1 : 0; // Extra columns seen diagonally in the next row
+    auto inside = [&](int x, int y) { return cells[size_t(y) * w + x] == target; };
+
+    // Run x1..x2 of row y is filled; continue it into row y + dy
+    struct Segment {
+        int y, x1, x2, dy;
+    };
+    std::vector<Segment> stack;
+    stack.reserve(64);
+    auto push = [&](int y, int x1, int x2, int dy) {
+        if (y + dy < 0 || y + dy >= h) return;
+        stack.push_back({y, x1, x2, dy});
+        stats.maxStack = std::max(stats.maxStack, stack.size());
+    };
+    auto write = [&](int x1, int x2, int y) {
+        std::fill(cells + size_t(y) * w + x1, cells + size_t(y) * w + x2 + 1, fill);
+        stats.pixels += size_t(x2 - x1 + 1);
+        stats.spans++;
+        onSpan(x1 - mask.originX, x2 - mask.originX, y - mask.originY);
+    };
+
+    // Fill the seed's run first
+    int sx = seedX + mask.originX, sy = seedY + mask.originY;
+    int left = sx, right = sx;
+    while (left > 0 && inside(left - 1, sy)) left--;
+    while (right < w - 1 && inside(right + 1, sy)) right++;
+    write(left, right, sy);
+    push(sy, left, right, 1);
+    push(sy, left, right, -1);
+
+    while (!stack.empty()) {
+        Segment s = stack.back();
+        stack.pop_back();
+        int y = s.y + s.dy;
+        int x1 = std::max(s.x1 - reach, 0), x2 = std::min(s.x2 + reach, w - 1);
+
+        // Runs of row y that touch x1..x2; each may extend past either end
+        int x = x1;
+        while (x <= x2) {
+            if (!inside(x, y)) {
+                x++;
+                continue;
+            }
+            int l = x;
+            while (l > 0 && inside(l - 1, y)) l--;
+            int r = x;
+            while (r < w - 1 && inside(r + 1, y)) r++;
+            write(l, r, y);
+
+            push(y, l, r, s.dy);
+            // Parts that see beyond the parent run may also continue back the
+            // way we came; the pushed run is widened by reach again when popped
+            if (l - reach < s.x1) push(y, l, std::max(l, s.x1 - 1 - reach), -s.dy);
+            if (r + reach > s.x2) push(y, std::min(r, s.x2 + 1 + reach), r, -s.dy);
+            x = r + 2; // r + 1 is not inside
+        }
+    }
+    return stats;
+}
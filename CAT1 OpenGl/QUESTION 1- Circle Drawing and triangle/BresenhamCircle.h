@@ -0,0 +1,218 @@
+// BresenhamCircle.h
+//
+// Bresenham's circle algorithm shared by the Question 1 programs.
+// The kernel only decides which pixels belong to the circle; it hands each
+// one to a Target that provides
+//     void plot(int x, int y);
+// so the same code can fill a vertex list for OpenGL or a headless buffer.
+//
+// For many circles of one radius (scatter-plot markers) CircleStamp runs the
+// algorithm over a single octant once and keeps the result as offsets from
+// the centre: the distinct outline pixels, and the half-width of every row
+// of the filled disc. Drawing a marker is then a copy of those offsets into
+// a preallocated buffer, with no decision variable and no duplicate pixels
+// where the octants meet.
+//
+// rasterCircleOrdered() and the stamp's outline give the pixels in
+// counter-clockwise order around the centre, one octant after another, so
+// a triangle fan or line loop can be built straight from them without
+// sorting by angle.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Plot the eight symmetric points of the circle
+template <class Target>
+void plotCirclePoints(int cx, int cy, int x, int y, Target &target) {
+    target.plot(cx + x, cy + y);
+    target.plot(cx - x, cy + y);
+    target.plot(cx + x, cy - y);
+    target.plot(cx - x, cy - y);
+    target.plot(cx + y, cy + x);
+    target.plot(cx - y, cy + x);
+    target.plot(cx + y, cy - x);
+    target.plot(cx - y, cy - x);
+}
+
+// Bresenham Circle Drawing Algorithm (using integer arithmetic)
+template <class Target>
+void rasterCircleBresenham(int cx, int cy, int radius, Target &target) {
+    int x = 0;
+    int y = radius;
+    int d = 3 - (2 * radius);
+
+    while (x <= y) {
+        plotCirclePoints(cx, cy, x, y, target);
+        if (d < 0) {
+            d += (4 * x) + 6;
+        } else {
+            d += (4 * (x - y)) + 10;
+            y--;
+        }
+        x++;
+    }
+}
+
+// The octant 0 <= x <= y of the Bresenham circle, as x, y pairs from
+// (0, radius) toward the diagonal (clockwise)
+inline void bresenhamOctant(int radius, std::vector<int> &octant) {
+    octant.clear();
+    int x = 0;
+    int y = radius;
+    int d = 3 - (2 * radius);
+
+    while (x <= y) {
+        octant.push_back(x);
+        octant.push_back(y);
+        if (d < 0) {
+            d += (4 * x) + 6;
+        } else {
+            d += (4 * (x - y)) + 10;
+            y--;
+        }
+        x++;
+    }
+}
+
+// Call emit(dx, dy) for the offset of every distinct outline pixel, in
+// counter-clockwise order starting at (radius, 0). The eight octants are
+// mirror images of the one given; every other one runs backwards through
+// it, and the pixels where two octants meet are emitted once.
+template <class Emit>
+void forEachCircleOffsetOrdered(const std::vector<int> &octant, Emit emit) {
+    const int *p = octant.data();
+    const int n = int(octant.size() / 2);
+    if (n == 0) return;
+    int firstX = p[1], firstY = p[0]; // Octant 0 starts at (y, x) of the first point
+    int lastX = firstX, lastY = firstY;
+    bool started = false;
+    auto put = [&](int x, int y) {
+        if (started && x == lastX && y == lastY) return; // Shared with the previous octant
+        if (started && x == firstX && y == firstY) return; // Back at the start
+        emit(x, y);
+        lastX = x;
+        lastY = y;
+        started = true;
+    };
+    for (int i = 0; i < n; i++) put(p[2 * i + 1], p[2 * i]);          // 0..45 degrees: (y, x)
+    for (int i = n - 1; i >= 0; i--) put(p[2 * i], p[2 * i + 1]);     // 45..90: (x, y)
+    for (int i = 0; i < n; i++) put(-p[2 * i], p[2 * i + 1]);         // 90..135: (-x, y)
+    for (int i = n - 1; i >= 0; i--) put(-p[2 * i + 1], p[2 * i]);    // 135..180: (-y, x)
+    for (int i = 0; i < n; i++) put(-p[2 * i + 1], -p[2 * i]);        // 180..225: (-y, -x)
+    for (int i = n - 1; i >= 0; i--) put(-p[2 * i], -p[2 * i + 1]);   // 225..270: (-x, -y)
+    for (int i = 0; i < n; i++) put(p[2 * i], -p[2 * i + 1]);         // 270..315: (x, -y)
+    for (int i = n - 1; i >= 0; i--) put(p[2 * i + 1], -p[2 * i]);    // 315..360: (y, -x)
+}
+
+// The distinct pixels of the Bresenham circle, counter-clockwise from
+// (cx + radius, cy). Only one octant is kept, in octant (reused between calls
+// when given).
+template <class Target>
+void rasterCircleOrdered(int cx, int cy, int radius, Target &target, std::vector<int> &octant) {
+    bresenhamOctant(radius, octant);
+    forEachCircleOffsetOrdered(octant, [&](int dx, int dy) { target.plot(cx + dx, cy + dy); });
+}
+
+template <class Target>
+void rasterCircleOrdered(int cx, int cy, int radius, Target &target) {
+    std::vector<int> octant;
+    rasterCircleOrdered(cx, cy, radius, target, octant);
+}
+
+// Target that appends every plotted point to a flat x, y, x, y, ... list
+struct CircleVertexList {
+    std::vector<float> &vertices;
+
+    void plot(int x, int y) {
+        vertices.push_back(x);
+        vertices.push_back(y);
+    }
+};
+
+// Horizontal run of pixels x0..x1 on row y
+struct CircleSpan {
+    int x0, x1, y;
+};
+
+// Bresenham circle of one radius, computed once from a single octant
+struct CircleStamp {
+    int radius;
+    std::vector<int> outline;   // x, y offsets of the distinct outline pixels, counter-clockwise
+    std::vector<int> halfWidth; // Row dy of the disc covers -halfWidth[dy + radius] .. halfWidth[dy + radius]
+
+    explicit CircleStamp(int r) : radius(r < 0 ? 0 : r), halfWidth(2 * (r < 0 ? 0 : r) + 1, 0) {
+        std::vector<int> octant;
+        bresenhamOctant(radius, octant);
+        forEachCircleOffsetOrdered(octant, [this](int x, int y) { addPixel(x, y); });
+    }
+
+    size_t outlinePixels() const { return outline.size() / 2; }
+    size_t discSpans() const { return halfWidth.size(); }
+
+private:
+    void addPixel(int x, int y) {
+        outline.push_back(x);
+        outline.push_back(y);
+        int &w = halfWidth[y + radius];
+        if (x > w) w = x;
+    }
+
+};
+
+// Write the outline of the circle centred at (cx, cy) as x, y, x, y, ... into
+// vertices, which must hold 2 * stamp.outlinePixels() floats.
+// Returns the number of floats written.
+inline size_t writeCircleOutline(const CircleStamp &stamp, float cx, float cy, float *vertices) {
+    const int *offset = stamp.outline.data();
+    size_t n = stamp.outline.size();
+    for (size_t i = 0; i < n; i += 2) {
+        vertices[i] = cx + offset[i];
+        vertices[i + 1] = cy + offset[i + 1];
+    }
+    return n;
+}
+
+// Write the rows of the filled disc centred at (cx, cy) into spans, which
+// must hold stamp.discSpans() entries. Returns the number of spans written.
+inline size_t writeDiscSpans(const CircleStamp &stamp, int cx, int cy, CircleSpan *spans) {
+    const int *w = stamp.halfWidth.data();
+    int rows = int(stamp.halfWidth.size());
+    int y = cy - stamp.radius;
+    for (int i = 0; i < rows; i++, y++) {
+        spans[i].x0 = cx - w[i];
+        spans[i].x1 = cx + w[i];
+        spans[i].y = y;
+    }
+    return size_t(rows);
+}
+
+// Outlines of count markers centred at centres[2i], centres[2i + 1], written
+// back to back; vertices must hold count * 2 * stamp.outlinePixels() floats.
+// Returns the number of floats written.
+inline size_t writeCircleMarkers(const CircleStamp &stamp, const float *centres, size_t count, float *vertices) {
+    size_t written = 0;
+    for (size_t i = 0; i < count; i++) {
+        written += writeCircleOutline(stamp, centres[2 * i], centres[2 * i + 1], vertices + written);
+    }
+    return written;
+}
+
+// Plot the outline pixels of the circle centred at (cx, cy) into a target
+template <class Target>
+void plotCircleOutline(const CircleStamp &stamp, int cx, int cy, Target &target) {
+    const int *offset = stamp.outline.data();
+    for (size_t i = 0; i < stamp.outline.size(); i += 2) {
+        target.plot(cx + offset[i], cy + offset[i + 1]);
+    }
+}
+
+// Fill the disc centred at (cx, cy) in a target that provides fillRow(x0, x1, y)
+template <class Target>
+void fillDisc(const CircleStamp &stamp, int cx, int cy, Target &target) {
+    int y = cy - stamp.radius;
+    for (int w : stamp.halfWidth) {
+        target.fillRow(cx - w, cx + w, y++);
+    }
+}
@@ -0,0 +1,426 @@
+// Circumcircle.h
+//
+// Circumcircles and the two predicates that decide on them:
+//     orient2d(a, b, c)  > 0 when a, b, c turn counter-clockwise,
+//                        < 0 clockwise, 0 when they are collinear;
+//     incircle(a, b, c, d) > 0 when d is inside the circle through a, b, c
+//                        (taken counter-clockwise), < 0 outside, 0 on it.
+// The signs are always exact. Each predicate is first evaluated in double
+// precision together with Shewchuk's bound on its rounding error; only when
+// the value is smaller than the bound (nearly collinear or cocircular
+// input) is it evaluated again in exact arithmetic, with floating-point
+// expansions (J. R. Shewchuk, "Adaptive Precision Floating-Point Arithmetic
+// and Fast Robust Geometric Predicates", 1997). That is rare, so the cost
+// is close to the plain double formula.
+//
+// The batch functions take triangles in structure-of-arrays form and run
+// the double-precision stage 4 triangles at a time with AVX2 or 2 at a
+// time with SSE4.1 (-mavx2 / -msse4.1); lanes the bound cannot decide go
+// through the exact stage one at a time. Compilers may fuse the products
+// into FMA instructions; that only removes roundings, so the bounds still
+// hold.
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+// ---------------------------------------------------------------------------
+// Exact arithmetic: a value is an expansion, a sum of doubles whose bits do
+// not overlap, smallest first and without zeros
+
+typedef std::vector<double> Expansion;
+
+// x + y == a + b exactly, x = fl(a + b)
+inline void twoSum(double a, double b, double &x, double &y) {
+    x = a + b;
+    double bVirtual = x - a;
+    double aVirtual = x - bVirtual;
+    y = (a - aVirtual) + (b - bVirtual);
+}
+
+// x + y == a - b exactly
+inline void twoDiff(double a, double b, double &x, double &y) {
+    x = a - b;
+    double bVirtual = a - x;
+    double aVirtual = x + bVirtual;
+    y = (a - aVirtual) + (bVirtual - b);
+}
+
+// x + y == a * b exactly; the fused multiply-add gives the rounding error
+inline void twoProduct(double a, double b, double &x, double &y) {
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+// a - b as an expansion
+inline Expansion expansionDiff(double a, double b) {
+    double x, y;
+    twoDiff(a, b, x, y);
+    Expansion e;
+    if (y != 0.0) e.push_back(y);
+    if (x != 0.0) e.push_back(x);
+    return e;
+}
+
+// e + b
+inline Expansion expansionGrow(const Expansion &e, double b) {
+    Expansion h;
+    double q = b;
+    for (double component : e) {
+        double sum, err;
+        twoSum(q, component, sum, err);
+        if (err != 0.0) h.push_back(err);
+        q = sum;
+    }
+    if (q != 0.0 || h.empty()) h.push_back(q);
+    if (h.size() == 1 && h[0] == 0.0) h.clear();
+    return h;
+}
+
+inline Expansion expansionSum(const Expansion &e, const Expansion &f) {
+    Expansion h = e;
+    for (double component : f) h = expansionGrow(h, component);
+    return h;
+}
+
+// e * b
+inline Expansion expansionScale(const Expansion &e, double b) {
+    Expansion h;
+    if (e.empty() || b == 0.0) return h;
+    double q, err;
+    twoProduct(e[0], b, q, err);
+    if (err != 0.0) h.push_back(err);
+    for (size_t i = 1; i < e.size(); i++) {
+        double product1, product0, sum;
+        twoProduct(e[i], b, product1, product0);
+        twoSum(q, product0, sum, err);
+        if (err != 0.0) h.push_back(err);
+        twoSum(product1, sum, q, err); // |product1| >= |sum|
+        if (err != 0.0) h.push_back(err);
+    }
+    if (q != 0.0) h.push_back(q);
+    return h;
+}
+
+inline Expansion expansionProduct(const Expansion &e, const Expansion &f) {
+    Expansion h;
+    for (double component : f) h = expansionSum(h, expansionScale(e, component));
+    return h;
+}
+
+inline Expansion expansionNegate(Expansion e) {
+    for (double &component : e) component = -component;
+    return e;
+}
+
+// The largest component has the sign of the whole sum
+inline double expansionEstimate(const Expansion &e) { return e.empty() ? 0.0 : e.back(); }
+
+// ---------------------------------------------------------------------------
+// Predicates
+
+// Half an ulp of 1.0, and Shewchuk's first-stage error bounds
+const double PREDICATE_EPSILON = std::numeric_limits<double>::epsilon() / 2.0;
+const double ORIENT_ERROR_BOUND = (3.0 + 16.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+const double INCIRCLE_ERROR_BOUND = (10.0 + 96.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+
+inline double orient2dExact(double ax, double ay, double bx, double by, double cx, double cy) {
+    Expansion acx = expansionDiff(ax, cx), acy = expansionDiff(ay, cy);
+    Expansion bcx = expansionDiff(bx, cx), bcy = expansionDiff(by, cy);
+    return expansionEstimate(
+        expansionSum(expansionProduct(acx, bcy), expansionNegate(expansionProduct(acy, bcx))));
+}
+
+// Twice the signed area of a, b, c; the sign is exact and the value is
+// within the error bound of the true one
+inline double orient2d(double ax, double ay, double bx, double by, double cx, double cy) {
+    double detLeft = (ax - cx) * (by - cy);
+    double detRight = (ay - cy) * (bx - cx);
+    double det = detLeft - detRight;
+    double detSum;
+    if (detLeft > 0.0) {
+        if (detRight <= 0.0) return det;
+        detSum = detLeft + detRight;
+    }
+    else if (detLeft < 0.0) {
+        if (detRight >= 0.0) return det;
+        detSum = -detLeft - detRight;
+    }
+    else return det;
+    double bound = ORIENT_ERROR_BOUND * detSum;
+    if (det >= bound || -det >= bound) return det;
+    return orient2dExact(ax, ay, bx, by, cx, cy);
+}
+
+inline double incircleExact(double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy) {
+    Expansion adx = expansionDiff(ax, dx), ady = expansionDiff(ay, dy);
+    Expansion bdx = expansionDiff(bx, dx), bdy = expansionDiff(by, dy);
+    Expansion cdx = expansionDiff(cx, dx), cdy = expansionDiff(cy, dy);
+    Expansion aLift = expansionSum(expansionProduct(adx, adx), expansionProduct(ady, ady));
+    Expansion bLift = expansionSum(expansionProduct(bdx, bdx), expansionProduct(bdy, bdy));
+    Expansion cLift = expansionSum(expansionProduct(cdx, cdx), expansionProduct(cdy, cdy));
+    Expansion bc = expansionSum(expansionProduct(bdx, cdy), expansionNegate(expansionProduct(cdx, bdy)));
+    Expansion ca = expansionSum(expansionProduct(cdx, ady), expansionNegate(expansionProduct(adx, cdy)));
+    Expansion ab = expansionSum(expansionProduct(adx, bdy), expansionNegate(expansionProduct(bdx, ady)));
+    Expansion det = expansionSum(expansionProduct(aLift, bc), expansionProduct(bLift, ca));
+    return expansionEstimate(expansionSum(det, expansionProduct(cLift, ab)));
+}
+
+inline double incircle(double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy) {
+    double adx = ax - dx, bdx = bx - dx, cdx = cx - dx;
+    double ady = ay - dy, bdy = by - dy, cdy = cy - dy;
+
+    double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+    double aLift = adx * adx + ady * ady;
+    double cdxady = cdx * ady, adxcdy = adx * cdy;
+    double bLift = bdx * bdx + bdy * bdy;
+    double adxbdy = adx * bdy, bdxady = bdx * ady;
+    double cLift = cdx * cdx + cdy * cdy;
+
+    double det = aLift * (bdxcdy - cdxbdy) + bLift * (cdxady - adxcdy) + cLift * (adxbdy - bdxady);
+    double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * aLift +
+                       (std::fabs(cdxady) + std::fabs(adxcdy)) * bLift +
+                       (std::fabs(adxbdy) + std::fabs(bdxady)) * cLift;
+    double bound = INCIRCLE_ERROR_BOUND * permanent;
+    if (det > bound || -det > bound) return det;
+    return incircleExact(ax, ay, bx, by, cx, cy, dx, dy);
+}
+
+// ---------------------------------------------------------------------------
+// Circumcircles
+
+// p * q - r * s and p * q + r * s. The compiler would fuse some of these
+// products on its own when FMA is available, and not the same ones in
+// scalar and vector code, so the fused form is written out (as in
+// Affine2D.h) and every path gives the same circles.
+inline double circumDiff(double p, double q, double r, double s) {
+#if defined(__FMA__)
+    return std::fma(p, q, -(r * s));
+#else
+    return p * q - r * s;
+#endif
+}
+
+inline double circumSum(double p, double q, double r, double s) {
+#if defined(__FMA__)
+    return std::fma(p, q, r * s);
+#else
+    return p * q + r * s;
+#endif
+}
+
+#if defined(__AVX2__)
+inline __m256d circumDiff4(__m256d p, __m256d q, __m256d r, __m256d s) {
+#if defined(__FMA__)
+    return _mm256_fmsub_pd(p, q, _mm256_mul_pd(r, s));
+#else
+    return _mm256_sub_pd(_mm256_mul_pd(p, q), _mm256_mul_pd(r, s));
+#endif
+}
+
+inline __m256d circumSum4(__m256d p, __m256d q, __m256d r, __m256d s) {
+#if defined(__FMA__)
+    return _mm256_fmadd_pd(p, q, _mm256_mul_pd(r, s));
+#else
+    return _mm256_add_pd(_mm256_mul_pd(p, q), _mm256_mul_pd(r, s));
+#endif
+}
+#elif defined(__SSE4_1__)
+inline __m128d circumDiff2(__m128d p, __m128d q, __m128d r, __m128d s) {
+#if defined(__FMA__)
+    return _mm_fmsub_pd(p, q, _mm_mul_pd(r, s));
+#else
+    return _mm_sub_pd(_mm_mul_pd(p, q), _mm_mul_pd(r, s));
+#endif
+}
+
+inline __m128d circumSum2(__m128d p, __m128d q, __m128d r, __m128d s) {
+#if defined(__FMA__)
+    return _mm_fmadd_pd(p, q, _mm_mul_pd(r, s));
+#else
+    return _mm_add_pd(_mm_mul_pd(p, q), _mm_mul_pd(r, s));
+#endif
+}
+#endif
+
+struct Circumcircle {
+    double x, y; // Centre
+    double r2;   // Squared radius
+};
+
+// Circle through a, b, c. Collinear points have none: the radius is
+// infinite and the centre NaN.
+inline Circumcircle circumcircle(double ax, double ay, double bx, double by, double cx, double cy) {
+    // Relative to a, so large coordinates cost no precision
+    double bax = bx - ax, bay = by - ay, cax = cx - ax, cay = cy - ay;
+    double det = circumDiff(bax, cay, bay, cax);
+    if (!(std::fabs(det) > ORIENT_ERROR_BOUND * (std::fabs(bax * cay) + std::fabs(bay * cax)))) {
+        det = orient2d(ax, ay, bx, by, cx, cy); // Nearly collinear: only 0 when exactly so
+        if (det == 0.0) {
+            double nan = std::numeric_limits<double>::quiet_NaN();
+            return {nan, nan, std::numeric_limits<double>::infinity()};
+        }
+    }
+    double d = 2.0 * det;
+    double b2 = circumSum(bax, bax, bay, bay), c2 = circumSum(cax, cax, cay, cay);
+    double ux = circumDiff(cay, b2, bay, c2) / d, uy = circumDiff(bax, c2, cax, b2) / d;
+    return {ax + ux, ay + uy, circumSum(ux, ux, uy, uy)};
+}
+
+// Triangles in structure-of-arrays layout
+struct TrianglesSoA {
+    std::vector<double> ax, ay, bx, by, cx, cy;
+
+    size_t size() const { return ax.size(); }
+
+    void reserve(size_t n) {
+        for (std::vector<double> *v : {&ax, &ay, &bx, &by, &cx, &cy}) v->reserve(n);
+    }
+
+    void push_back(double x0, double y0, double x1, double y1, double x2, double y2) {
+        ax.push_back(x0);
+        ay.push_back(y0);
+        bx.push_back(x1);
+        by.push_back(y1);
+        cx.push_back(x2);
+        cy.push_back(y2);
+    }
+};
+
+// sign[i] = sign of incircle(triangle i, (dx[i], dy[i])): +1 inside, -1 outside, 0 on the circle
+inline void incircleBatch(const TrianglesSoA &t, const double *dx, const double *dy, int8_t *sign) {
+    size_t count = t.size(), i = 0;
+    auto scalar = [&](size_t k) {
+        double det = incircle(t.ax[k], t.ay[k], t.bx[k], t.by[k], t.cx[k], t.cy[k], dx[k], dy[k]);
+        sign[k] = int8_t(det > 0.0 ? 1 : (det < 0.0 ? -1 : 0));
+    };
+#if defined(__AVX2__)
+    const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+    const __m256d errorBound = _mm256_set1_pd(INCIRCLE_ERROR_BOUND), zero = _mm256_setzero_pd();
+    for (; i + 4 <= count; i += 4) {
+        __m256d px = _mm256_loadu_pd(dx + i), py = _mm256_loadu_pd(dy + i);
+        __m256d adx = _mm256_sub_pd(_mm256_loadu_pd(&t.ax[i]), px), ady = _mm256_sub_pd(_mm256_loadu_pd(&t.ay[i]), py);
+        __m256d bdx = _mm256_sub_pd(_mm256_loadu_pd(&t.bx[i]), px), bdy = _mm256_sub_pd(_mm256_loadu_pd(&t.by[i]), py);
+        __m256d cdx = _mm256_sub_pd(_mm256_loadu_pd(&t.cx[i]), px), cdy = _mm256_sub_pd(_mm256_loadu_pd(&t.cy[i]), py);
+        __m256d bdxcdy = _mm256_mul_pd(bdx, cdy), cdxbdy = _mm256_mul_pd(cdx, bdy);
+        __m256d cdxady = _mm256_mul_pd(cdx, ady), adxcdy = _mm256_mul_pd(adx, cdy);
+        __m256d adxbdy = _mm256_mul_pd(adx, bdy), bdxady = _mm256_mul_pd(bdx, ady);
+        __m256d aLift = _mm256_add_pd(_mm256_mul_pd(adx, adx), _mm256_mul_pd(ady, ady));
+        __m256d bLift = _mm256_add_pd(_mm256_mul_pd(bdx, bdx), _mm256_mul_pd(bdy, bdy));
+        __m256d cLift = _mm256_add_pd(_mm256_mul_pd(cdx, cdx), _mm256_mul_pd(cdy, cdy));
+        __m256d det = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(aLift, _mm256_sub_pd(bdxcdy, cdxbdy)),
+                                                  _mm256_mul_pd(bLift, _mm256_sub_pd(cdxady, adxcdy))),
+                                    _mm256_mul_pd(cLift, _mm256_sub_pd(adxbdy, bdxady)));
+        __m256d permanent = _mm256_add_pd(
+            _mm256_add_pd(_mm256_mul_pd(_mm256_add_pd(_mm256_and_pd(bdxcdy, absMask), _mm256_and_pd(cdxbdy, absMask)), aLift),
+                          _mm256_mul_pd(_mm256_add_pd(_mm256_and_pd(cdxady, absMask), _mm256_and_pd(adxcdy, absMask)), bLift)),
+            _mm256_mul_pd(_mm256_add_pd(_mm256_and_pd(adxbdy, absMask), _mm256_and_pd(bdxady, absMask)), cLift));
+        __m256d bound = _mm256_mul_pd(errorBound, permanent);
+        int inside = _mm256_movemask_pd(_mm256_cmp_pd(det, bound, _CMP_GT_OQ));
+        int outside = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_sub_pd(zero, det), bound, _CMP_GT_OQ));
+        for (int lane = 0; lane < 4; lane++) {
+            if (inside & (1 << lane)) sign[i + lane] = 1;
+            else if (outside & (1 << lane)) sign[i + lane] = -1;
+            else scalar(i + lane); // Too close to call in double precision
+        }
+    }
+#elif defined(__SSE4_1__)
+    const __m128d absMask = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+    const __m128d errorBound = _mm_set1_pd(INCIRCLE_ERROR_BOUND), zero = _mm_setzero_pd();
+    for (; i + 2 <= count; i += 2) {
+        __m128d px = _mm_loadu_pd(dx + i), py = _mm_loadu_pd(dy + i);
+        __m128d adx = _mm_sub_pd(_mm_loadu_pd(&t.ax[i]), px), ady = _mm_sub_pd(_mm_loadu_pd(&t.ay[i]), py);
+        __m128d bdx = _mm_sub_pd(_mm_loadu_pd(&t.bx[i]), px), bdy = _mm_sub_pd(_mm_loadu_pd(&t.by[i]), py);
+        __m128d cdx = _mm_sub_pd(_mm_loadu_pd(&t.cx[i]), px), cdy = _mm_sub_pd(_mm_loadu_pd(&t.cy[i]), py);
+        __m128d bdxcdy = _mm_mul_pd(bdx, cdy), cdxbdy = _mm_mul_pd(cdx, bdy);
+        __m128d cdxady = _mm_mul_pd(cdx, ady), adxcdy = _mm_mul_pd(adx, cdy);
+        __m128d adxbdy = _mm_mul_pd(adx, bdy), bdxady = _mm_mul_pd(bdx, ady);
+        __m128d aLift = _mm_add_pd(_mm_mul_pd(adx, adx), _mm_mul_pd(ady, ady));
+        __m128d bLift = _mm_add_pd(_mm_mul_pd(bdx, bdx), _mm_mul_pd(bdy, bdy));
+        __m128d cLift = _mm_add_pd(_mm_mul_pd(cdx, cdx), _mm_mul_pd(cdy, cdy));
+        __m128d det = _mm_add_pd(_mm_add_pd(_mm_mul_pd(aLift, _mm_sub_pd(bdxcdy, cdxbdy)),
+                                            _mm_mul_pd(bLift, _mm_sub_pd(cdxady, adxcdy))),
+                                 _mm_mul_pd(cLift, _mm_sub_pd(adxbdy, bdxady)));
+        __m128d permanent = _mm_add_pd(
+            _mm_add_pd(_mm_mul_pd(_mm_add_pd(_mm_and_pd(bdxcdy, absMask), _mm_and_pd(cdxbdy, absMask)), aLift),
+                       _mm_mul_pd(_mm_add_pd(_mm_and_pd(cdxady, absMask), _mm_and_pd(adxcdy, absMask)), bLift)),
+            _mm_mul_pd(_mm_add_pd(_mm_and_pd(adxbdy, absMask), _mm_and_pd(bdxady, absMask)), cLift));
+        __m128d bound = _mm_mul_pd(errorBound, permanent);
+        int inside = _mm_movemask_pd(_mm_cmpgt_pd(det, bound));
+        int outside = _mm_movemask_pd(_mm_cmpgt_pd(_mm_sub_pd(zero, det), bound));
+        for (int lane = 0; lane < 2; lane++) {
+            if (inside & (1 << lane)) sign[i + lane] = 1;
+            else if (outside & (1 << lane)) sign[i + lane] = -1;
+            else scalar(i + lane);
+        }
+    }
+#endif
+    for (; i < count; i++) scalar(i);
+}
+
+// Circumcircles of every triangle, the same as circumcircle() gives one by
+// one; collinear triangles get an infinite radius and a NaN centre
+inline void circumcircleBatch(const TrianglesSoA &t, Circumcircle *out) {
+    size_t count = t.size(), i = 0;
+#if defined(__AVX2__)
+    const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+    const __m256d errorBound = _mm256_set1_pd(ORIENT_ERROR_BOUND), two = _mm256_set1_pd(2.0);
+    for (; i + 4 <= count; i += 4) {
+        __m256d ax = _mm256_loadu_pd(&t.ax[i]), ay = _mm256_loadu_pd(&t.ay[i]);
+        __m256d bax = _mm256_sub_pd(_mm256_loadu_pd(&t.bx[i]), ax), bay = _mm256_sub_pd(_mm256_loadu_pd(&t.by[i]), ay);
+        __m256d cax = _mm256_sub_pd(_mm256_loadu_pd(&t.cx[i]), ax), cay = _mm256_sub_pd(_mm256_loadu_pd(&t.cy[i]), ay);
+        __m256d left = _mm256_mul_pd(bax, cay), right = _mm256_mul_pd(bay, cax);
+        __m256d det = circumDiff4(bax, cay, bay, cax);
+        // Lanes the orientation bound cannot vouch for go through circumcircle()
+        __m256d bound = _mm256_mul_pd(errorBound, _mm256_add_pd(_mm256_and_pd(left, absMask), _mm256_and_pd(right, absMask)));
+        int sure = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_and_pd(det, absMask), bound, _CMP_GT_OQ));
+        __m256d d = _mm256_mul_pd(two, det);
+        __m256d b2 = circumSum4(bax, bax, bay, bay), c2 = circumSum4(cax, cax, cay, cay);
+        __m256d ux = _mm256_div_pd(circumDiff4(cay, b2, bay, c2), d);
+        __m256d uy = _mm256_div_pd(circumDiff4(bax, c2, cax, b2), d);
+        alignas(32) double x[4], y[4], r2[4];
+        _mm256_store_pd(x, _mm256_add_pd(ax, ux));
+        _mm256_store_pd(y, _mm256_add_pd(ay, uy));
+        _mm256_store_pd(r2, circumSum4(ux, ux, uy, uy));
+        for (int lane = 0; lane < 4; lane++) {
+            size_t k = i + lane;
+            out[k] = (sure & (1 << lane)) ? Circumcircle{x[lane], y[lane], r2[lane]}
+                                          : circumcircle(t.ax[k], t.ay[k], t.bx[k], t.by[k], t.cx[k], t.cy[k]);
+        }
+    }
+#elif defined(__SSE4_1__)
+    const __m128d absMask = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+    const __m128d errorBound = _mm_set1_pd(ORIENT_ERROR_BOUND), two = _mm_set1_pd(2.0);
+    for (; i + 2 <= count; i += 2) {
+        __m128d ax = _mm_loadu_pd(&t.ax[i]), ay = _mm_loadu_pd(&t.ay[i]);
+        __m128d bax = _mm_sub_pd(_mm_loadu_pd(&t.bx[i]), ax), bay = _mm_sub_pd(_mm_loadu_pd(&t.by[i]), ay);
+        __m128d cax = _mm_sub_pd(_mm_loadu_pd(&t.cx[i]), ax), cay = _mm_sub_pd(_mm_loadu_pd(&t.cy[i]), ay);
+        __m128d left = _mm_mul_pd(bax, cay), right = _mm_mul_pd(bay, cax);
+        __m128d det = circumDiff2(bax, cay, bay, cax);
+        __m128d bound = _mm_mul_pd(errorBound, _mm_add_pd(_mm_and_pd(left, absMask), _mm_and_pd(right, absMask)));
+        int sure = _mm_movemask_pd(_mm_cmpgt_pd(_mm_and_pd(det, absMask), bound));
+        __m128d d = _mm_mul_pd(two, det);
+        __m128d b2 = circumSum2(bax, bax, bay, bay), c2 = circumSum2(cax, cax, cay, cay);
+        __m128d ux = _mm_div_pd(circumDiff2(cay, b2, bay, c2), d);
+        __m128d uy = _mm_div_pd(circumDiff2(bax, c2, cax, b2), d);
+        alignas(16) double x[2], y[2], r2[2];
+        _mm_store_pd(x, _mm_add_pd(ax, ux));
+        _mm_store_pd(y, _mm_add_pd(ay, uy));
+        _mm_store_pd(r2, circumSum2(ux, ux, uy, uy));
+        for (int lane = 0; lane < 2; lane++) {
+            size_t k = i + lane;
+            out[k] = (sure & (1 << lane)) ? Circumcircle{x[lane], y[lane], r2[lane]}
+                                          : circumcircle(t.ax[k], t.ay[k], t.bx[k], t.by[k], t.cx[k], t.cy[k]);
+        }
+    }
+#endif
+    for (; i < count; i++) out[i] = circumcircle(t.ax[i], t.ay[i], t.bx[i], t.by[i], t.cx[i], t.cy[i]);
+}
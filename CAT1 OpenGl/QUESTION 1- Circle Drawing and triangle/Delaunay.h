@@ -0,0 +1,297 @@
+// Delaunay.h
+//
+// Incremental Delaunay triangulation (Bowyer-Watson): each new point
+// removes the triangles whose circumcircle contains it and fills the hole
+// with a fan of triangles to the point. All decisions go through the exact
+// predicates of Circumcircle.h, so collinear and cocircular points, and
+// points on the hull, come out as a valid triangulation rather than
+// crossing or missing triangles.
+//
+// The outside of the hull is covered by "ghost" triangles that share a
+// hull edge and have the point at infinity as their third vertex, so a
+// point beyond the hull needs no special case: it conflicts with the ghost
+// triangles of the hull edges it can see. The triangulation starts with the
+// first three points that are not collinear.
+//
+// A point is found by walking from the last triangle made toward it, so
+// build() inserts the points in Morton (Z-curve) order, keeping each walk
+// short: about O(n log n) overall.
+
+#pragma once
+
+#include "Circumcircle.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class DelaunayTriangulation {
+public:
+    static const int INFINITE_VERTEX = -1;
+
+    // Counter-clockwise vertices; n[i] is the neighbour across the edge
+    // opposite v[i]
+    struct Triangle {
+        int v[3];
+        int n[3];
+        bool dead;
+    };
+
+    void clear() {
+        xs.clear();
+        ys.clear();
+        tris.clear();
+        freeSlots.clear();
+        pending.clear();
+        last = -1;
+    }
+
+    // Triangulate count points (anything with members x and y). Repeated
+    // points are kept only once.
+    template <class Vertex>
+    void build(const Vertex *points, size_t count) {
+        clear();
+        xs.resize(count);
+        ys.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            xs[i] = double(points[i].x);
+            ys[i] = double(points[i].y);
+        }
+        for (int i : mortonOrder()) insertVertex(i);
+    }
+
+    // Add one point; returns its vertex index, or -1 when it repeats one
+    int insert(double x, double y) {
+        xs.push_back(x);
+        ys.push_back(y);
+        int i = int(xs.size()) - 1;
+        if (!insertVertex(i)) {
+            xs.pop_back();
+            ys.pop_back();
+            return -1;
+        }
+        return i;
+    }
+
+    double x(int vertex) const { return xs[vertex]; }
+    double y(int vertex) const { return ys[vertex]; }
+    size_t vertexCount() const { return xs.size(); }
+
+    // Every slot, including ghost and dead triangles
+    const std::vector<Triangle> &triangles() const { return tris; }
+
+    static bool isGhost(const Triangle &t) {
+        return t.v[0] == INFINITE_VERTEX || t.v[1] == INFINITE_VERTEX || t.v[2] == INFINITE_VERTEX;
+    }
+
+    // Vertex indices, three per finite triangle, counter-clockwise
+    void indices(std::vector<int> &out) const {
+        out.clear();
+        for (const Triangle &t : tris) {
+            if (t.dead || isGhost(t)) continue;
+            out.insert(out.end(), t.v, t.v + 3);
+        }
+    }
+
+    size_t triangleCount() const {
+        size_t n = 0;
+        for (const Triangle &t : tris) n += (!t.dead && !isGhost(t)) ? 1 : 0;
+        return n;
+    }
+
+private:
+    std::vector<double> xs, ys;
+    std::vector<Triangle> tris;
+    std::vector<int> freeSlots;
+    std::vector<int> pending; // Points seen before the first triangle (all collinear)
+    int last = -1;            // A live finite triangle to start walks from
+
+    // Scratch for one insertion
+    struct BoundaryEdge {
+        int a, b;    // Counter-clockwise as seen from the cavity
+        int outside; // Triangle beyond it, not in conflict
+        int slot;    // Index in outside's n[] that points back into the cavity
+    };
+    std::vector<int> cavity, stack;
+    std::vector<BoundaryEdge> boundary;
+    std::vector<uint32_t> visited; // Insertion stamp per triangle
+    std::vector<uint8_t> conflicting;
+    std::vector<int> fanFrom; // New triangle whose first vertex is the index (shifted by one for infinity)
+    uint32_t stamp = 0;
+
+    double orient(int a, int b, int c) const { return orient2d(xs[a], ys[a], xs[b], ys[b], xs[c], ys[c]); }
+
+    // p strictly inside segment ab, given the three are collinear
+    bool strictlyBetween(int a, int b, int p) const {
+        double ax = xs[a], bx = xs[b], px = xs[p];
+        double ay = ys[a], by = ys[b], py = ys[p];
+        return (ax < px && px < bx) || (bx < px && px < ax) || (ay < py && py < by) || (by < py && py < ay);
+    }
+
+    // Would p remove triangle t? For a ghost: p is beyond its hull edge, or on it
+    bool inConflict(const Triangle &t, int p) const {
+        for (int k = 0; k < 3; k++) {
+            if (t.v[k] != INFINITE_VERTEX) continue;
+            int a = t.v[(k + 1) % 3], b = t.v[(k + 2) % 3];
+            double o = orient(a, b, p);
+            return o > 0.0 || (o == 0.0 && strictlyBetween(a, b, p));
+        }
+        const int *v = t.v;
+        return incircle(xs[v[0]], ys[v[0]], xs[v[1]], ys[v[1]], xs[v[2]], ys[v[2]], xs[p], ys[p]) > 0.0;
+    }
+
+    int newTriangle(int a, int b, int c) {
+        Triangle t = {{a, b, c}, {-1, -1, -1}, false};
+        if (!freeSlots.empty()) {
+            int slot = freeSlots.back();
+            freeSlots.pop_back();
+            tris[slot] = t;
+            return slot;
+        }
+        tris.push_back(t);
+        return int(tris.size()) - 1;
+    }
+
+    std::vector<int> mortonOrder() const {
+        size_t count = xs.size();
+        std::vector<int> order(count);
+        if (count == 0) return order;
+        double xMin = *std::min_element(xs.begin(), xs.end()), xMax = *std::max_element(xs.begin(), xs.end());
+        double yMin = *std::min_element(ys.begin(), ys.end()), yMax = *std::max_element(ys.begin(), ys.end());
+        double sx = xMax > xMin ? 65535.0 / (xMax - xMin) : 0.0, sy = yMax > yMin ? 65535.0 / (yMax - yMin) : 0.0;
+        auto spread = [](uint32_t v) {
+            v = (v | (v << 8)) & 0x00ff00ffu;
+            v = (v | (v << 4)) & 0x0f0f0f0fu;
+            v = (v | (v << 2)) & 0x33333333u;
+            return (v | (v << 1)) & 0x55555555u;
+        };
+        std::vector<uint64_t> keys(count);
+        for (size_t i = 0; i < count; i++) {
+            uint32_t qx = uint32_t((xs[i] - xMin) * sx), qy = uint32_t((ys[i] - yMin) * sy);
+            keys[i] = (uint64_t(spread(qx) | (spread(qy) << 1)) << 32) | i;
+        }
+        std::sort(keys.begin(), keys.end());
+        for (size_t i = 0; i < count; i++) order[i] = int(keys[i] & 0xffffffffu);
+        return order;
+    }
+
+    // The first triangle and its three ghosts
+    void start(int a, int b, int c) {
+        if (orient(a, b, c) < 0.0) std::swap(a, b);
+        int t = newTriangle(a, b, c);
+        int ga = newTriangle(c, b, INFINITE_VERTEX); // Across the edge opposite a
+        int gb = newTriangle(a, c, INFINITE_VERTEX);
+        int gc = newTriangle(b, a, INFINITE_VERTEX);
+        tris[t].n[0] = ga;
+        tris[t].n[1] = gb;
+        tris[t].n[2] = gc;
+        // Ghost (u, w, inf): n[0] is the ghost starting at w, n[1] the one ending at u
+        tris[ga].n[0] = gc;
+        tris[ga].n[1] = gb;
+        tris[gb].n[0] = ga;
+        tris[gb].n[1] = gc;
+        tris[gc].n[0] = gb;
+        tris[gc].n[1] = ga;
+        tris[ga].n[2] = tris[gb].n[2] = tris[gc].n[2] = t;
+        last = t;
+    }
+
+    // Walk from last toward p: a finite triangle containing p (on its
+    // boundary counts), or a ghost whose hull edge p is beyond
+    int locate(int p) const {
+        int t = last;
+        for (size_t steps = 0; steps <= 4 * tris.size() + 4; steps++) {
+            const Triangle &tri = tris[t];
+            if (isGhost(tri)) return t;
+            int next = -1;
+            for (int k = 0; k < 3 && next < 0; k++) {
+                int e = (k + int(steps)) % 3; // Rotate the first edge tried
+                if (orient(tri.v[(e + 1) % 3], tri.v[(e + 2) % 3], p) < 0.0) next = tri.n[e];
+            }
+            if (next < 0) return t;
+            t = next;
+        }
+        // A walk in a Delaunay triangulation always ends; this is a safety net
+        for (size_t i = 0; i < tris.size(); i++) {
+            if (!tris[i].dead && inConflict(tris[i], p)) return int(i);
+        }
+        return last;
+    }
+
+    bool insertVertex(int p) {
+        if (tris.empty()) return startOrDefer(p);
+        int t = locate(p);
+        const Triangle &found = tris[t];
+        for (int k = 0; k < 3; k++) {
+            int v = found.v[k];
+            if (v != INFINITE_VERTEX && xs[v] == xs[p] && ys[v] == ys[p]) return false;
+        }
+
+        // Grow the cavity: triangles in conflict, reached through each other
+        if (++stamp == 0) {
+            std::fill(visited.begin(), visited.end(), 0u);
+            stamp = 1;
+        }
+        visited.resize(tris.size(), 0u);
+        conflicting.resize(tris.size(), 0);
+        cavity.clear();
+        boundary.clear();
+        stack.assign(1, t);
+        visited[t] = stamp;
+        conflicting[t] = 1;
+        while (!stack.empty()) {
+            int c = stack.back();
+            stack.pop_back();
+            cavity.push_back(c);
+            for (int k = 0; k < 3; k++) {
+                int nb = tris[c].n[k];
+                if (visited[nb] != stamp) {
+                    visited[nb] = stamp;
+                    conflicting[nb] = inConflict(tris[nb], p) ? 1 : 0;
+                    if (conflicting[nb]) stack.push_back(nb);
+                }
+                if (conflicting[nb]) continue;
+                int slot = 0;
+                while (tris[nb].n[slot] != c) slot++;
+                boundary.push_back({tris[c].v[(k + 1) % 3], tris[c].v[(k + 2) % 3], nb, slot});
+            }
+        }
+
+        // Replace it with a fan from p over its boundary
+        for (int c : cavity) {
+            tris[c].dead = true;
+            freeSlots.push_back(c);
+        }
+        fanFrom.resize(xs.size() + 1);
+        for (const BoundaryEdge &e : boundary) {
+            int f = newTriangle(e.a, e.b, p);
+            tris[f].n[2] = e.outside;
+            tris[e.outside].n[e.slot] = f;
+            fanFrom[e.a + 1] = f;
+        }
+        for (const BoundaryEdge &e : boundary) {
+            int f = fanFrom[e.a + 1], g = fanFrom[e.b + 1]; // g = (b, c, p) shares edge b-p
+            tris[f].n[0] = g;
+            tris[g].n[1] = f;
+            if (e.a != INFINITE_VERTEX && e.b != INFINITE_VERTEX) last = f;
+        }
+        return true;
+    }
+
+    // Before the first triangle: keep collinear points until one is not
+    bool startOrDefer(int p) {
+        for (int q : pending) {
+            if (xs[q] == xs[p] && ys[q] == ys[p]) return false;
+        }
+        if (pending.size() >= 2 && orient(pending[0], pending[1], p) != 0.0) {
+            start(pending[0], pending[1], p);
+            std::vector<int> rest(pending.begin() + 2, pending.end());
+            pending.clear();
+            for (int q : rest) insertVertex(q);
+            return true;
+        }
+        pending.push_back(p);
+        return true;
+    }
+};
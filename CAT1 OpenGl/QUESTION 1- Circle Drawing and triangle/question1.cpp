@@ -2,38 +2,19 @@
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <cmath>
-// Function to draw a circle using Bresenham's algorithm
-void drawCircle(int xc, int yc, int r)
+#include "BresenhamCircle.h"
+// Immediate-mode target: every circle pixel becomes one vertex
+struct GLPointTarget
 {
-    int x = 0, y = r;
-    int d = 3 - 2 * r;
+    void plot(int x, int y) { glVertex2i(x, y); }
+};
 
-    // Plot the initial points
+// Function to draw a circle using Bresenham's algorithm (kernel in BresenhamCircle.h)
+void drawCircle(int xc, int yc, int r)
+{
+    GLPointTarget points;
     glBegin(GL_POINTS);
-    while (y >= x)
-    {
-        // Plot points in all octants
-        glVertex2i(xc + x, yc + y);
-        glVertex2i(xc - x, yc + y);
-        glVertex2i(xc + x, yc - y);
-        glVertex2i(xc - x, yc - y);
-        glVertex2i(xc + y, yc + x);
-        glVertex2i(xc - y, yc + x);
-        glVertex2i(xc + y, yc - x);
-        glVertex2i(xc - y, yc - x);
-
-        // Update decision parameter
-        if (d > 0)
-        {
-            y--;
-            d = d + 4 * (x - y) + 10;
-        }
-        else
-        {
-            d = d + 4 * x + 6;
-        }
-        x++;
-    }
+    rasterCircleBresenham(xc, yc, r, points);
     glEnd();
 }
 
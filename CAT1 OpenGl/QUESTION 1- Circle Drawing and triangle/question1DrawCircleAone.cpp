@@ -14,75 +14,60 @@
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <vector>
+#include "BresenhamCircle.h"
+#include "../ShapeCache.h"
 
 // Window dimensions
 const int WINDOW_WIDTH = 800;
 const int WINDOW_HEIGHT = 800;
 
-// Draw tick marks along axes for clarity
-void drawAxes() {
+// Geometry kept in vertex buffers between frames (see ShapeCache.h)
+ShapeCache shapes;
+const size_t SLOT_AXES = 0;
+const size_t SLOT_CIRCLE = 1;
+
+// Build the axes with tick marks for clarity
+void buildAxes(ShapeGeometry &g) {
     // Set color for axes (white)
-    glColor3f(1.0f, 1.0f, 1.0f);
+    g.begin(GL_LINES, 1.0f, 1.0f, 1.0f);
     
     // Draw the main x-axis and y-axis lines
-    glBegin(GL_LINES);
-        // x-axis from -5 to 10
-        glVertex2f(-5.0f, 0.0f);
-        glVertex2f(10.0f, 0.0f);
-        // y-axis from -5 to 10
-        glVertex2f(0.0f, -5.0f);
-        glVertex2f(0.0f, 10.0f);
-    glEnd();
+    // x-axis from -5 to 10
+    g.vertex(-5.0f, 0.0f);
+    g.vertex(10.0f, 0.0f);
+    // y-axis from -5 to 10
+    g.vertex(0.0f, -5.0f);
+    g.vertex(0.0f, 10.0f);
     
     // Draw tick marks along the x-axis
-    glBegin(GL_LINES);
     for (int i = -5; i <= 10; i++) {
-        glVertex2f(i, -0.2f);
-        glVertex2f(i, 0.2f);
+        g.vertex(i, -0.2f);
+        g.vertex(i, 0.2f);
     }
-    glEnd();
     
     // Draw tick marks along the y-axis
-    glBegin(GL_LINES);
     for (int i = -5; i <= 10; i++) {
-        glVertex2f(-0.2f, i);
-        glVertex2f(0.2f, i);
+        g.vertex(-0.2f, i);
+        g.vertex(0.2f, i);
     }
-    glEnd();
+}
+
+// Draw tick marks along axes for clarity (built once, then drawn from the cache)
+void drawAxes() {
+    shapes.draw(SLOT_AXES, ShapeKey{-5.0f, 10.0f}, buildAxes);
     
     // Note: For actual numeric labels you would need to render text,
     // which requires additional libraries or routines.
 }
 
-// Plot the eight symmetric points of the circle
-void plotCirclePoints(int cx, int cy, int x, int y, std::vector<float> &vertices) {
-    // Each push_back adds one coordinate (we use units in cm)
-    vertices.push_back(cx + x); vertices.push_back(cy + y);
-    vertices.push_back(cx - x); vertices.push_back(cy + y);
-    vertices.push_back(cx + x); vertices.push_back(cy - y);
-    vertices.push_back(cx - x); vertices.push_back(cy - y);
-    vertices.push_back(cx + y); vertices.push_back(cy + x);
-    vertices.push_back(cx - y); vertices.push_back(cy + x);
-    vertices.push_back(cx + y); vertices.push_back(cy - x);
-    vertices.push_back(cx - y); vertices.push_back(cy - x);
-}
-
-// Bresenham Circle Drawing Algorithm (using integer arithmetic)
+// Bresenham Circle Drawing Algorithm (kernel in BresenhamCircle.h).
+// The octant is only stepped when the radius changes; each call copies the
+// outline offsets into vertices, sized once, with no push_back per point.
 void drawBresenhamCircle(int cx, int cy, int radius, std::vector<float> &vertices) {
-    int x = 0;
-    int y = radius;
-    int d = 3 - (2 * radius);
-    
-    while (x <= y) {
-        plotCirclePoints(cx, cy, x, y, vertices);
-        if (d < 0) {
-            d += (4 * x) + 6;
-        } else {
-            d += (4 * (x - y)) + 10;
-            y--;
-        }
-        x++;
-    }
+    static CircleStamp stamp(radius);
+    if (stamp.radius != radius) stamp = CircleStamp(radius);
+    vertices.resize(2 * stamp.outlinePixels());
+    writeCircleOutline(stamp, cx, cy, vertices.data());
 }
 
 // Render the scene: draw axes and the circle
@@ -92,21 +77,18 @@ void renderScene() {
     // Draw coordinate axes
     drawAxes();
     
-    // Prepare circle vertices using Bresenham's algorithm
-    std::vector<float> circleVertices;
     int cx = 1;      // Center x (in cm)
     int cy = 1;      // Center y (in cm)
     int radius = 4;  // Radius (in cm)
-    drawBresenhamCircle(cx, cy, radius, circleVertices);
-    
-    // Draw the circle points
-    glColor3f(0.0f, 1.0f, 0.0f); // Green color for the circle
-    glPointSize(5.0f);           // Increase point size for visibility
-    glBegin(GL_POINTS);
-    for (size_t i = 0; i < circleVertices.size(); i += 2) {
-        glVertex2f(circleVertices[i], circleVertices[i + 1]);
-    }
-    glEnd();
+
+    // Draw the circle points; Bresenham's algorithm only runs again if the
+    // centre or radius change
+    shapes.draw(SLOT_CIRCLE, ShapeKey{float(cx), float(cy), float(radius)}, [&](ShapeGeometry &g) {
+        std::vector<float> circleVertices;
+        drawBresenhamCircle(cx, cy, radius, circleVertices);
+        g.begin(GL_POINTS, 0.0f, 1.0f, 0.0f, 5.0f); // Green, enlarged points for visibility
+        g.vertices2(circleVertices.data(), circleVertices.size() / 2);
+    });
 }
 
 // Main function
@@ -152,6 +134,7 @@ int main() {
     }
     
     // Cleanup and exit
+    shapes.release();
     glfwTerminate();
     return 0;
 }
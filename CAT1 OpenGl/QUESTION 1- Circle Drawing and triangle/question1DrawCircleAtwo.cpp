@@ -10,93 +10,93 @@
 #include <iostream>
 #include <vector>
 #include <cmath>
-#include <algorithm>
+#include "BresenhamCircle.h"
+#include "../Affine2D.h"
+#include "../ShapeCache.h"
 
     // Window dimensions
     const int WINDOW_WIDTH = 800;
 const int WINDOW_HEIGHT = 800;
 
-// Simple 2D point structure
-struct Point
-{
-    float x;
-    float y;
-};
+// Geometry kept in vertex buffers between frames (see ShapeCache.h)
+ShapeCache shapes;
+const size_t SLOT_AXES = 0;
+const size_t SLOT_CIRCLE = 1;
 
-// Draw coordinate axes with tick marks (in cm)
-void drawAxes()
+// Build coordinate axes with tick marks (in cm)
+void buildAxes(ShapeGeometry &g)
 {
-    glColor3f(1.0f, 1.0f, 1.0f); // White color
-    glBegin(GL_LINES);
+    g.begin(GL_LINES, 1.0f, 1.0f, 1.0f); // White color
     // x-axis from -5 to 10
-    glVertex2f(-5.0f, 0.0f);
-    glVertex2f(10.0f, 0.0f);
+    g.vertex(-5.0f, 0.0f);
+    g.vertex(10.0f, 0.0f);
     // y-axis from -5 to 10
-    glVertex2f(0.0f, -5.0f);
-    glVertex2f(0.0f, 10.0f);
-    glEnd();
+    g.vertex(0.0f, -5.0f);
+    g.vertex(0.0f, 10.0f);
 
     // Tick marks for x-axis
-    glBegin(GL_LINES);
     for (int i = -5; i <= 10; i++)
     {
-        glVertex2f(i, -0.2f);
-        glVertex2f(i, 0.2f);
+        g.vertex(i, -0.2f);
+        g.vertex(i, 0.2f);
     }
-    glEnd();
 
     // Tick marks for y-axis
-    glBegin(GL_LINES);
     for (int i = -5; i <= 10; i++)
     {
-        glVertex2f(-0.2f, i);
-        glVertex2f(0.2f, i);
+        g.vertex(-0.2f, i);
+        g.vertex(0.2f, i);
     }
-    glEnd();
 }
 
-// Plot the eight symmetric points for the circle boundary
-void plotCirclePoints(int cx, int cy, int x, int y, std::vector<float> &vertices)
+// Draw coordinate axes with tick marks (built once, then drawn from the cache)
+void drawAxes()
 {
-    vertices.push_back(cx + x);
-    vertices.push_back(cy + y);
-    vertices.push_back(cx - x);
-    vertices.push_back(cy + y);
-    vertices.push_back(cx + x);
-    vertices.push_back(cy - y);
-    vertices.push_back(cx - x);
-    vertices.push_back(cy - y);
-    vertices.push_back(cx + y);
-    vertices.push_back(cy + x);
-    vertices.push_back(cx - y);
-    vertices.push_back(cy + x);
-    vertices.push_back(cx + y);
-    vertices.push_back(cy - x);
-    vertices.push_back(cx - y);
-    vertices.push_back(cy - x);
+    shapes.draw(SLOT_AXES, ShapeKey{-5.0f, 10.0f}, buildAxes);
 }
 
-// Bresenham Circle Drawing Algorithm (integer arithmetic)
-// This function fills the provided vector with the circle boundary points (in cm)
-void drawBresenhamCircle(int cx, int cy, int radius, std::vector<float> &vertices)
+// Target that rotates every boundary point and appends it to the fan
+struct RotatedFanTarget
 {
-    int x = 0;
-    int y = radius;
-    int d = 3 - (2 * radius);
-    while (x <= y)
+    ShapeGeometry &g;
+    Affine2D rotation;
+    float firstX, firstY;
+    bool empty;
+
+    void plot(int x, int y)
     {
-        plotCirclePoints(cx, cy, x, y, vertices);
-        if (d < 0)
-        {
-            d += (4 * x) + 6;
-        }
-        else
+        float px, py;
+        rotation.apply(float(x), float(y), px, py);
+        if (empty)
         {
-            d += (4 * (x - y)) + 10;
-            y--;
+            firstX = px;
+            firstY = py;
+            empty = false;
         }
-        x++;
+        g.vertex(px, py);
     }
+};
+
+// Build the filled circle, rotated by angle degrees (counterclockwise) about its centre.
+// The rotation is applied to the vertices here, so drawing needs no matrix changes.
+void buildRotatedCircle(int cx, int cy, int radius, float angle, ShapeGeometry &g)
+{
+    // Fill the circle using a triangle fan.
+    // Set the fill color to red (hex #ff0000)
+    g.begin(GL_TRIANGLE_FAN, 1.0f, 0.0f, 0.0f);
+    // Center of the fan
+    g.vertex(cx, cy);
+
+    // Boundary vertices from Bresenham's algorithm (kernel in BresenhamCircle.h),
+    // which come out already in counterclockwise order around the centre, so
+    // they go straight into the fan: no copy and no sort by angle.
+    // Rotation about the centre: translate it to the origin, rotate, translate back.
+    RotatedFanTarget fan = {g, Affine2D::rotationAbout(angle * 3.14159265f / 180.0f, cx, cy), 0.0f, 0.0f, true};
+    rasterCircleOrdered(cx, cy, radius, fan);
+
+    // Ensure closure by repeating the first vertex.
+    if (!fan.empty)
+        g.vertex(fan.firstX, fan.firstY);
 }
 
 // Render the scene: draw axes and a filled, rotated circle
@@ -107,52 +107,14 @@ void renderScene()
     // Draw coordinate axes
     drawAxes();
 
-    // Generate the circle boundary vertices using Bresenham's algorithm.
-    std::vector<float> circleVertices;
     int cx = 1;     // Center x in cm
     int cy = 1;     // Center y in cm
     int radius = 4; // Radius in cm
-    drawBresenhamCircle(cx, cy, radius, circleVertices);
-
-    // Convert the flat list into a vector of Point structures.
-    std::vector<Point> points;
-    for (size_t i = 0; i < circleVertices.size(); i += 2)
-    {
-        points.push_back({circleVertices[i], circleVertices[i + 1]});
-    }
-
-    // Sort the boundary points by angle relative to the circle’s center (1,1)
-    std::sort(points.begin(), points.end(), [cx, cy](const Point &a, const Point &b)
-              {
-        float angleA = std::atan2(a.y - cy, a.x - cx);
-        float angleB = std::atan2(b.y - cy, b.x - cx);
-        return angleA < angleB; });
-
-    // Apply rotation transformation:
-    // 1. Translate the coordinate system so that the circle's center is at the origin.
-    // 2. Rotate by -60° (clockwise).
-    // 3. Translate back.
-    glPushMatrix();
-    glTranslatef(cx, cy, 0.0f);
-    glRotatef(-60.0f, 0.0f, 0.0f, 1.0f); // Negative angle for clockwise rotation.
-    glTranslatef(-cx, -cy, 0.0f);
+    float angle = -60.0f; // Negative angle for clockwise rotation.
 
-    // Fill the circle using a triangle fan.
-    // Set the fill color to red (hex #ff0000)
-    glColor3f(1.0f, 0.0f, 0.0f);
-    glBegin(GL_TRIANGLE_FAN);
-    // Center of the fan
-    glVertex2f(cx, cy);
-    // Boundary vertices in order
-    for (const auto &p : points)
-    {
-        glVertex2f(p.x, p.y);
-    }
-    // Ensure closure by repeating the first vertex.
-    if (!points.empty())
-        glVertex2f(points[0].x, points[0].y);
-    glEnd();
-    glPopMatrix();
+    // The circle is only rasterized and rotated again if one of these changes
+    shapes.draw(SLOT_CIRCLE, ShapeKey{float(cx), float(cy), float(radius), angle}, [&](ShapeGeometry &g)
+                { buildRotatedCircle(cx, cy, radius, angle, g); });
 }
 
 // Main function
@@ -197,6 +159,7 @@ int main()
         glfwPollEvents();
     }
 
+    shapes.release();
     glfwTerminate();
     return 0;
 }
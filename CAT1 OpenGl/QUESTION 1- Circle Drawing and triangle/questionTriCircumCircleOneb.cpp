@@ -10,11 +10,19 @@
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <cmath>
+#include <vector>
+
+#include "../ArcTessellation.h"
+#include "Circumcircle.h"
 
 // Window dimensions
 const int WINDOW_WIDTH = 800;
 const int WINDOW_HEIGHT = 800;
 
+// Visible area: the circumscribed circle (centered at about (-14.5, -4.5)
+// with radius ~17.1) extends roughly from x = -32 to 3 and y = -22 to 13.
+const OrthoView VIEW = {-32.0, 3.0, -22.0, 13.0, WINDOW_WIDTH, WINDOW_HEIGHT};
+
 // Structure for 2D points
 struct Point2D
 {
@@ -22,26 +30,20 @@ struct Point2D
     float y;
 };
 
-// Compute circumcenter of triangle ABC
-Point2D computeCircumcenter(Point2D A, Point2D B, Point2D C)
-{
-    float d = 2 * (A.x * (B.y - C.y) + B.x * (C.y - A.y) + C.x * (A.y - B.y));
-    Point2D center;
-    center.x = ((A.x * A.x + A.y * A.y) * (B.y - C.y) +
-                (B.x * B.x + B.y * B.y) * (C.y - A.y) +
-                (C.x * C.x + C.y * C.y) * (A.y - B.y)) /
-               d;
-    center.y = ((A.x * A.x + A.y * A.y) * (C.x - B.x) +
-                (B.x * B.x + B.y * B.y) * (A.x - C.x) +
-                (C.x * C.x + C.y * C.y) * (B.x - A.x)) /
-               d;
-    return center;
-}
-
-// Compute Euclidean distance between two points
-float distance(Point2D p1, Point2D p2)
+// Circumscribed circle of triangle ABC, computed in double precision
+// relative to A (see Circumcircle.h). Returns false when the vertices are
+// collinear and there is no such circle.
+bool computeCircumcircle(Point2D A, Point2D B, Point2D C, Point2D &center, float &radius)
 {
-    return std::sqrt((p1.x - p2.x) * (p1.x - p2.x) + (p1.y - p2.y) * (p1.y - p2.y));
+    Circumcircle circle = circumcircle(A.x, A.y, B.x, B.y, C.x, C.y);
+    if (std::isinf(circle.r2))
+    {
+        return false;
+    }
+    center.x = float(circle.x);
+    center.y = float(circle.y);
+    radius = float(std::sqrt(circle.r2));
+    return true;
 }
 
 // Draw the triangle (white outline)
@@ -56,18 +58,17 @@ void drawTriangle(Point2D A, Point2D B, Point2D C)
 }
 
 // Draw a circle (using a line loop) centered at 'center' with the given radius.
-// The circle is drawn in red (RGB #ff0000).
+// The circle is drawn in red (RGB #ff0000), with as many segments as its
+// size on screen needs (see ArcTessellation.h).
 void drawCircle(Point2D center, float radius)
 {
+    std::vector<float> xy;
+    tessellateCircle(center.x, center.y, radius, arcLevel(radius, VIEW), xy);
     glColor3f(1.0f, 0.0f, 0.0f);
     glBegin(GL_LINE_LOOP);
-    const int segments = 100;
-    for (int i = 0; i < segments; i++)
+    for (size_t i = 0; i < xy.size(); i += 2)
     {
-        float theta = 2.0f * 3.1415926f * float(i) / float(segments);
-        float x = radius * std::cos(theta);
-        float y = radius * std::sin(theta);
-        glVertex2f(center.x + x, center.y + y);
+        glVertex2f(xy[i], xy[i + 1]);
     }
     glEnd();
 }
@@ -122,8 +123,7 @@ void renderScene(Point2D A, Point2D B, Point2D C, Point2D circumcenter, float ra
     glClear(GL_COLOR_BUFFER_BIT);
 
     // Draw the Cartesian plane covering the full view.
-    // Our orthographic projection is set from x = -32 to 3 and y = -22 to 13.
-    drawCartesianPlane(-32.0f, 3.0f, -22.0f, 13.0f);
+    drawCartesianPlane(float(VIEW.left), float(VIEW.right), float(VIEW.bottom), float(VIEW.top));
 
     // Draw the triangle (white)
     drawTriangle(A, B, C);
@@ -164,16 +164,20 @@ int main()
     Point2D C = {-4.0f, 9.0f};
 
     // Compute the circumcenter and radius for the triangle
-    Point2D circumcenter = computeCircumcenter(A, B, C);
-    float radius = distance(circumcenter, A); // (A, B, C lie on the circle)
+    Point2D circumcenter;
+    float radius;
+    if (!computeCircumcircle(A, B, C, circumcenter, radius))
+    {
+        std::cerr << "The vertices are collinear: no circumscribed circle" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
 
     // Set up viewport and orthographic projection.
-    // The circumscribed circle (centered at about (-14.5, -4.5) with radius ~17.1)
-    // extends roughly from x = -32 to 3 and y = -22 to 13.
     glViewport(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
-    glOrtho(-32.0, 3.0, -22.0, 13.0, -1.0, 1.0);
+    glOrtho(VIEW.left, VIEW.right, VIEW.bottom, VIEW.top, -1.0, 1.0);
     glMatrixMode(GL_MODELVIEW);
     glLoadIdentity();
 
@@ -11,112 +11,83 @@ above ellipse with orange color (#FFA500)*/
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <vector>
-#include <cmath> // For sqrtf
+#include "MidpointEllipse.h"
+#include "../FloodFill.h"
+#include "../ShapeCache.h"
 
 // Window dimensions
 const int WINDOW_WIDTH = 800;
 const int WINDOW_HEIGHT = 800;
 
-struct Point2D
-{
-    int x;
-    int y;
-};
-
-void plotEllipsePoints(int cx, int cy, int x, int y, std::vector<Point2D> &points)
+// Midpoint ellipse (kernel in MidpointEllipse.h)
+void midpointEllipse(int cx, int cy, int a, int b, std::vector<Point2D> &points)
 {
-    points.push_back({cx + x, cy + y});
-    points.push_back({cx - x, cy + y});
-    points.push_back({cx - x, cy - y});
-    points.push_back({cx + x, cy - y});
+    EllipsePointList list = {points};
+    rasterEllipseMidpoint(cx, cy, a, b, list);
 }
 
-void midpointEllipse(int cx, int cy, int a, int b, std::vector<Point2D> &points)
+// Geometry kept in vertex buffers between frames (see ShapeCache.h)
+ShapeCache shapes;
+const size_t SLOT_AXES = 0;
+const size_t SLOT_ELLIPSE = 1;
+
+void buildAxes(ShapeGeometry &g)
 {
-    float d1 = (b * b) - (a * a * b) + (0.25f * a * a);
-    int x = 0, y = b;
-    plotEllipsePoints(cx, cy, x, y, points);
-    while ((a * a) * (y - 0.5f) > (b * b) * (x + 1))
-    {
-        if (d1 < 0)
-            d1 += (b * b) * (2 * x + 3);
-        else
-        {
-            d1 += (b * b) * (2 * x + 3) + (a * a) * (-2 * y + 2);
-            y--;
-        }
-        x++;
-        plotEllipsePoints(cx, cy, x, y, points);
-    }
-    float d2 = (b * b) * (x + 0.5f) * (x + 0.5f) + (a * a) * (y - 1) * (y - 1) - (a * a * b * b);
-    while (y > 0)
+    g.begin(GL_LINES, 1.0f, 1.0f, 1.0f);
+    g.vertex(-20.0f, 0.0f);
+    g.vertex(20.0f, 0.0f);
+    g.vertex(0.0f, -20.0f);
+    g.vertex(0.0f, 20.0f);
+    for (int i = -20; i <= 20; i++)
     {
-        if (d2 < 0)
-        {
-            d2 += (b * b) * (2 * x + 2) + (a * a) * (-2 * y + 3);
-            x++;
-        }
-        else
-            d2 += (a * a) * (-2 * y + 3);
-        y--;
-        plotEllipsePoints(cx, cy, x, y, points);
+        g.vertex(i, -0.2f);
+        g.vertex(i, 0.2f);
+        g.vertex(-0.2f, i);
+        g.vertex(0.2f, i);
     }
 }
 
 void drawAxes()
 {
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glBegin(GL_LINES);
-    glVertex2f(-20.0f, 0.0f);
-    glVertex2f(20.0f, 0.0f);
-    glVertex2f(0.0f, -20.0f);
-    glVertex2f(0.0f, 20.0f);
-    glEnd();
-    glBegin(GL_LINES);
-    for (int i = -20; i <= 20; i++)
-    {
-        glVertex2f(i, -0.2f);
-        glVertex2f(i, 0.2f);
-        glVertex2f(-0.2f, i);
-        glVertex2f(0.2f, i);
-    }
-    glEnd();
+    shapes.draw(SLOT_AXES, ShapeKey{-20.0f, 20.0f}, buildAxes);
 }
 
-void renderScene()
+// Fill and boundary of the ellipse, built only when its parameters change
+void buildEllipse(int cx, int cy, int a, int b, ShapeGeometry &g)
 {
-    glClear(GL_COLOR_BUFFER_BIT);
-    drawAxes();
-
     std::vector<Point2D> ellipsePoints;
-    int cx = 2, cy = -1, a = 6, b = 5;
     midpointEllipse(cx, cy, a, b, ellipsePoints);
 
-    // Fill the ellipse with orange color
-    glColor3f(1.0f, 0.647f, 0.0f); // #FFA500
-    glBegin(GL_LINES);
-    for (float y = cy - b; y <= cy + b; y += 0.1f)
-    {
-        float y_rel = y - cy; // y + 1 since cy is -1
-        float term = 1.0f - (y_rel * y_rel) / (b * b);
-        if (term < 0.0f)
-            continue;
-        float sqrt_term = sqrtf(term);
-        float x_offset = a * sqrt_term;
-        float x_left = cx - x_offset;
-        float x_right = cx + x_offset;
-        glVertex2f(x_left, y);
-        glVertex2f(x_right, y);
-    }
-    glEnd();
+    // Flood fill: draw the boundary into a pixel mask covering the window and
+    // fill from the centre. The midpoint boundary is 8-connected, so the fill
+    // must be 4-connected to stay inside it. Every span the fill writes
+    // becomes one orange quad over its row of unit cells.
+    PixelMask mask(-20, 20, -20, 20);
+    for (auto &p : ellipsePoints)
+        mask.plot(p.x, p.y);
+    g.begin(GL_QUADS, 1.0f, 0.647f, 0.0f); // #FFA500
+    floodFill(mask, cx, cy, MASK_FILLED, 4, [&](int x0, int x1, int y)
+              {
+                  g.vertex(x0 - 0.5f, y - 0.5f);
+                  g.vertex(x1 + 0.5f, y - 0.5f);
+                  g.vertex(x1 + 0.5f, y + 0.5f);
+                  g.vertex(x0 - 0.5f, y + 0.5f);
+              });
 
     // Draw ellipse boundary
-    glColor3f(1.0f, 0.0f, 0.0f);
-    glPointSize(4.0f);
-    glBegin(GL_POINTS);
+    g.begin(GL_POINTS, 1.0f, 0.0f, 0.0f, 4.0f);
     for (auto &p : ellipsePoints)
-        glVertex2i(p.x, p.y);
-    glEnd();
+        g.vertex(p.x, p.y);
+}
+
+void renderScene()
+{
+    glClear(GL_COLOR_BUFFER_BIT);
+    drawAxes();
+
+    int cx = 2, cy = -1, a = 6, b = 5;
+    shapes.draw(SLOT_ELLIPSE, ShapeKey{float(cx), float(cy), float(a), float(b)}, [&](ShapeGeometry &g)
+                { buildEllipse(cx, cy, a, b, g); });
 }
 
 int main()
@@ -145,6 +116,7 @@ int main()
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
+    shapes.release();
     glfwTerminate();
     return 0;
 }
\ No newline at end of file
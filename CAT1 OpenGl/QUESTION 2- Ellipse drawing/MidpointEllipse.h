@@ -0,0 +1,242 @@
+// MidpointEllipse.h
+//
+// Midpoint ellipse algorithm used by DrawEllipseWithMEA.cpp.
+// Pixels go to a Target that provides
+//     void plot(int x, int y);
+// so the program can collect them for OpenGL and other tools can draw the
+// same ellipse headlessly.
+//
+// Everything is integer arithmetic. The interior comes out as one span per
+// row (EllipseSpan), taken from the same walk as the outline, and the batch
+// functions draw many ellipses per call, walking the quadrant only once for
+// consecutive ellipses with the same semi-axes.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+struct Point2D
+{
+    int x;
+    int y;
+};
+
+// Plot the four symmetric points of the ellipse
+template <class Target>
+void plotEllipsePoints(int cx, int cy, int x, int y, Target &target)
+{
+    target.plot(cx + x, cy + y);
+    target.plot(cx - x, cy + y);
+    target.plot(cx - x, cy - y);
+    target.plot(cx + x, cy - y);
+}
+
+// Largest semi-axis the walk handles. The decision variables reach about
+// 8 a^2 b^2, which must stay below 2^63: 16384 keeps them under 2^59.
+const int ELLIPSE_MAX_AXIS = 16384;
+
+// Semi-axes the walk can draw; ellipses with others are skipped
+inline bool ellipseAxesValid(int a, int b)
+{
+    return a >= 0 && b >= 0 && a <= ELLIPSE_MAX_AXIS && b <= ELLIPSE_MAX_AXIS;
+}
+
+// Walk the first quadrant of the midpoint ellipse with semi-axes a (along x)
+// and b (along y), calling step(x, y) for every pixel from (0, b) to (a, 0).
+// The decision variables are the textbook ones multiplied by 4, so the 0.5
+// and 0.25 terms become integers and every test is exact; they are 64-bit,
+// which bounds the axes at ELLIPSE_MAX_AXIS pixels. Nothing is walked for
+// larger or negative axes.
+template <class Step>
+void ellipseQuadrant(int a, int b, Step step)
+{
+    if (!ellipseAxesValid(a, b))
+        return;
+    if (b == 0) // Flat: every midpoint is on the curve, so the tests cannot decide
+    {
+        for (int x = 0; x <= a; x++)
+            step(x, 0);
+        return;
+    }
+    long long a2 = (long long)a * a, b2 = (long long)b * b;
+    long long x = 0, y = b;
+
+    // Region 1: slope above -1, x steps every time
+    long long d1 = 4 * b2 - 4 * a2 * b + a2;
+    step(0, b);
+    while (a2 * (2 * y - 1) > 2 * b2 * (x + 1))
+    {
+        if (d1 < 0)
+            d1 += 4 * b2 * (2 * x + 3);
+        else
+        {
+            d1 += 4 * b2 * (2 * x + 3) + 4 * a2 * (-2 * y + 2);
+            y--;
+        }
+        x++;
+        step(int(x), int(y));
+    }
+
+    // Region 2: slope below -1, y steps every time.
+    // d2 is 4 F(x + 1/2, y - 1) for F = b^2 x^2 + a^2 y^2 - a^2 b^2.
+    long long d2 = b2 * (2 * x + 1) * (2 * x + 1) + 4 * a2 * (y - 1) * (y - 1) - 4 * a2 * b2;
+
+    // Near the switch and at the tip of a flat ellipse one row can need more
+    // than one x step: keep going while the midpoint (x + 1/2, y) of the
+    // current row is inside the ellipse
+    auto finishRow = [&]()
+    {
+        while (x < a && d2 + 4 * a2 * (2 * y - 1) < 0)
+        {
+            d2 += 4 * b2 * (2 * x + 2);
+            x++;
+            step(int(x), int(y));
+        }
+    };
+
+    finishRow();
+    while (y > 0)
+    {
+        if (d2 < 0)
+        {
+            d2 += 4 * b2 * (2 * x + 2) + 4 * a2 * (-2 * y + 3);
+            x++;
+        }
+        else
+            d2 += 4 * a2 * (-2 * y + 3);
+        y--;
+        step(int(x), int(y));
+        finishRow();
+    }
+}
+
+// Midpoint ellipse with semi-axes a (along x) and b (along y)
+template <class Target>
+void rasterEllipseMidpoint(int cx, int cy, int a, int b, Target &target)
+{
+    ellipseQuadrant(a, b, [&](int x, int y)
+                    { plotEllipsePoints(cx, cy, x, y, target); });
+}
+
+// Horizontal run of pixels x0..x1 on row y
+struct EllipseSpan
+{
+    int x0, x1, y;
+};
+
+// Centre and semi-axes of one ellipse in a batch
+struct EllipseParams
+{
+    int cx, cy;
+    int a, b;
+};
+
+// halfWidth[y], y = 0..b: the outermost x of the outline on row y
+inline void ellipseHalfWidths(int a, int b, std::vector<int> &halfWidth)
+{
+    halfWidth.assign(ellipseAxesValid(a, b) ? b + 1 : 0, 0);
+    ellipseQuadrant(a, b, [&halfWidth](int x, int y)
+                    { halfWidth[y] = x; }); // x only grows as y falls
+}
+
+// Write the rows of the filled ellipse, bottom to top, from its half-widths.
+// spans must hold 2 * b + 1 entries; returns the number written.
+inline size_t writeEllipseSpans(int cx, int cy, const std::vector<int> &halfWidth, EllipseSpan *spans)
+{
+    int b = int(halfWidth.size()) - 1;
+    size_t n = 0;
+    for (int y = -b; y <= b; y++)
+    {
+        int w = halfWidth[y < 0 ? -y : y];
+        spans[n++] = {cx - w, cx + w, cy + y};
+    }
+    return n;
+}
+
+// Filled ellipse as scanline spans appended to spans. Returns the number added.
+inline size_t rasterEllipseSpans(int cx, int cy, int a, int b, std::vector<EllipseSpan> &spans)
+{
+    std::vector<int> halfWidth;
+    ellipseHalfWidths(a, b, halfWidth);
+    size_t before = spans.size();
+    spans.resize(before + (halfWidth.empty() ? 0 : 2 * halfWidth.size() - 1));
+    return writeEllipseSpans(cx, cy, halfWidth, spans.data() + before);
+}
+
+// Fill an ellipse in a target that provides fillRow(x0, x1, y)
+template <class Target>
+void fillEllipse(int cx, int cy, int a, int b, Target &target)
+{
+    std::vector<int> halfWidth;
+    ellipseHalfWidths(a, b, halfWidth);
+    int top = int(halfWidth.size()) - 1;
+    for (int y = -top; y <= top; y++)
+    {
+        int w = halfWidth[y < 0 ? -y : y];
+        target.fillRow(cx - w, cx + w, cy + y);
+    }
+}
+
+// Spans of count filled ellipses, appended to spans in order. The storage is
+// sized once for the whole batch. Returns the number of spans added.
+inline size_t rasterEllipsesSpans(const EllipseParams *ellipses, size_t count, std::vector<EllipseSpan> &spans)
+{
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (ellipseAxesValid(ellipses[i].a, ellipses[i].b))
+            total += 2 * size_t(ellipses[i].b) + 1;
+    }
+    size_t before = spans.size();
+    spans.resize(before + total);
+
+    std::vector<int> halfWidth;
+    int lastA = -1, lastB = -1;
+    size_t n = before;
+    for (size_t i = 0; i < count; i++)
+    {
+        const EllipseParams &e = ellipses[i];
+        if (!ellipseAxesValid(e.a, e.b))
+            continue;
+        if (e.a != lastA || e.b != lastB)
+        {
+            ellipseHalfWidths(e.a, e.b, halfWidth);
+            lastA = e.a;
+            lastB = e.b;
+        }
+        n += writeEllipseSpans(e.cx, e.cy, halfWidth, spans.data() + n);
+    }
+    return total;
+}
+
+// Outlines of count ellipses. The quadrant is walked again only when the
+// semi-axes differ from the previous ellipse's.
+template <class Target>
+void rasterEllipses(const EllipseParams *ellipses, size_t count, Target &target)
+{
+    std::vector<Point2D> quadrant;
+    int lastA = -1, lastB = -1;
+    for (size_t i = 0; i < count; i++)
+    {
+        const EllipseParams &e = ellipses[i];
+        if (e.a != lastA || e.b != lastB)
+        {
+            quadrant.clear();
+            ellipseQuadrant(e.a, e.b, [&quadrant](int x, int y)
+                            { quadrant.push_back({x, y}); });
+            lastA = e.a;
+            lastB = e.b;
+        }
+        for (const Point2D &p : quadrant)
+            plotEllipsePoints(e.cx, e.cy, p.x, p.y, target);
+    }
+}
+
+// Target that appends every plotted point to a list
+struct EllipsePointList
+{
+    std::vector<Point2D> &points;
+
+    void plot(int x, int y) { points.push_back({x, y}); }
+};
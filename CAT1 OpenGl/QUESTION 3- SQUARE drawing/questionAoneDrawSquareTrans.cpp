@@ -13,6 +13,7 @@ figure with rotation angle = θ = 55º*/
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <cmath>
+#include "../Affine2D.h"
 
 // Window dimensions
 const int WINDOW_WIDTH = 800;
@@ -45,36 +46,21 @@ Point rotatedSquare[4];
 // Function to compute the translated square vertices
 void computeTranslatedSquare()
 {
-    for (int i = 0; i < 4; i++)
-    {
-        translatedSquare[i].x = originalSquare[i].x + TRANSLATE_X;
-        translatedSquare[i].y = originalSquare[i].y + TRANSLATE_Y;
-    }
-}
-
-// Function to rotate a point 'p' about a given 'center' by angle (in degrees)
-Point rotatePoint(Point p, Point center, float angleDeg)
-{
-    float angleRad = angleDeg * PI / 180.0f;
-    float cosA = cos(angleRad);
-    float sinA = sin(angleRad);
-    Point result;
-    result.x = center.x + (p.x - center.x) * cosA - (p.y - center.y) * sinA;
-    result.y = center.y + (p.x - center.x) * sinA + (p.y - center.y) * cosA;
-    return result;
+    transformPoints(Affine2D::translation(TRANSLATE_X, TRANSLATE_Y), originalSquare, translatedSquare, 4);
 }
 
 // Function to compute the rotated square vertices from the translated square.
 // We rotate about the center of the translated square, which is (4,4).
+// The translation and the rotation are composed into one matrix and applied
+// to the original square, so cos/sin are evaluated once for all vertices.
 void computeRotatedSquare()
 {
     // Center of the translated square is the average of its vertices.
     // For our square A'(2,6), B'(6,6), C'(6,2), D'(2,2), the center is (4,4).
     Point center = {4.0f, 4.0f};
-    for (int i = 0; i < 4; i++)
-    {
-        rotatedSquare[i] = rotatePoint(translatedSquare[i], center, ROTATION_ANGLE_DEG);
-    }
+    Affine2D rotate = Affine2D::rotationAbout(ROTATION_ANGLE_DEG * PI / 180.0f, center.x, center.y);
+    Affine2D translateThenRotate = Affine2D::translation(TRANSLATE_X, TRANSLATE_Y).then(rotate);
+    transformPoints(translateThenRotate, originalSquare, rotatedSquare, 4);
 }
 
 // Function to draw Cartesian axes with tick marks
@@ -0,0 +1,268 @@
+// PointInPolygon.h
+//
+// Batched point-in-polygon tests (crossing number, even-odd rule) for
+// picking and pattern stamping.
+// The edges are kept in structure-of-arrays form, each stored as its lower
+// end, its y range and its inverse slope, and one point is tested against
+// 8 edges at a time with AVX2, 4 at a time with SSE4.1, or one at a time
+// otherwise, following the conventions of DDASimd.h. The crossing
+// abscissa is written out fused under FMA (edgeCross) because the
+// compiler would contract the scalar test but not the vector one, and a
+// point within an ulp of an edge could then be counted differently.
+//
+// For many queries against the same polygon, PolygonSlabs cuts its y range
+// into horizontal slabs and keeps a copy of the edges that reach each slab,
+// so a point is only tested against the edges of its own slab.
+
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+// Edges in structure-of-arrays layout; call pad() once all edges are added
+struct PolygonEdgesSoA
+{
+    std::vector<float> yLo, yHi; // The edge crosses rows yLo <= y < yHi
+    std::vector<float> xLo;      // x at yLo
+    std::vector<float> slope;    // dx / dy
+
+    size_t size() const { return yLo.size(); }
+
+    void push_back(float y0, float y1, float x0, float s)
+    {
+        yLo.push_back(y0);
+        yHi.push_back(y1);
+        xLo.push_back(x0);
+        slope.push_back(s);
+    }
+
+    // Edge (x1, y1) - (x2, y2); horizontal edges are never crossed and are left out
+    void addEdge(float x1, float y1, float x2, float y2)
+    {
+        if (y1 == y2)
+        {
+            return;
+        }
+        if (y1 > y2)
+        {
+            std::swap(x1, x2);
+            std::swap(y1, y2);
+        }
+        push_back(y1, y2, x1, (x2 - x1) / (y2 - y1));
+    }
+
+    // Add the closed contour through n vertices (anything with members x and y)
+    template <class Vertex>
+    void addContour(const Vertex *vertices, size_t n)
+    {
+        for (size_t i = 0, j = n - 1; i < n; j = i++)
+        {
+            addEdge(float(vertices[j].x), float(vertices[j].y), float(vertices[i].x), float(vertices[i].y));
+        }
+    }
+
+    // Dead edges (never active) up to the next multiple of 8, so the SIMD
+    // loops need no tail
+    void pad()
+    {
+        while (size() % 8 != 0)
+        {
+            push_back(FLT_MAX, -FLT_MAX, 0.0f, 0.0f);
+        }
+    }
+};
+
+// Number of set bits in a lane mask
+inline int laneCount(unsigned mask)
+{
+    int n = 0;
+    for (; mask; mask &= mask - 1)
+    {
+        n++;
+    }
+    return n;
+}
+
+// xLo + slope * dy, fused the same way on every path (see the header)
+inline float edgeCross(float xLo, float slope, float dy)
+{
+#if defined(__FMA__)
+    return std::fma(slope, dy, xLo);
+#else
+    return xLo + slope * dy;
+#endif
+}
+
+#if defined(__AVX2__)
+inline __m256 edgeCross8(__m256 xLo, __m256 slope, __m256 dy)
+{
+#if defined(__FMA__)
+    return _mm256_fmadd_ps(slope, dy, xLo);
+#else
+    return _mm256_add_ps(xLo, _mm256_mul_ps(slope, dy));
+#endif
+}
+#elif defined(__SSE4_1__)
+inline __m128 edgeCross4(__m128 xLo, __m128 slope, __m128 dy)
+{
+#if defined(__FMA__)
+    return _mm_fmadd_ps(slope, dy, xLo);
+#else
+    return _mm_add_ps(xLo, _mm_mul_ps(slope, dy));
+#endif
+}
+#endif
+
+// Does the ray from (x, y) to +x cross edge i?
+inline bool edgeCrossedRight(const PolygonEdgesSoA &edges, size_t i, float x, float y)
+{
+    if (!(edges.yLo[i] <= y && y < edges.yHi[i]))
+    {
+        return false;
+    }
+    return x < edgeCross(edges.xLo[i], edges.slope[i], y - edges.yLo[i]);
+}
+
+// Number of edges in [first, last) crossed by the ray from (x, y) to +x.
+// first and last must be multiples of 8 on the SIMD paths (see pad()).
+inline int countCrossings(const PolygonEdgesSoA &edges, size_t first, size_t last, float x, float y)
+{
+    int crossings = 0;
+    size_t i = first;
+#if defined(__AVX2__)
+    __m256 px = _mm256_set1_ps(x), py = _mm256_set1_ps(y);
+    for (; i + 8 <= last; i += 8)
+    {
+        __m256 yLo = _mm256_loadu_ps(&edges.yLo[i]);
+        __m256 active = _mm256_and_ps(_mm256_cmp_ps(yLo, py, _CMP_LE_OQ),
+                                      _mm256_cmp_ps(py, _mm256_loadu_ps(&edges.yHi[i]), _CMP_LT_OQ));
+        __m256 xCross = edgeCross8(_mm256_loadu_ps(&edges.xLo[i]), _mm256_loadu_ps(&edges.slope[i]), _mm256_sub_ps(py, yLo));
+        __m256 crossed = _mm256_and_ps(active, _mm256_cmp_ps(px, xCross, _CMP_LT_OQ));
+        crossings += laneCount(unsigned(_mm256_movemask_ps(crossed)));
+    }
+#elif defined(__SSE4_1__)
+    __m128 px = _mm_set1_ps(x), py = _mm_set1_ps(y);
+    for (; i + 4 <= last; i += 4)
+    {
+        __m128 yLo = _mm_loadu_ps(&edges.yLo[i]);
+        __m128 active = _mm_and_ps(_mm_cmple_ps(yLo, py), _mm_cmplt_ps(py, _mm_loadu_ps(&edges.yHi[i])));
+        __m128 xCross = edgeCross4(_mm_loadu_ps(&edges.xLo[i]), _mm_loadu_ps(&edges.slope[i]), _mm_sub_ps(py, yLo));
+        __m128 crossed = _mm_and_ps(active, _mm_cmplt_ps(px, xCross));
+        crossings += laneCount(unsigned(_mm_movemask_ps(crossed)));
+    }
+#endif
+    for (; i < last; i++)
+    {
+        crossings += edgeCrossedRight(edges, i, x, y) ? 1 : 0;
+    }
+    return crossings;
+}
+
+// Edges of a polygon split into horizontal slabs for repeated queries
+struct PolygonSlabs
+{
+    float yMin = 0.0f, yMax = 0.0f;
+    float slabsPerUnit = 0.0f;
+    int count = 0;
+    std::vector<size_t> start; // Slab s owns edges [start[s], start[s + 1])
+    PolygonEdgesSoA edges;     // Each slab padded to a multiple of 8
+
+    // Slab of row y; y must be in yMin..yMax. Monotone in y, so an edge
+    // spanning yLo..yHi is found in every slab from slabOf(yLo) to slabOf(yHi).
+    int slabOf(float y) const
+    {
+        int s = int((y - yMin) * slabsPerUnit);
+        return std::min(std::max(s, 0), count - 1);
+    }
+
+    // Build from edges (padding is ignored). slabs = 0 picks about one slab
+    // per 8 edges.
+    void build(const PolygonEdgesSoA &from, int slabs = 0)
+    {
+        *this = PolygonSlabs();
+        size_t n = 0;
+        yMin = FLT_MAX;
+        yMax = -FLT_MAX;
+        for (size_t i = 0; i < from.size(); i++)
+        {
+            if (from.yLo[i] > from.yHi[i])
+            {
+                continue; // Padding
+            }
+            n++;
+            yMin = std::min(yMin, from.yLo[i]);
+            yMax = std::max(yMax, from.yHi[i]);
+        }
+        if (n == 0)
+        {
+            return;
+        }
+        count = std::max(1, slabs > 0 ? slabs : int(n / 8));
+        slabsPerUnit = float(count) / (yMax - yMin);
+
+        // Edges per slab, then copies of them slab by slab
+        std::vector<std::vector<size_t>> lists(count);
+        for (size_t i = 0; i < from.size(); i++)
+        {
+            if (from.yLo[i] > from.yHi[i])
+            {
+                continue;
+            }
+            for (int s = slabOf(from.yLo[i]), last = slabOf(from.yHi[i]); s <= last; s++)
+            {
+                lists[s].push_back(i);
+            }
+        }
+        start.push_back(0);
+        for (const std::vector<size_t> &list : lists)
+        {
+            for (size_t i : list)
+            {
+                edges.push_back(from.yLo[i], from.yHi[i], from.xLo[i], from.slope[i]);
+            }
+            edges.pad();
+            start.push_back(edges.size());
+        }
+    }
+
+    bool contains(float x, float y) const
+    {
+        if (count == 0 || !(y >= yMin && y < yMax))
+        {
+            return false; // No edge crosses this row (or y is NaN)
+        }
+        int s = slabOf(y);
+        return (countCrossings(edges, start[s], start[s + 1], x, y) & 1) != 0;
+    }
+};
+
+// Single query against all edges (edges must be padded)
+inline bool pointInPolygon(const PolygonEdgesSoA &edges, float x, float y)
+{
+    return (countCrossings(edges, 0, edges.size(), x, y) & 1) != 0;
+}
+
+// inside[i] = 1 when point (x[i], y[i]) is inside, for count points
+inline void pointsInPolygon(const PolygonEdgesSoA &edges, const float *x, const float *y, size_t count, uint8_t *inside)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        inside[i] = pointInPolygon(edges, x[i], y[i]) ? 1 : 0;
+    }
+}
+
+inline void pointsInPolygon(const PolygonSlabs &slabs, const float *x, const float *y, size_t count, uint8_t *inside)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        inside[i] = slabs.contains(x[i], y[i]) ? 1 : 0;
+    }
+}
@@ -0,0 +1,239 @@
+// ScanlinePolygon.h
+//
+// Scanline polygon fill used by question4Polygon.cpp.
+// A pixel (x, y) is inside when the point at its integer coordinates is,
+// under the even-odd or the non-zero winding rule; this is the same test
+// as casting a ray to +x from every grid point, but each row is handled at
+// once:
+//   - the edge table holds the non-horizontal edges sorted by the first
+//     row they cross;
+//   - the active edge list holds the edges crossing the current row, kept
+//     sorted by where they cross it;
+//   - the crossings of a row bound its inside spans.
+// The cost is O(edges log edges) to build the table plus the crossings and
+// spans of every row, instead of a test against every edge for every point
+// of the bounding box. Polygons may have any number of contours (holes,
+// self-intersections); they go to a Target through fillRow(x0, x1, y) or,
+// as pattern stamps, through plot(x, y).
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+enum class FillRule
+{
+    EvenOdd,
+    NonZero
+};
+
+// Horizontal run of pixels x0..x1 on row y
+struct PolygonSpan
+{
+    int x0, x1;
+    int y;
+};
+
+class PolygonEdgeTable
+{
+public:
+    // Add the closed contour through n vertices (anything with members x and y)
+    template <class Vertex>
+    void addContour(const Vertex *vertices, size_t n)
+    {
+        for (size_t i = 0, j = n - 1; i < n; j = i++)
+        {
+            addEdge(vertices[j].x, vertices[j].y, vertices[i].x, vertices[i].y);
+        }
+    }
+
+    // Edge from (x1, y1) to (x2, y2); direction matters for FillRule::NonZero
+    void addEdge(double x1, double y1, double x2, double y2)
+    {
+        if (y1 == y2)
+        {
+            return; // Never crosses a row
+        }
+        Edge e;
+        e.winding = (y2 > y1) ? 1 : -1;
+        if (y1 > y2)
+        {
+            std::swap(x1, x2);
+            std::swap(y1, y2);
+        }
+        // Rows y with y1 <= y < y2, as in the ray-casting test
+        e.yFirst = int(std::ceil(y1));
+        e.yLast = int(std::ceil(y2)) - 1;
+        if (e.yFirst > e.yLast)
+        {
+            return;
+        }
+        e.x1 = x1;
+        e.y1 = y1;
+        e.dx = x2 - x1;
+        e.dy = y2 - y1;
+        edges.push_back(e);
+        sorted = false;
+    }
+
+    void clear()
+    {
+        edges.clear();
+    }
+
+    // Call onSpan(x0, x1, y) for the inside runs of every row, bottom to top
+    // and left to right within a row. Runs on a row never touch each other.
+    template <class OnSpan>
+    void scan(FillRule rule, OnSpan onSpan)
+    {
+        if (!sorted)
+        {
+            std::sort(edges.begin(), edges.end(), [](const Edge &a, const Edge &b) { return a.yFirst < b.yFirst; });
+            sorted = true;
+        }
+
+        std::vector<Active> active;
+        size_t next = 0;
+        int y = edges.empty() ? 0 : edges[0].yFirst;
+        while (next < edges.size() || !active.empty())
+        {
+            if (active.empty() && edges[next].yFirst > y)
+            {
+                y = edges[next].yFirst; // Skip rows no edge crosses
+            }
+
+            // Drop finished edges, move in the edges that start on this row
+            size_t kept = 0;
+            for (size_t i = 0; i < active.size(); i++)
+            {
+                if (edges[active[i].edge].yLast >= y)
+                {
+                    active[kept++] = active[i];
+                }
+            }
+            active.resize(kept);
+            for (; next < edges.size() && edges[next].yFirst == y; next++)
+            {
+                active.push_back({0.0, next});
+            }
+
+            // Crossings of this row. The x of each edge is computed from its
+            // lower end rather than accumulated, so no error builds up along
+            // the edge and integer vertices give exact crossings.
+            for (Active &a : active)
+            {
+                const Edge &e = edges[a.edge];
+                a.x = e.x1 + e.dx * (y - e.y1) / e.dy;
+            }
+            // The order changes little from row to row: insertion sort
+            for (size_t i = 1; i < active.size(); i++)
+            {
+                Active a = active[i];
+                size_t j = i;
+                for (; j > 0 && active[j - 1].x > a.x; j--)
+                {
+                    active[j] = active[j - 1];
+                }
+                active[j] = a;
+            }
+
+            // A pixel x is inside from crossing k to crossing k + 1 when
+            // ceil(x_k) <= x < ceil(x_k+1) and the rule holds in between
+            int winding = 0;
+            bool open = false;
+            int spanStart = 0, spanEnd = 0;
+            for (size_t k = 0; k + 1 < active.size(); k++)
+            {
+                winding += (rule == FillRule::NonZero) ? edges[active[k].edge].winding : 1;
+                bool inside = (rule == FillRule::NonZero) ? winding != 0 : (winding & 1) != 0;
+                if (!inside)
+                {
+                    continue;
+                }
+                int x0 = int(std::ceil(active[k].x)), x1 = int(std::ceil(active[k + 1].x)) - 1;
+                if (x0 > x1)
+                {
+                    continue;
+                }
+                if (open && x0 <= spanEnd + 1)
+                {
+                    spanEnd = std::max(spanEnd, x1);
+                    continue;
+                }
+                if (open)
+                {
+                    onSpan(spanStart, spanEnd, y);
+                }
+                open = true;
+                spanStart = x0;
+                spanEnd = x1;
+            }
+            if (open)
+            {
+                onSpan(spanStart, spanEnd, y);
+            }
+            y++;
+        }
+    }
+
+private:
+    struct Edge
+    {
+        int yFirst, yLast; // Rows the edge crosses
+        double x1, y1;     // Lower end
+        double dx, dy;     // dy > 0
+        int winding;       // +1 upward, -1 downward
+    };
+    struct Active
+    {
+        double x; // Crossing on the current row
+        size_t edge;
+    };
+
+    std::vector<Edge> edges;
+    bool sorted = true;
+};
+
+// Filled polygon as scanline spans appended to spans. Returns the number added.
+template <class Vertex>
+size_t rasterPolygonSpans(const Vertex *vertices, size_t n, FillRule rule, std::vector<PolygonSpan> &spans)
+{
+    PolygonEdgeTable table;
+    table.addContour(vertices, n);
+    size_t before = spans.size();
+    table.scan(rule, [&spans](int x0, int x1, int y) { spans.push_back({x0, x1, y}); });
+    return spans.size() - before;
+}
+
+// Fill a polygon in a target that provides fillRow(x0, x1, y)
+template <class Vertex, class Target>
+void fillPolygon(const Vertex *vertices, size_t n, FillRule rule, Target &target)
+{
+    PolygonEdgeTable table;
+    table.addContour(vertices, n);
+    table.scan(rule, [&target](int x0, int x1, int y) { target.fillRow(x0, x1, y); });
+}
+
+// Pattern fill: plot(x, y) at the inside grid points whose x and y are
+// multiples of step, so the target can draw a stamp (an asterisk, ...) there
+template <class Vertex, class Target>
+void stampPolygon(const Vertex *vertices, size_t n, FillRule rule, int step, Target &target)
+{
+    PolygonEdgeTable table;
+    table.addContour(vertices, n);
+    step = std::max(step, 1);
+    table.scan(rule, [&target, step](int x0, int x1, int y) {
+        if (y % step != 0)
+        {
+            return;
+        }
+        int r = x0 % step;
+        int x = (r == 0) ? x0 : (x0 >= 0 ? x0 - r + step : x0 - r); // First multiple of step >= x0
+        for (; x <= x1; x += step)
+        {
+            target.plot(x, y);
+        }
+    });
+}
@@ -0,0 +1,510 @@
+// Triangulate.h
+//
+// Triangulation of simple polygons (convex or not) into indexed triangle
+// lists for glDrawElements(GL_TRIANGLES, ...). Vertices are anything with
+// members x and y, such as the Point arrays of question4Polygon.cpp, given
+// in either winding order; the output indices refer to them and every
+// triangle is counter-clockwise.
+//
+//   - triangulateEarClipping: cuts off one convex corner ("ear") with no
+//     other vertex inside at a time. O(n^2), little setup; for small
+//     polygons.
+//   - triangulateMonotone: one top-to-bottom sweep adds diagonals that split
+//     the polygon into y-monotone pieces (de Berg et al., Computational
+//     Geometry, ch. 3), and each piece is triangulated in linear time with a
+//     stack. O(n log n) for large polygons.
+//   - triangulatePolygon picks between the two by size.
+// Each returns false when the input is not a simple polygon it can handle
+// (fewer than 3 vertices, zero area, crossing edges), leaving indices as
+// they were.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+// Twice the signed area of triangle a, b, c: > 0 when counter-clockwise
+template <class Vertex>
+double triangleOrientation(const Vertex &a, const Vertex &b, const Vertex &c)
+{
+    return (double(b.x) - a.x) * (double(c.y) - a.y) - (double(b.y) - a.y) * (double(c.x) - a.x);
+}
+
+// Twice the signed area of the polygon: > 0 when counter-clockwise
+template <class Vertex>
+double polygonOrientation(const Vertex *vertices, size_t n)
+{
+    double area = 0.0;
+    for (size_t i = 0, j = n - 1; i < n; j = i++)
+    {
+        area += (double(vertices[j].x) - vertices[i].x) * (double(vertices[j].y) + vertices[i].y);
+    }
+    return area;
+}
+
+// Vertex order of the polygon, counter-clockwise, without the corners that
+// enclose no area (repeated vertices, vertices in the middle of a straight
+// run, zero-width spikes). Their triangles would be empty; leaving them out
+// lets both triangulators assume every corner turns.
+template <class Vertex>
+std::vector<uint32_t> counterClockwiseRing(const Vertex *vertices, size_t n)
+{
+    std::vector<uint32_t> ring;
+    ring.reserve(n);
+    bool reversed = polygonOrientation(vertices, n) < 0.0;
+    auto flat = [&](uint32_t a, uint32_t b, uint32_t c) {
+        return triangleOrientation(vertices[a], vertices[b], vertices[c]) == 0.0;
+    };
+    for (size_t k = 0; k < n; k++)
+    {
+        ring.push_back(uint32_t(reversed ? n - 1 - k : k));
+        while (ring.size() >= 3 && flat(ring[ring.size() - 3], ring[ring.size() - 2], ring.back()))
+        {
+            ring.erase(ring.end() - 2);
+        }
+    }
+    // The corners where the ring closes
+    bool changed = true;
+    while (changed && ring.size() >= 3)
+    {
+        changed = false;
+        if (flat(ring[ring.size() - 2], ring.back(), ring[0]))
+        {
+            ring.pop_back();
+            changed = true;
+        }
+        else if (flat(ring.back(), ring[0], ring[1]))
+        {
+            ring.erase(ring.begin());
+            changed = true;
+        }
+    }
+    if (ring.size() < 3)
+    {
+        ring.clear();
+    }
+    return ring;
+}
+
+template <class Vertex>
+bool triangulateEarClipping(const Vertex *vertices, size_t n, std::vector<uint32_t> &indices)
+{
+    if (n < 3 || polygonOrientation(vertices, n) == 0.0)
+    {
+        return false;
+    }
+    std::vector<uint32_t> ring = counterClockwiseRing(vertices, n);
+    if (ring.empty())
+    {
+        return false;
+    }
+    std::vector<uint32_t> out;
+    out.reserve(3 * (n - 2));
+
+    // p is an ear when its corner is convex and no other corner of the ring
+    // lies inside or on the triangle (only reflex corners can)
+    auto isEar = [&](size_t p) {
+        size_t m = ring.size();
+        const Vertex &a = vertices[ring[(p + m - 1) % m]];
+        const Vertex &b = vertices[ring[p]];
+        const Vertex &c = vertices[ring[(p + 1) % m]];
+        if (triangleOrientation(a, b, c) <= 0.0)
+        {
+            return false;
+        }
+        for (size_t k = 0; k < m; k++)
+        {
+            if (k == p || k == (p + m - 1) % m || k == (p + 1) % m)
+            {
+                continue;
+            }
+            const Vertex &v = vertices[ring[k]];
+            if ((v.x == a.x && v.y == a.y) || (v.x == b.x && v.y == b.y) || (v.x == c.x && v.y == c.y))
+            {
+                continue; // Touching copy of a corner (polygon pinched at that vertex)
+            }
+            if (triangleOrientation(a, b, v) >= 0.0 && triangleOrientation(b, c, v) >= 0.0 &&
+                triangleOrientation(c, a, v) >= 0.0)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    size_t p = 0, misses = 0;
+    while (ring.size() > 3)
+    {
+        size_t m = ring.size();
+        const Vertex &a = vertices[ring[(p + m - 1) % m]], &b = vertices[ring[p]], &c = vertices[ring[(p + 1) % m]];
+        if (triangleOrientation(a, b, c) == 0.0)
+        {
+            // Cutting an ear can leave a straight corner behind: drop it too
+            ring.erase(ring.begin() + p);
+            p = (p + ring.size() - 1) % ring.size();
+            misses = 0;
+        }
+        else if (isEar(p))
+        {
+            out.push_back(ring[(p + m - 1) % m]);
+            out.push_back(ring[p]);
+            out.push_back(ring[(p + 1) % m]);
+            ring.erase(ring.begin() + p);
+            p = (p + ring.size() - 1) % ring.size(); // The previous corner may have become an ear
+            misses = 0;
+        }
+        else
+        {
+            p = (p + 1) % m;
+            if (++misses > m)
+            {
+                return false; // A full turn without an ear: not a simple polygon
+            }
+        }
+    }
+    if (triangleOrientation(vertices[ring[0]], vertices[ring[1]], vertices[ring[2]]) > 0.0)
+    {
+        out.insert(out.end(), ring.begin(), ring.end());
+    }
+    indices.insert(indices.end(), out.begin(), out.end());
+    return true;
+}
+
+// Triangulate one y-monotone polygon, given as vertex indices in
+// counter-clockwise order, with the usual stack walk down its two chains.
+// Appends counter-clockwise triangles to indices.
+template <class Vertex>
+void triangulateMonotonePiece(const Vertex *vertices, const std::vector<uint32_t> &piece, std::vector<uint32_t> &indices)
+{
+    size_t m = piece.size();
+    if (m < 3)
+    {
+        return;
+    }
+    auto above = [&](uint32_t a, uint32_t b) {
+        const Vertex &p = vertices[a], &q = vertices[b];
+        return p.y > q.y || (p.y == q.y && (p.x < q.x || (p.x == q.x && a < b)));
+    };
+    auto emit = [&](uint32_t a, uint32_t b, uint32_t c) {
+        double o = triangleOrientation(vertices[a], vertices[b], vertices[c]);
+        if (o == 0.0)
+        {
+            return; // Collinear: covers no area
+        }
+        if (o < 0.0)
+        {
+            std::swap(b, c);
+        }
+        indices.push_back(a);
+        indices.push_back(b);
+        indices.push_back(c);
+    };
+
+    // Counter-clockwise from the top vertex runs down the left chain to the
+    // bottom; merge the two chains into top-to-bottom order
+    size_t top = 0, bottom = 0;
+    for (size_t i = 1; i < m; i++)
+    {
+        if (above(piece[i], piece[top])) top = i;
+        if (above(piece[bottom], piece[i])) bottom = i;
+    }
+    std::vector<std::pair<uint32_t, bool>> sorted; // Vertex, on the left chain
+    sorted.reserve(m);
+    size_t l = top, r = top;
+    sorted.push_back({piece[top], true});
+    while (sorted.size() < m)
+    {
+        size_t nl = (l + 1) % m, nr = (r + m - 1) % m;
+        bool takeLeft = (l != bottom) && (r == bottom || nr == nl || above(piece[nl], piece[nr]));
+        if (takeLeft)
+        {
+            sorted.push_back({piece[nl], true});
+            l = nl;
+        }
+        else
+        {
+            sorted.push_back({piece[nr], false});
+            r = nr;
+        }
+    }
+
+    std::vector<std::pair<uint32_t, bool>> stack = {sorted[0], sorted[1]};
+    for (size_t j = 2; j + 1 < m; j++)
+    {
+        std::pair<uint32_t, bool> u = sorted[j];
+        if (u.second != stack.back().second)
+        {
+            // Opposite chain: fan to every stacked vertex
+            for (size_t k = 0; k + 1 < stack.size(); k++)
+            {
+                emit(u.first, stack[k].first, stack[k + 1].first);
+            }
+            std::pair<uint32_t, bool> last = stack.back();
+            stack = {last, u};
+        }
+        else
+        {
+            // Same chain: cut off triangles while the turn is convex
+            std::pair<uint32_t, bool> last = stack.back();
+            stack.pop_back();
+            while (!stack.empty())
+            {
+                double o = triangleOrientation(vertices[stack.back().first], vertices[last.first], vertices[u.first]);
+                if (u.second ? o <= 0.0 : o >= 0.0)
+                {
+                    break;
+                }
+                emit(u.first, last.first, stack.back().first);
+                last = stack.back();
+                stack.pop_back();
+            }
+            stack.push_back(last);
+            stack.push_back(u);
+        }
+    }
+    for (size_t k = 0; k + 1 < stack.size(); k++)
+    {
+        emit(sorted[m - 1].first, stack[k].first, stack[k + 1].first);
+    }
+}
+
+template <class Vertex>
+bool triangulateMonotone(const Vertex *vertices, size_t n, std::vector<uint32_t> &indices)
+{
+    if (n < 3 || polygonOrientation(vertices, n) == 0.0)
+    {
+        return false;
+    }
+    // Work on positions 0..n-1 of the counter-clockwise ring
+    std::vector<uint32_t> order = counterClockwiseRing(vertices, n);
+    n = order.size();
+    if (n == 0)
+    {
+        return false;
+    }
+    auto at = [&](size_t i) -> const Vertex & { return vertices[order[i]]; };
+    auto next = [n](size_t i) { return (i + 1) % n; };
+    auto prev = [n](size_t i) { return (i + n - 1) % n; };
+    // Sweep order: higher y first, then lower x (a tiny rotation breaks ties)
+    auto above = [&](size_t a, size_t b) {
+        return at(a).y > at(b).y ||
+               (at(a).y == at(b).y && (at(a).x < at(b).x || (at(a).x == at(b).x && order[a] < order[b])));
+    };
+
+    enum VertexKind
+    {
+        Start,
+        End,
+        Split,
+        Merge,
+        Regular
+    };
+    std::vector<VertexKind> kind(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        bool prevBelow = above(i, prev(i)), nextBelow = above(i, next(i));
+        bool convex = triangleOrientation(at(prev(i)), at(i), at(next(i))) > 0.0;
+        if (prevBelow && nextBelow) kind[i] = convex ? Start : Split;
+        else if (!prevBelow && !nextBelow) kind[i] = convex ? End : Merge;
+        else kind[i] = Regular;
+    }
+
+    std::vector<size_t> events(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        events[i] = i;
+    }
+    std::sort(events.begin(), events.end(), above);
+
+    // Edges i = (i, i + 1) that have the interior on their right, ordered
+    // left to right where they cross the sweep line. Edge n stands for the
+    // event vertex itself, so lower_bound(n) finds the first edge not left of it.
+    double sweepX = 0.0, sweepY = 0.0;
+    auto xOnSweep = [&](size_t e) {
+        if (e == n)
+        {
+            return sweepX;
+        }
+        const Vertex &a = at(e), &b = at(next(e));
+        if (a.y == b.y)
+        {
+            return sweepX; // Horizontal: crossed at the event point after the tie-breaking rotation
+        }
+        return double(a.x) + (double(b.x) - a.x) * (sweepY - a.y) / (double(b.y) - a.y);
+    };
+    auto leftToRight = [&](size_t a, size_t b) {
+        double xa = xOnSweep(a), xb = xOnSweep(b);
+        return xa < xb || (xa == xb && a != n && b != n && a < b);
+    };
+    std::set<size_t, decltype(leftToRight)> status(leftToRight);
+    std::vector<size_t> helper(n, n);
+    std::vector<std::pair<size_t, size_t>> diagonals;
+
+    auto diagonalToHelperIfMerge = [&](size_t e, size_t v) {
+        if (helper[e] < n && kind[helper[e]] == Merge)
+        {
+            diagonals.push_back({v, helper[e]});
+        }
+    };
+    auto edgeLeftOf = [&](size_t &e) {
+        auto it = status.lower_bound(n);
+        if (it == status.begin())
+        {
+            return false;
+        }
+        e = *--it;
+        return true;
+    };
+
+    for (size_t v : events)
+    {
+        sweepX = at(v).x;
+        sweepY = at(v).y;
+        size_t e = 0;
+        switch (kind[v])
+        {
+        case Start:
+            status.insert(v);
+            helper[v] = v;
+            break;
+        case End:
+            diagonalToHelperIfMerge(prev(v), v);
+            status.erase(prev(v));
+            break;
+        case Split:
+            if (!edgeLeftOf(e))
+            {
+                return false;
+            }
+            diagonals.push_back({v, helper[e]});
+            helper[e] = v;
+            status.insert(v);
+            helper[v] = v;
+            break;
+        case Merge:
+            diagonalToHelperIfMerge(prev(v), v);
+            status.erase(prev(v));
+            if (!edgeLeftOf(e))
+            {
+                return false;
+            }
+            diagonalToHelperIfMerge(e, v);
+            helper[e] = v;
+            break;
+        case Regular:
+            if (above(prev(v), v))
+            {
+                // Going down the left side: the interior is to the right
+                diagonalToHelperIfMerge(prev(v), v);
+                status.erase(prev(v));
+                status.insert(v);
+                helper[v] = v;
+            }
+            else
+            {
+                if (!edgeLeftOf(e))
+                {
+                    return false;
+                }
+                diagonalToHelperIfMerge(e, v);
+                helper[e] = v;
+            }
+            break;
+        }
+    }
+
+    // Pieces of the polygon cut along the diagonals: neighbours of every
+    // vertex sorted by angle, then each piece is walked keeping it on the left
+    std::vector<std::vector<size_t>> around(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        around[i].push_back(next(i));
+        around[i].push_back(prev(i));
+    }
+    for (auto &d : diagonals)
+    {
+        around[d.first].push_back(d.second);
+        around[d.second].push_back(d.first);
+    }
+    for (size_t i = 0; i < n; i++)
+    {
+        std::vector<std::pair<double, size_t>> byAngle;
+        for (size_t j : around[i])
+        {
+            byAngle.push_back({std::atan2(double(at(j).y) - at(i).y, double(at(j).x) - at(i).x), j});
+        }
+        std::sort(byAngle.begin(), byAngle.end());
+        for (size_t k = 0; k < byAngle.size(); k++)
+        {
+            around[i][k] = byAngle[k].second;
+        }
+    }
+    // Position of b among the neighbours of a; edge a -> b is walked[a][that]
+    auto slot = [&](size_t a, size_t b) {
+        return size_t(std::find(around[a].begin(), around[a].end(), b) - around[a].begin());
+    };
+    std::vector<std::vector<char>> walked(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        walked[i].assign(around[i].size(), 0);
+    }
+
+    std::vector<uint32_t> out;
+    out.reserve(3 * (n - 2));
+    std::vector<uint32_t> piece;
+    auto walk = [&](size_t u, size_t v) {
+        if (walked[u][slot(u, v)])
+        {
+            return true;
+        }
+        piece.clear();
+        size_t a = u, k = slot(u, v);
+        do
+        {
+            if (walked[a][k] || piece.size() > n)
+            {
+                return false;
+            }
+            walked[a][k] = 1;
+            piece.push_back(order[a]);
+            // Leave b arriving from a: the neighbour just clockwise of a around b
+            size_t b = around[a][k];
+            size_t back = slot(b, a);
+            k = (back + around[b].size() - 1) % around[b].size();
+            a = b;
+        } while (a != u || around[a][k] != v);
+        triangulateMonotonePiece(vertices, piece, out);
+        return true;
+    };
+    for (size_t i = 0; i < n; i++)
+    {
+        if (!walk(i, next(i)))
+        {
+            return false;
+        }
+    }
+    for (auto &d : diagonals)
+    {
+        if (!walk(d.first, d.second) || !walk(d.second, d.first))
+        {
+            return false;
+        }
+    }
+    indices.insert(indices.end(), out.begin(), out.end());
+    return true;
+}
+
+// Ear clipping for small polygons, monotone decomposition for large ones
+template <class Vertex>
+bool triangulatePolygon(const Vertex *vertices, size_t n, std::vector<uint32_t> &indices)
+{
+    if (n <= 64)
+    {
+        return triangulateEarClipping(vertices, n, indices);
+    }
+    return triangulateMonotone(vertices, n, indices);
+}
@@ -18,6 +18,10 @@ polygon above with shades of green asterisks*/
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <cmath>
+#include <vector>
+#include "ScanlinePolygon.h"
+#include "Triangulate.h"
+#include "../Affine2D.h"
 
 // Window dimensions
 const int WINDOW_WIDTH = 800;
@@ -53,24 +57,7 @@ const float SCALE_FACTOR = 2.0f;
 // 'original' is an array of vertices; the result is stored in 'scaled'.
 void scalePolygon(const Point original[], Point scaled[], int numVertices, float factor)
 {
-    for (int i = 0; i < numVertices; i++)
-    {
-        scaled[i].x = original[i].x * factor;
-        scaled[i].y = original[i].y * factor;
-    }
-}
-
-// Function to check if a point (x,y) is inside the polygon using the ray-casting algorithm.
-bool isPointInPolygon(const Point poly[], int numVertices, float x, float y)
-{
-    bool inside = false;
-    for (int i = 0, j = numVertices - 1; i < numVertices; j = i++)
-    {
-        if (((poly[i].y > y) != (poly[j].y > y)) &&
-            (x < (poly[j].x - poly[i].x) * (y - poly[i].y) / (poly[j].y - poly[i].y) + poly[i].x))
-            inside = !inside;
-    }
-    return inside;
+    transformPoints(Affine2D::scaling(factor), original, scaled, numVertices);
 }
 
 // Function to draw Cartesian axes with tick marks.
@@ -104,17 +91,93 @@ void drawAxes()
     glEnd();
 }
 
-// Function to draw a filled polygon given an array of vertices.
-// The polygon is filled using the GL_POLYGON function.
-void drawFilledPolygon(const Point poly[], int numVertices, float r, float g, float b)
+// A polygon triangulated once and kept on the GPU: positions in a vertex
+// buffer, triangles in an index buffer
+struct PolygonMesh
 {
-    glColor3f(r, g, b);
-    glBegin(GL_POLYGON);
-    for (int i = 0; i < numVertices; i++)
+    GLuint vbo = 0, ebo = 0;
+    GLsizei indexCount = 0;
+};
+
+PolygonMesh originalPolyMesh;
+
+// Cells per unit of the scanline fill used when triangulation fails
+const float FALLBACK_CELLS_PER_UNIT = 8.0f;
+
+// Target for fillPolygon(): each span of the polygon scaled by scale
+// becomes a quad (two triangles) over its cells, in the original units
+struct SpanQuads
+{
+    float scale;
+    std::vector<Point> vertices;
+    std::vector<uint32_t> indices;
+
+    void fillRow(int x0, int x1, int y)
     {
-        glVertex2f(poly[i].x, poly[i].y);
+        uint32_t base = uint32_t(vertices.size());
+        float left = (x0 - 0.5f) / scale, right = (x1 + 0.5f) / scale;
+        float bottom = (y - 0.5f) / scale, top = (y + 0.5f) / scale;
+        vertices.push_back({left, bottom});
+        vertices.push_back({right, bottom});
+        vertices.push_back({right, top});
+        vertices.push_back({left, top});
+        uint32_t quad[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+        indices.insert(indices.end(), quad, quad + 6);
     }
-    glEnd();
+};
+
+// Triangulate the polygon (Triangulate.h, so concave shapes fill correctly)
+// and upload it. A polygon the triangulation rejects (self-intersecting or
+// degenerate) is reported and filled from the scanline spans of
+// ScanlinePolygon.h instead.
+void uploadPolygonMesh(const Point poly[], int numVertices, PolygonMesh &mesh)
+{
+    std::vector<uint32_t> indices;
+    const Point *vertices = poly;
+    size_t vertexCount = size_t(numVertices);
+    SpanQuads spans = {FALLBACK_CELLS_PER_UNIT};
+    if (!triangulatePolygon(poly, size_t(numVertices), indices))
+    {
+        std::cerr << "Polygon is not simple and cannot be triangulated; using the scanline fill\n";
+        std::vector<Point> scaled(numVertices);
+        transformPoints(Affine2D::scaling(spans.scale), poly, scaled.data(), scaled.size());
+        fillPolygon(scaled.data(), scaled.size(), FillRule::EvenOdd, spans);
+        indices.swap(spans.indices);
+        vertices = spans.vertices.data();
+        vertexCount = spans.vertices.size();
+    }
+    glGenBuffers(1, &mesh.vbo);
+    glGenBuffers(1, &mesh.ebo);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(Point), vertices, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    mesh.indexCount = GLsizei(indices.size());
+}
+
+void releasePolygonMesh(PolygonMesh &mesh)
+{
+    glDeleteBuffers(1, &mesh.vbo);
+    glDeleteBuffers(1, &mesh.ebo);
+    mesh = PolygonMesh();
+}
+
+// Function to draw a filled polygon from its uploaded mesh: one
+// glDrawElements from the buffers. Upload the polygon again
+// (releasePolygonMesh, uploadPolygonMesh) when its vertices change.
+void drawFilledPolygon(const PolygonMesh &mesh, float r, float g, float b)
+{
+    glColor3f(r, g, b);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(Point), (void *)0);
+    glDrawElements(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, (void *)0);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
 // Function to draw the outline of a polygon given an array of vertices.
@@ -142,40 +205,24 @@ void drawAsterisk(float x, float y, float size)
     glEnd();
 }
 
+// Target for stampPolygon(): an asterisk at every stamped grid point
+struct AsteriskStamp
+{
+    float size;
+
+    void plot(int x, int y) { drawAsterisk(float(x), float(y), size); }
+};
+
 // Function to fill the interior of a polygon with green asterisks.
-// This function iterates over the polygon's bounding box using a grid,
-// tests whether each grid point is inside the polygon using the ray-casting algorithm,
-// and if so, draws a green asterisk at that point.
+// The scanline fill in ScanlinePolygon.h finds the inside grid points row by
+// row (even-odd rule, the same points a ray-casting test accepts), and a
+// green asterisk is drawn at each of them.
 void fillPolygonWithGreenAsterisks(const Point poly[], int numVertices)
 {
-    // Compute the bounding box.
-    float minX = poly[0].x, maxX = poly[0].x;
-    float minY = poly[0].y, maxY = poly[0].y;
-    for (int i = 1; i < numVertices; i++)
-    {
-        if (poly[i].x < minX)
-            minX = poly[i].x;
-        if (poly[i].x > maxX)
-            maxX = poly[i].x;
-        if (poly[i].y < minY)
-            minY = poly[i].y;
-        if (poly[i].y > maxY)
-            maxY = poly[i].y;
-    }
-
-    float step = 1.0f; // Grid step size.
-    for (float x = minX; x <= maxX; x += step)
-    {
-        for (float y = minY; y <= maxY; y += step)
-        {
-            if (isPointInPolygon(poly, numVertices, x, y))
-            {
-                // Draw a green asterisk at (x, y) with a fixed size.
-                glColor3f(0.0f, 1.0f, 0.0f);
-                drawAsterisk(x, y, 0.2f);
-            }
-        }
-    }
+    const int step = 1; // Grid step size.
+    glColor3f(0.0f, 1.0f, 0.0f);
+    AsteriskStamp stamp = {0.2f};
+    stampPolygon(poly, numVertices, FillRule::EvenOdd, step, stamp);
 }
 
 // Render the scene: draws the Cartesian plane, the original red-filled polygon,
@@ -188,7 +235,7 @@ void renderScene()
     drawAxes();
 
     // Draw the original polygon filled with red (#FF0000).
-    drawFilledPolygon(originalPoly, NUM_VERTICES, 1.0f, 0.0f, 0.0f);
+    drawFilledPolygon(originalPolyMesh, 1.0f, 0.0f, 0.0f);
 
     // Compute the scaled polygon vertices.
     scalePolygon(originalPoly, scaledPoly, NUM_VERTICES, SCALE_FACTOR);
@@ -240,6 +287,9 @@ int main()
     // Set the background color to black.
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
+    // The original polygon never changes: triangulate and upload it once.
+    uploadPolygonMesh(originalPoly, NUM_VERTICES, originalPolyMesh);
+
     // Main rendering loop.
     while (!glfwWindowShouldClose(window))
     {
@@ -248,6 +298,7 @@ int main()
         glfwPollEvents();
     }
 
+    releasePolygonMesh(originalPolyMesh);
     glfwTerminate();
     return 0;
 }
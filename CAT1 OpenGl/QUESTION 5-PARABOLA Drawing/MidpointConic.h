@@ -0,0 +1,296 @@
+// MidpointConic.h
+//
+// Incremental scan conversion of general conics
+//     F(x, y) = A x^2 + B xy + C y^2 + D x + E y + F = 0
+// with integer coefficients: parabolas, hyperbolas, and ellipses at any
+// angle (B != 0 rotates the axes). Pixels go to a Target that provides
+//     void plot(int x, int y);
+//
+// The walk follows the curve pixel by pixel, 8-connected. F and its
+// gradient at the current pixel are kept by forward differences, so a step
+// costs a few additions and no multiplication. The gradient picks the
+// direction of the next step: along x where the curve is flatter than 45
+// degrees and along y where it is steeper, so the region switch where the
+// slope crosses 1 happens wherever the curve turns, any number of times.
+// The choice between the straight and the diagonal steps is the midpoint
+// test on F, as in MidpointEllipse.h.
+//
+// Pixels outside a ConicClip rectangle are walked but not plotted, and the
+// walk stops early once it has left the rectangle for good (see
+// ConicClipEdge), so unbounded arcs cost about as much as their visible part.
+
+#pragma once
+
+#include <climits>
+#include <cstddef>
+#include <vector>
+
+struct Conic
+{
+    long long A, B, C, D, E, F;
+
+    long long value(long long x, long long y) const
+    {
+        return A * x * x + B * x * y + C * y * y + D * x + E * y + F;
+    }
+
+    // b^2 (x - cx)^2 + a^2 (y - cy)^2 = a^2 b^2
+    static Conic ellipse(int cx, int cy, int a, int b)
+    {
+        long long a2 = (long long)a * a, b2 = (long long)b * b;
+        return {b2, 0, a2, -2 * b2 * cx, -2 * a2 * cy, b2 * cx * cx + a2 * cy * cy - a2 * b2};
+    }
+
+    // b^2 (x - cx)^2 - a^2 (y - cy)^2 = a^2 b^2, branches opening along x
+    static Conic hyperbola(int cx, int cy, int a, int b)
+    {
+        long long a2 = (long long)a * a, b2 = (long long)b * b;
+        return {b2, 0, -a2, -2 * b2 * cx, 2 * a2 * cy, b2 * cx * cx - a2 * cy * cy - a2 * b2};
+    }
+
+    // (y - vy)^2 = p (x - vx): vertex (vx, vy), opening toward +x for p > 0
+    static Conic parabola(int vx, int vy, int p)
+    {
+        return {0, 0, 1, -(long long)p, -2LL * vy, (long long)vy * vy + (long long)p * vx};
+    }
+};
+
+// Inclusive pixel rectangle the conic is clipped to
+struct ConicClip
+{
+    int xMin, yMin;
+    int xMax, yMax;
+
+    bool contains(int x, int y) const { return x >= xMin && x <= xMax && y >= yMin && y <= yMax; }
+
+    static ConicClip unbounded() { return {INT_MIN, INT_MIN, INT_MAX, INT_MAX}; }
+};
+
+struct ConicPixel
+{
+    int x;
+    int y;
+};
+
+// Tracks the walk against one edge of the clip rectangle, through the line
+// two pixels beyond it (x = xMin - 2, ...). A line meets a conic at most
+// twice, so once the curve has crossed that line as often as it meets it
+// and is on the far side, it can never come back into view. The walk stays
+// within a pixel of the curve, so a pixel at least one pixel beyond the
+// line means the curve is beyond it too, and one at least one pixel inside
+// means the curve is inside.
+struct ConicClipEdge
+{
+    bool active = false;
+    long long line = 0; // x or y of the line
+    int outward = 1;    // +1 if beyond means larger coordinates
+    int roots = 0;      // Points where the whole conic meets the line (tangency counts twice)
+    int state = -1;     // -1 not known yet, 0 inside, 1 beyond
+    int crossings = 0;
+
+    // Edge along x = line (vertical) or y = line
+    void setup(const Conic &c, long long at, int dir, bool vertical)
+    {
+        active = true;
+        line = at;
+        outward = dir;
+        // The conic on the line: a t^2 + b t + k = 0, t the other coordinate
+        long double p = (long double)at;
+        long double a = vertical ? c.C : c.A;
+        long double b = vertical ? c.B * p + c.E : c.B * p + c.D;
+        long double k = vertical ? c.A * p * p + c.D * p + c.F : c.C * p * p + c.E * p + c.F;
+        if (a != 0)
+        {
+            long double disc = b * b - 4 * a * k;
+            long double scale = b * b + 4 * (a < 0 ? -a : a) * (k < 0 ? -k : k);
+            roots = (disc < -1e-12L * scale) ? 0 : 2; // A near-tangent counts as two crossings
+        }
+        else
+            roots = (b != 0) ? 1 : (k != 0 ? 0 : 3); // 3: the line is part of the conic, never give up
+    }
+
+    // Update with the coordinate of the current pixel; true once it is out of view for good
+    bool leftForGood(long long coordinate)
+    {
+        if (!active)
+            return false;
+        long long beyond = (coordinate - line) * outward;
+        int now = beyond >= 1 ? 1 : (beyond <= -1 ? 0 : state);
+        if (state >= 0 && now != state)
+            crossings++;
+        state = now;
+        return state == 1 && crossings >= roots;
+    }
+};
+
+// Walk the conic from pixel (x0, y0) to pixel (x1, y1), both on or next to
+// the curve, plotting every pixel inside clip. The walk goes the way that
+// keeps F < 0 on its left (counter-clockwise around an ellipse from the
+// functions above); negate all coefficients to go the other way. It ends
+// when it comes within one pixel of the end once it has been further away,
+// so an end within one pixel of the start traces the whole closed curve.
+// It also ends after maxSteps steps, at a singular point, or when it has
+// left clip for good. Returns the number of steps taken.
+// Tips sharper than a pixel (radius of curvature well under one pixel, as
+// at the ends of a very thin ellipse) cannot be followed; maxSteps bounds
+// the walk there.
+// Coefficients times coordinates squared must fit in 62 bits.
+template <class Target>
+size_t rasterConicArc(const Conic &c, int x0, int y0, int x1, int y1, const ConicClip &clip, Target &target,
+                      size_t maxSteps = size_t(1) << 26)
+{
+    long long x = x0, y = y0;
+    long long f = c.value(x, y);
+    long long gx = 2 * c.A * x + c.B * y + c.D; // dF/dx at (x, y)
+    long long gy = c.B * x + 2 * c.C * y + c.E; // dF/dy at (x, y)
+    const long long twoA = 2 * c.A, twoC = 2 * c.C;
+
+    ConicClipEdge edges[4];
+    if (clip.xMin != INT_MIN)
+        edges[0].setup(c, (long long)clip.xMin - 2, -1, true);
+    if (clip.xMax != INT_MAX)
+        edges[1].setup(c, (long long)clip.xMax + 2, 1, true);
+    if (clip.yMin != INT_MIN)
+        edges[2].setup(c, (long long)clip.yMin - 2, -1, false);
+    if (clip.yMax != INT_MAX)
+        edges[3].setup(c, (long long)clip.yMax + 2, 1, false);
+    auto outOfView = [&]()
+    {
+        bool gone = edges[0].leftForGood(x);
+        gone = edges[1].leftForGood(x) || gone; // Update every edge
+        gone = edges[2].leftForGood(y) || gone;
+        gone = edges[3].leftForGood(y) || gone;
+        return gone;
+    };
+
+    auto visit = [&](long long px, long long py)
+    {
+        if (clip.contains(int(px), int(py)))
+            target.plot(int(px), int(py));
+    };
+
+    // Move by (u, v), each -1, 0 or 1:
+    // F(x + u, y + v) = F + u gx + v gy + A u^2 + B uv + C v^2
+    auto move = [&](int u, int v)
+    {
+        if (u != 0)
+        {
+            f += (u > 0 ? gx : -gx) + c.A;
+            gx += u > 0 ? twoA : -twoA;
+            gy += u > 0 ? c.B : -c.B;
+            x += u;
+        }
+        if (v != 0)
+        {
+            f += (v > 0 ? gy : -gy) + c.C; // gy already includes the B u term
+            gx += v > 0 ? c.B : -c.B;
+            gy += v > 0 ? twoC : -twoC;
+            y += v;
+        }
+    };
+
+    // Across the major step the curve crosses the new column (or row) at
+    // some t; F there grows along t at rate g. Step +1 when the crossing is
+    // beyond the midpoint on the + side, -1 when beyond the one on the -
+    // side, else stay (the straight step).
+    auto minorStep = [](long long plus4, long long minus4, long long g)
+    {
+        if (g > 0 ? plus4 < 0 : plus4 > 0)
+            return 1;
+        if (g > 0 ? minus4 > 0 : minus4 < 0)
+            return -1;
+        return 0;
+    };
+
+    const bool closed = x1 == x0 && y1 == y0;
+    bool away = false;
+    size_t steps = 0;
+    visit(x, y);
+    while (steps < maxSteps && !outOfView())
+    {
+        long long ex = x - x1, ey = y - y1;
+        if (ex < -1 || ex > 1 || ey < -1 || ey > 1)
+            away = true;
+        else if (away)
+        {
+            if ((ex != 0 || ey != 0) && !closed)
+                visit(x1, y1); // Finish on the end pixel
+            break;
+        }
+
+        // Tangent (-gy, gx) keeps F < 0 on the left. Step one pixel along
+        // its larger component; the midpoint tests on the two sides then
+        // pick the row (or column) the curve crosses nearest to.
+        long long tx = -gy, ty = gx;
+        if (tx == 0 && ty == 0)
+            break; // Singular point
+        if ((tx < 0 ? -tx : tx) >= (ty < 0 ? -ty : ty))
+        {
+            int sx = tx > 0 ? 1 : -1;
+            // F and dF/dy at (x + sx, y); 4 F at (x + sx, y +- 1/2)
+            long long f1 = f + (sx > 0 ? gx : -gx) + c.A;
+            long long g1 = gy + (sx > 0 ? c.B : -c.B);
+            long long up4 = 4 * f1 + 2 * g1 + c.C, down4 = 4 * f1 - 2 * g1 + c.C;
+            move(sx, minorStep(up4, down4, g1));
+        }
+        else
+        {
+            int sy = ty > 0 ? 1 : -1;
+            // F and dF/dx at (x, y + sy); 4 F at (x +- 1/2, y + sy)
+            long long f1 = f + (sy > 0 ? gy : -gy) + c.C;
+            long long g1 = gx + (sy > 0 ? c.B : -c.B);
+            long long right4 = 4 * f1 + 2 * g1 + c.A, left4 = 4 * f1 - 2 * g1 + c.A;
+            move(minorStep(right4, left4, g1), sy);
+        }
+        steps++;
+
+        if (closed && away && x == x0 && y == y0)
+            break; // Back at the start
+        visit(x, y);
+    }
+    return steps;
+}
+
+// Closed curve through (x0, y0): an ellipse, or a whole branch of a
+// parabola or hyperbola as far as it stays in clip
+template <class Target>
+size_t rasterConic(const Conic &c, int x0, int y0, const ConicClip &clip, Target &target,
+                   size_t maxSteps = size_t(1) << 26)
+{
+    return rasterConicArc(c, x0, y0, x0, y0, clip, target, maxSteps);
+}
+
+// Arc pixels appended to points. Returns the number added.
+inline size_t rasterConicArcPoints(const Conic &c, int x0, int y0, int x1, int y1, const ConicClip &clip,
+                                   std::vector<ConicPixel> &points)
+{
+    struct Append
+    {
+        std::vector<ConicPixel> &points;
+        void plot(int x, int y) { points.push_back({x, y}); }
+    } append = {points};
+    size_t before = points.size();
+    rasterConicArc(c, x0, y0, x1, y1, clip, append);
+    return points.size() - before;
+}
+
+// Arc pixels written to a caller's buffer of capacity entries. Returns the
+// number of pixels in the arc, which may be more than were written: call
+// again with a larger buffer when it is.
+inline size_t rasterConicArcInto(const Conic &c, int x0, int y0, int x1, int y1, const ConicClip &clip,
+                                 ConicPixel *buffer, size_t capacity)
+{
+    struct Write
+    {
+        ConicPixel *buffer;
+        size_t capacity, count;
+        void plot(int x, int y)
+        {
+            if (count < capacity)
+                buffer[count] = {x, y};
+            count++;
+        }
+    } write = {buffer, capacity, 0};
+    rasterConicArc(c, x0, y0, x1, y1, clip, write);
+    return write.count;
+}
@@ -17,6 +17,8 @@ Show the working of the method and implement it using OpenGL*/
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <iostream>
+#include <vector>
+#include "MidpointConic.h"
 
 // Window dimensions
 const int WINDOW_WIDTH = 800;
@@ -94,27 +96,20 @@ int main()
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
     // --- Compute parabola points using the incremental (midpoint) method ---
-    // We will compute for y from 0 to 10.
-    const int numPoints = 11; // y = 0,1,...,10
-    int xPoints[numPoints];   // x coordinate for y>=0
-    int yPoints[numPoints];   // y coordinate (will be 0,1,...,10)
-
-    // Start at the vertex.
-    int x = 0, y = 0;
-    xPoints[0] = x;
-    yPoints[0] = y;
-    std::cout << "(0, 0)" << std::endl;
-
-    // For each subsequent scanline (y increases by 1),
-    // update x by the difference: (y+1)^2 - y^2 = 2y + 1.
-    for (int i = 1; i < numPoints; i++)
+    // x = y^2 is the conic y^2 - x = 0 (kernel in MidpointConic.h). The walk
+    // goes from (100, 10) through the vertex to (100, -10), one connected
+    // pixel at a time, clipped to the visible window.
+    Conic parabola = Conic::parabola(0, 0, 1);
+    ConicClip view = {-10, -20, 110, 20}; // gluOrtho2D(-10, 110, -20, 20)
+    std::vector<ConicPixel> points;
+    rasterConicArcPoints(parabola, 100, 10, 100, -10, view, points);
+
+    // Print the pixels that lie exactly on the curve (x = y^2)
+    std::cout << points.size() << " pixels; on the curve:" << std::endl;
+    for (const ConicPixel &p : points)
     {
-        int delta = 2 * y + 1; // This is exactly the increment in the ideal curve.
-        x = x + delta;         // New x coordinate.
-        y = y + 1;             // New y coordinate.
-        xPoints[i] = x;
-        yPoints[i] = y;
-        std::cout << "(" << x << ", " << y << ")" << std::endl;
+        if (p.x == p.y * p.y)
+            std::cout << "(" << p.x << ", " << p.y << ")" << std::endl;
     }
 
     // --- Main render loop ---
@@ -130,30 +125,19 @@ int main()
         glColor3f(1.0f, 1.0f, 0.0f);
         glPointSize(5.0f);
         glBegin(GL_POINTS);
-        // For y >= 0 (from the computed points)
-        for (int i = 0; i < numPoints; i++)
+        for (const ConicPixel &p : points)
         {
-            glVertex2i(xPoints[i], yPoints[i]);
-        }
-        // Using symmetry, for each computed point (except y=0) also plot (x, -y)
-        for (int i = 1; i < numPoints; i++)
-        {
-            glVertex2i(xPoints[i], -yPoints[i]);
+            glVertex2i(p.x, p.y);
         }
         glEnd();
 
-        // For a smoother visual, you can connect the points with lines.
+        // For a smoother visual, connect the points with lines; the walk
+        // visits them in order along the curve, so one strip does it.
         glColor3f(0.0f, 1.0f, 0.0f); // green line
         glBegin(GL_LINE_STRIP);
-        for (int i = 0; i < numPoints; i++)
-        {
-            glVertex2i(xPoints[i], yPoints[i]);
-        }
-        glEnd();
-        glBegin(GL_LINE_STRIP);
-        for (int i = 0; i < numPoints; i++)
+        for (const ConicPixel &p : points)
         {
-            glVertex2i(xPoints[i], -yPoints[i]);
+            glVertex2i(p.x, p.y);
         }
         glEnd();
 
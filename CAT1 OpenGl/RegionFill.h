@@ -0,0 +1,204 @@
+// RegionFill.h
+//
+// Fills every enclosed region of a PixelMask at once, using all cores.
+// floodFill() (FloodFill.h) needs a seed per region and runs on one thread;
+// here the empty cells are labelled into connected components with
+// union-find, and every component that does not reach the edge of the mask
+// is filled. Boundaries come from any rasterizer that plots into the mask:
+// rasterEllipseMidpoint, rasterCircleBresenham, polygon edges drawn with
+// rasterLineBresenham, ...
+//
+// The labelling is done in three passes:
+//   1. Tiles in parallel: each worker labels one square tile at a time with
+//      links that stay inside the tile, so workers never touch each other's
+//      cells. Every cell ends up pointing straight at its tile-local root.
+//   2. Serially: tile roots are merged across tile seams, and all components
+//      that reach the mask edge are merged into one "outside" component.
+//      Only seam cells are visited, a small fraction of the mask.
+//   3. Tiles in parallel: each cell follows its root chain (read only) and
+//      is filled unless it belongs to the outside component.
+// A root is always the smallest cell index in its component, so the result
+// does not depend on the number of threads or the tile size.
+// Memory: one uint32_t label per cell, in addition to the mask.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "FloodFill.h" // PixelMask, MASK_* values
+
+struct RegionFillOptions {
+    int connectivity = 4; // Of the regions; use 4 inside 8-connected outlines such as the midpoint curves
+    int tileSize = 256;   // Tile edge in pixels
+    unsigned threads = 0; // 0 = one per hardware thread
+};
+
+// What fillEnclosedRegions() did
+struct RegionFillStats {
+    size_t regions = 0; // Enclosed components filled
+    size_t pixels = 0;
+};
+
+// Replace every MASK_EMPTY cell that is not connected to the edge of the mask with fill
+inline RegionFillStats fillEnclosedRegions(PixelMask &mask, uint8_t fill = MASK_FILLED,
+                                           const RegionFillOptions &options = RegionFillOptions()) {
+    RegionFillStats stats;
+    const int w = mask.width, h = mask.height;
+    if (w == 0 || h == 0 || fill == MASK_EMPTY) return stats;
+
+    const int tileSize = std::max(8, options.tileSize);
+    const int tilesX = (w + tileSize - 1) / tileSize, tilesY = (h + tileSize - 1) / tileSize;
+    const size_t tiles = size_t(tilesX) * size_t(tilesY);
+    unsigned workers = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    workers = unsigned(std::min<size_t>(workers, tiles));
+    const bool diagonal = options.connectivity == 8;
+
+    uint8_t *cells = mask.cells.data();
+    std::vector<uint32_t> parent(size_t(w) * size_t(h));
+    auto empty = [&](size_t c) { return cells[c] == MASK_EMPTY; };
+    auto find = [&](uint32_t c) {
+        while (parent[c] != c) {
+            parent[c] = parent[parent[c]]; // Path halving
+            c = parent[c];
+        }
+        return c;
+    };
+    auto unite = [&](uint32_t a, uint32_t b) {
+        a = find(a);
+        b = find(b);
+        if (a < b) parent[b] = a;
+        else if (b < a) parent[a] = b;
+    };
+
+    // Run body(col0, row0, col1, row1) for every tile, one tile at a time per worker
+    auto forEachTile = [&](auto body) {
+        std::atomic<size_t> nextTile(0);
+        std::vector<std::thread> pool;
+        for (unsigned i = 0; i < workers; i++) {
+            pool.emplace_back([&]() {
+                for (size_t t = nextTile++; t < tiles; t = nextTile++) {
+                    int col0 = int(t % tilesX) * tileSize, row0 = int(t / tilesX) * tileSize;
+                    body(col0, row0, std::min(col0 + tileSize, w) - 1, std::min(row0 + tileSize, h) - 1);
+                }
+            });
+        }
+        for (std::thread &thread : pool) thread.join();
+    };
+
+    // Pass 1: label each tile on its own
+    forEachTile([&](int col0, int row0, int col1, int row1) {
+        for (int y = row0; y <= row1; y++) {
+            for (int x = col0; x <= col1; x++) {
+                uint32_t c = uint32_t(size_t(y) * w + x);
+                parent[c] = c;
+                if (!empty(c)) continue;
+                bool left = x > col0 && empty(c - 1), up = y > row0 && empty(c - w);
+                bool upLeft = x > col0 && y > row0 && empty(c - w - 1);
+                bool upRight = x < col1 && y > row0 && empty(c - w + 1);
+                // Join c to a neighbour's component by copying its label, and only
+                // unite with the others where they may not be joined already
+                if (!diagonal) {
+                    if (left) {
+                        parent[c] = parent[c - 1];
+                        if (up && !upLeft) unite(c, c - w); // Otherwise joined through the up-left cell
+                    }
+                    else if (up) parent[c] = parent[c - w];
+                }
+                else if (up) parent[c] = parent[c - w]; // All the other neighbours touch the one above
+                else {
+                    if (left) parent[c] = parent[c - 1];
+                    else if (upLeft) parent[c] = parent[c - w - 1];
+                    if (upRight) {
+                        if (left || upLeft) unite(c, c - w + 1);
+                        else parent[c] = parent[c - w + 1];
+                    }
+                }
+            }
+        }
+        // Roots come first in scan order, so one pass points every cell at its root
+        for (int y = row0; y <= row1; y++) {
+            for (int x = col0; x <= col1; x++) {
+                uint32_t c = uint32_t(size_t(y) * w + x);
+                parent[c] = parent[parent[c]];
+            }
+        }
+    });
+
+    // Pass 2: join tiles across their seams, looking back at neighbours in other tiles
+    auto joinBack = [&](int x, int y) {
+        uint32_t c = uint32_t(size_t(y) * w + x);
+        if (!empty(c)) return;
+        int tx = x / tileSize, ty = y / tileSize;
+        auto link = [&](int nx, int ny) {
+            if (nx < 0 || nx >= w || ny < 0) return;
+            if (nx / tileSize == tx && ny / tileSize == ty) return; // Joined in pass 1
+            uint32_t n = uint32_t(size_t(ny) * w + nx);
+            if (empty(n)) unite(c, n);
+        };
+        link(x - 1, y);
+        link(x, y - 1);
+        if (diagonal) {
+            link(x - 1, y - 1);
+            link(x + 1, y - 1);
+        }
+    };
+    for (int y = 0; y < h; y++) {
+        if (y % tileSize == 0) {
+            for (int x = 0; x < w; x++) joinBack(x, y);
+        }
+        else {
+            // Left and right columns of each tile; the right one sees up-right across the seam
+            for (int x = 0; x < w; x += tileSize) {
+                joinBack(x, y);
+                if (diagonal) joinBack(std::min(x + tileSize, w) - 1, y);
+            }
+        }
+    }
+
+    // Everything that reaches the edge of the mask is outside
+    const uint32_t NONE = UINT32_MAX;
+    uint32_t outside = NONE;
+    auto joinOutside = [&](int x, int y) {
+        uint32_t c = uint32_t(size_t(y) * w + x);
+        if (!empty(c)) return;
+        if (outside == NONE) outside = c;
+        else unite(outside, c);
+    };
+    for (int x = 0; x < w; x++) {
+        joinOutside(x, 0);
+        joinOutside(x, h - 1);
+    }
+    for (int y = 0; y < h; y++) {
+        joinOutside(0, y);
+        joinOutside(w - 1, y);
+    }
+    if (outside != NONE) outside = find(outside);
+
+    // Pass 3: fill; parent is only read from here on
+    std::atomic<size_t> regions(0), pixels(0);
+    forEachTile([&](int col0, int row0, int col1, int row1) {
+        size_t myRegions = 0, myPixels = 0;
+        for (int y = row0; y <= row1; y++) {
+            for (int x = col0; x <= col1; x++) {
+                uint32_t c = uint32_t(size_t(y) * w + x);
+                if (!empty(c)) continue;
+                uint32_t r = parent[c];
+                while (parent[r] != r) r = parent[r];
+                if (r == outside) continue;
+                if (r == c) myRegions++;
+                cells[c] = fill;
+                myPixels++;
+            }
+        }
+        regions += myRegions;
+        pixels += myPixels;
+    });
+    stats.regions = regions;
+    stats.pixels = pixels;
+    return stats;
+}
@@ -0,0 +1,157 @@
+// ShapeCache.h
+//
+// Keeps rasterized shapes in vertex buffers between frames.
+// The programs used to rerun their algorithms and resend every vertex with
+// glBegin/glEnd on each pass of the render loop, although the parameters
+// never change. Here each shape lives in a numbered slot together with the
+// parameters it was built from (a ShapeKey: centre, radius, axes, rotation,
+// ...). Drawing a slot with the same key only binds its buffer and issues
+// one glDrawArrays per batch; a different key rebuilds the geometry and
+// uploads it again.
+//
+// Typical use inside renderScene():
+//     shapes.draw(SLOT_CIRCLE, ShapeKey{cx, cy, radius}, [&](ShapeGeometry &g) {
+//         g.begin(GL_POINTS, 0.0f, 1.0f, 0.0f, 5.0f);
+//         ... g.vertex(x, y) ...
+//     });
+// Needs a GL 1.5 context (vertex buffer objects); release() frees the
+// buffers and must run while the context is current.
+
+#pragma once
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Most parameters a ShapeKey holds
+const size_t SHAPE_KEY_MAX_VALUES = 8;
+
+// Parameters a shape was built from; equal keys mean equal geometry. The
+// values are stored inline, so building a key each frame allocates nothing,
+// and a key with more than SHAPE_KEY_MAX_VALUES of them does not compile.
+struct ShapeKey {
+    float values[SHAPE_KEY_MAX_VALUES] = {};
+    size_t count = 0;
+
+    ShapeKey() {}
+    template <class... Rest>
+    ShapeKey(float first, Rest... rest) : values{first, float(rest)...}, count(1 + sizeof...(Rest)) {
+        static_assert(1 + sizeof...(Rest) <= SHAPE_KEY_MAX_VALUES, "ShapeKey holds at most SHAPE_KEY_MAX_VALUES values");
+    }
+
+    bool operator==(const ShapeKey &other) const {
+        return count == other.count && std::equal(values, values + count, other.values);
+    }
+    bool operator!=(const ShapeKey &other) const { return !(*this == other); }
+};
+
+// A run of vertices drawn with one primitive mode and color
+struct ShapeBatch {
+    GLenum mode;
+    GLint first;
+    GLsizei count;
+    float color[3];
+    float pointSize; // Also used as the line width for line modes
+};
+
+// Geometry produced by a build function: x, y pairs split into batches
+struct ShapeGeometry {
+    std::vector<float> vertices;
+    std::vector<ShapeBatch> batches;
+
+    // Start a new batch; following vertex() calls belong to it
+    void begin(GLenum mode, float r, float g, float b, float pointSize = 1.0f) {
+        ShapeBatch batch = {mode, GLint(vertices.size() / 2), 0, {r, g, b}, pointSize};
+        batches.push_back(batch);
+    }
+
+    void vertex(float x, float y) {
+        vertices.push_back(x);
+        vertices.push_back(y);
+        batches.back().count++;
+    }
+
+    // Append n x, y pairs in one go
+    void vertices2(const float *xy, size_t n) {
+        vertices.insert(vertices.end(), xy, xy + 2 * n);
+        batches.back().count += GLsizei(n);
+    }
+};
+
+// Target for the rasterization kernels: every plotted pixel becomes a vertex
+struct ShapeGeometryTarget {
+    ShapeGeometry &geometry;
+
+    void plot(int x, int y) { geometry.vertex(float(x), float(y)); }
+};
+
+class ShapeCache {
+public:
+    // Draw slot with the geometry for key, calling build(ShapeGeometry &)
+    // first if the slot is empty or was built from a different key
+    template <class Build>
+    void draw(size_t slot, const ShapeKey &key, Build build) {
+        if (slot >= slots.size()) slots.resize(slot + 1);
+        Slot &s = slots[slot];
+        if (!s.built || s.key != key) {
+            ShapeGeometry geometry;
+            build(geometry);
+            upload(s, geometry);
+            s.key = key;
+            s.built = true;
+            rebuilds++;
+        }
+        drawSlot(s);
+    }
+
+    // Force slot to be rebuilt on its next draw
+    void invalidate(size_t slot) {
+        if (slot < slots.size()) slots[slot].built = false;
+    }
+
+    // Number of times any slot has been (re)built
+    size_t rebuildCount() const { return rebuilds; }
+
+    void release() {
+        for (Slot &s : slots) {
+            if (s.vbo) glDeleteBuffers(1, &s.vbo);
+        }
+        slots.clear();
+    }
+
+private:
+    struct Slot {
+        ShapeKey key;
+        bool built = false;
+        GLuint vbo = 0;
+        std::vector<ShapeBatch> batches;
+    };
+
+    std::vector<Slot> slots;
+    size_t rebuilds = 0;
+
+    static void upload(Slot &s, const ShapeGeometry &geometry) {
+        if (!s.vbo) glGenBuffers(1, &s.vbo);
+        glBindBuffer(GL_ARRAY_BUFFER, s.vbo);
+        glBufferData(GL_ARRAY_BUFFER, geometry.vertices.size() * sizeof(float), geometry.vertices.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        s.batches = geometry.batches;
+    }
+
+    static void drawSlot(const Slot &s) {
+        glBindBuffer(GL_ARRAY_BUFFER, s.vbo);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glVertexPointer(2, GL_FLOAT, 0, (void *)0);
+        for (const ShapeBatch &batch : s.batches) {
+            if (batch.count == 0) continue;
+            glColor3f(batch.color[0], batch.color[1], batch.color[2]);
+            if (batch.mode == GL_POINTS) glPointSize(batch.pointSize);
+            else if (batch.mode == GL_LINES || batch.mode == GL_LINE_STRIP || batch.mode == GL_LINE_LOOP)
+                glLineWidth(batch.pointSize);
+            glDrawArrays(batch.mode, batch.first, batch.count);
+        }
+        glDisableClientState(GL_VERTEX_ARRAY);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+};
@@ -0,0 +1,261 @@
+// PieChartRenderer.h
+//
+// Retained-mode pie and donut charts. The programs used to recompute
+// cos/sin for every degree and send each slice with its own
+// glBegin(GL_TRIANGLE_FAN), plus separate passes for the lines, on every
+// redisplay. Here the geometry of all charts lives in one vertex buffer
+// with one index buffer: the slices of every chart are drawn with a single
+// glDrawElements(GL_TRIANGLES) and all separators and rims with a single
+// glDrawElements(GL_LINES). Geometry is only rebuilt for a chart whose
+// values, appearance or level of detail changed, and written over its own
+// part of the buffers (see PieGeometry.h); the buffers are laid out again
+// only when a chart gains slices or changes level. When single values
+// change, only the slices from the first changed one on are laid out again
+// and uploaded, and the total is adjusted rather than summed again. That
+// needs PieChart::fullTurn: when slices are shares of the total, a change
+// to any value moves all of them and the whole chart is laid out again.
+//
+// Typical use:
+//     PieChartRenderer pies;                 // After glewInit()
+//     size_t id = pies.add(chart);
+//     ... in reshape():  pies.setView(view);
+//     ... in display():  pies.draw();
+//     ... when data changes: pies.setValues(id, values, count);
+//                            or pies.setValue(id, i, value);
+// Needs a GL 1.5 context (vertex buffer objects); release() frees the
+// buffers and must run while the context is current.
+
+#pragma once
+
+#include "PieGeometry.h"
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class PieChartRenderer {
+public:
+    // Add a chart; returns its id
+    size_t add(const PieChart &chart) {
+        Entry e;
+        e.chart = chart;
+        e.level = levelFor(chart);
+        e.total = pieTotal(chart);
+        entries.push_back(e);
+        return entries.size() - 1;
+    }
+
+    // Replace chart id (position, colors, values, ...)
+    void set(size_t id, const PieChart &chart) {
+        Entry &e = entries[id];
+        e.chart = chart;
+        e.level = levelFor(chart);
+        e.total = pieTotal(chart);
+        e.rebuild = true;
+    }
+
+    // New value for slice i of chart id; i at or past the end adds slices.
+    // Only slice i and the ones after it are laid out again (all of them
+    // when the chart has no fullTurn and the total changes), and only
+    // their part of the buffers is rewritten.
+    void setValue(size_t id, size_t i, float value) {
+        Entry &e = entries[id];
+        std::vector<float> &values = e.chart.values;
+        if (i >= values.size()) {
+            values.resize(i + 1, 0.0f);
+            values[i] = value;
+            e.total += value > 0.0f ? value : 0.0f;
+            e.rebuild = true; // More slices: new capacity
+            return;
+        }
+        if (values[i] == value) return;
+        e.total += (value > 0.0f ? value : 0.0f) - (values[i] > 0.0f ? values[i] : 0.0f);
+        values[i] = value;
+        e.firstChanged = std::min(e.firstChanged, i);
+    }
+
+    // New values for chart id; only the ones that differ count as changed
+    void setValues(size_t id, const float *values, size_t count) {
+        Entry &e = entries[id];
+        if (e.chart.values.size() != count) {
+            e.chart.values.assign(values, values + count);
+            e.total = pieTotal(e.chart);
+            e.rebuild = true;
+            return;
+        }
+        for (size_t i = 0; i < count; i++)
+            if (values[i] != e.chart.values[i]) setValue(id, i, values[i]);
+    }
+
+    const PieChart &chart(size_t id) const { return entries[id].chart; }
+
+    // Angles and share of slice i of chart id as of the last draw(), for labels
+    const PieSlice &slice(size_t id, size_t i) const { return entries[id].geometry.slices[i]; }
+
+    size_t size() const { return entries.size(); }
+
+    // Projection the charts are shown with; picks each chart's level of
+    // detail for tolerance pixels (see ArcTessellation.h)
+    void setView(const OrthoView &v, double tolerance = 0.25) {
+        view = v;
+        pixelTolerance = tolerance;
+        for (Entry &e : entries) {
+            int level = levelFor(e.chart);
+            if (level != e.level) {
+                e.level = level;
+                e.rebuild = true;
+            }
+        }
+    }
+
+    // Rebuild what changed, then draw every chart
+    void draw(float lineWidth = 1.0f) {
+        update();
+        if (fillCount == 0 && lineCount == 0) return;
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glVertexPointer(2, GL_FLOAT, sizeof(PieVertex), (void *)offsetof(PieVertex, x));
+        glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(PieVertex), (void *)offsetof(PieVertex, color));
+        if (fillCount) glDrawElements(GL_TRIANGLES, GLsizei(fillCount), GL_UNSIGNED_INT, (void *)0);
+        if (lineCount) {
+            glLineWidth(lineWidth);
+            glDrawElements(GL_LINES, GLsizei(lineCount), GL_UNSIGNED_INT, (void *)(fillCount * sizeof(uint32_t)));
+        }
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    // Number of times a chart's geometry has been built whole
+    size_t rebuildCount() const { return rebuilds; }
+
+    // Number of times part of a chart's geometry has been laid out again
+    size_t updateCount() const { return updates; }
+
+    void release() {
+        if (vbo) glDeleteBuffers(1, &vbo);
+        if (ebo) glDeleteBuffers(1, &ebo);
+        vbo = ebo = 0;
+        for (Entry &e : entries) e.rebuild = true;
+    }
+
+private:
+    static const size_t NO_SLICE = size_t(-1);
+
+    struct Entry {
+        PieChart chart;
+        PieGeometry geometry;
+        int level = ARC_MIN_LEVEL;
+        double total = 0.0;             // Sum of the values, adjusted as they change
+        bool rebuild = true;            // Build the geometry whole
+        size_t firstChanged = NO_SLICE; // Else lay it out again from this slice
+        PieGeometryChange pending = {0, 0, 0, 0, 0, 0}; // Not uploaded yet
+        size_t firstVertex = 0, firstFill = 0, firstLine = 0; // Where its geometry sits in the buffers
+    };
+
+    std::vector<Entry> entries;
+    OrthoView view = {-1.0, 1.0, -1.0, 1.0, 600, 600};
+    double pixelTolerance = 0.25;
+    GLuint vbo = 0, ebo = 0;
+    size_t vertexCount = 0, fillCount = 0, lineCount = 0;
+    size_t rebuilds = 0, updates = 0;
+    std::vector<uint32_t> scratch;
+
+    int levelFor(const PieChart &chart) const { return arcLevel(chart.radius, view, pixelTolerance); }
+
+    // Indices first..end of e's geometry moved to where its vertices sit in the buffer
+    const std::vector<uint32_t> &placed(const Entry &e, const std::vector<uint32_t> &local, size_t first, size_t end) {
+        scratch.resize(end - first);
+        for (size_t i = first; i < end; i++) scratch[i - first] = uint32_t(local[i] + e.firstVertex);
+        return scratch;
+    }
+
+    void update() {
+        bool relayout = vbo == 0;
+        for (Entry &e : entries) {
+            PieGeometry &g = e.geometry;
+            if (e.rebuild) {
+                size_t vertices = g.vertices.size(), fill = g.fill.size(), lines = g.lines.size();
+                e.total = pieTotal(e.chart); // Summed afresh whenever everything is laid out
+                buildPieGeometry(e.chart, e.level, g, e.total);
+                rebuilds++;
+                e.pending = {0, g.vertices.size(), 0, g.fill.size(), 0, g.lines.size()};
+                if (g.vertices.size() != vertices || g.fill.size() != fill || g.lines.size() != lines)
+                    relayout = true; // New capacity: the ranges after it move
+            }
+            else if (e.firstChanged != NO_SLICE) {
+                e.pending = updatePieGeometry(e.chart, e.total, e.firstChanged, g);
+                updates++;
+            }
+            e.rebuild = false;
+            e.firstChanged = NO_SLICE;
+        }
+        if (relayout) layOut();
+        else {
+            for (Entry &e : entries) upload(e);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+        for (Entry &e : entries) e.pending = {0, 0, 0, 0, 0, 0};
+    }
+
+    // Write the part of e's geometry that changed over its place in the buffers
+    void upload(const Entry &e) {
+        const PieGeometry &g = e.geometry;
+        const PieGeometryChange &c = e.pending;
+        if (c.endVertex > c.firstVertex) {
+            glBindBuffer(GL_ARRAY_BUFFER, vbo);
+            glBufferSubData(GL_ARRAY_BUFFER, (e.firstVertex + c.firstVertex) * sizeof(PieVertex),
+                            (c.endVertex - c.firstVertex) * sizeof(PieVertex), &g.vertices[c.firstVertex]);
+        }
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+        if (c.endFill > c.firstFill)
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (e.firstFill + c.firstFill) * sizeof(uint32_t),
+                            (c.endFill - c.firstFill) * sizeof(uint32_t),
+                            placed(e, g.fill, c.firstFill, c.endFill).data());
+        if (c.endLine > c.firstLine)
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (fillCount + e.firstLine + c.firstLine) * sizeof(uint32_t),
+                            (c.endLine - c.firstLine) * sizeof(uint32_t),
+                            placed(e, g.lines, c.firstLine, c.endLine).data());
+    }
+
+    // Place every chart and upload both buffers whole: fill indices of all
+    // charts first, then all line indices
+    void layOut() {
+        vertexCount = fillCount = lineCount = 0;
+        for (Entry &e : entries) {
+            e.firstVertex = vertexCount;
+            e.firstFill = fillCount;
+            e.firstLine = lineCount;
+            vertexCount += e.geometry.vertices.size();
+            fillCount += e.geometry.fill.size();
+            lineCount += e.geometry.lines.size();
+        }
+        std::vector<PieVertex> vertices;
+        std::vector<uint32_t> indices;
+        vertices.reserve(vertexCount);
+        indices.reserve(fillCount + lineCount);
+        for (Entry &e : entries) {
+            vertices.insert(vertices.end(), e.geometry.vertices.begin(), e.geometry.vertices.end());
+            const std::vector<uint32_t> &fill = placed(e, e.geometry.fill, 0, e.geometry.fill.size());
+            indices.insert(indices.end(), fill.begin(), fill.end());
+        }
+        for (Entry &e : entries) {
+            const std::vector<uint32_t> &lines = placed(e, e.geometry.lines, 0, e.geometry.lines.size());
+            indices.insert(indices.end(), lines.begin(), lines.end());
+        }
+        if (!vbo) glGenBuffers(1, &vbo);
+        if (!ebo) glGenBuffers(1, &ebo);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(PieVertex), vertices.data(), GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+};
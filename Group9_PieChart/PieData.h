@@ -0,0 +1,334 @@
+// PieData.h
+//
+// Chart data read from a file instead of the values[] and labels[] arrays
+// compiled into the programs, for charts fed by live counters. Two formats:
+//
+//   CSV     one "label,value" record per line. Blank lines, lines starting
+//           with '#' and lines whose value is not a number (a header row)
+//           are skipped. The label runs up to the last comma.
+//   binary  the four bytes "PIE1", then records of a one-byte label length,
+//           the label, and the value as a little-endian 32-bit float.
+//
+// A record for a label seen before sets that slice's value; a new label
+// adds a slice at the end. Each PieDataStream::poll() reads only the bytes
+// appended since the previous one, so a writer can keep appending updates
+// to the same file. A last CSV line without a newline is applied once the
+// file has stopped growing for a poll, and read again in full if the
+// writer goes on to finish it.
+//
+// The file is read again from the start when it has been rewritten: when
+// the path names a new file (written elsewhere and renamed over it), when
+// it shrinks, or when the last bytes already read have changed. A rewrite
+// in place that keeps those bytes, at the same or a larger size, goes
+// unnoticed.
+//
+// Typical use, with PieChartRenderer.h:
+//     PieDataStream data;  PieSeries series;
+//     data.open(path);  data.poll(series);
+//     ... on a timer:    if (data.poll(series)) glutPostRedisplay();
+//     ... in display():  pies.setValues(id, series.values().data(), series.size());
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Labels and values of one chart, in the order the labels first appeared
+class PieSeries {
+public:
+    size_t size() const { return amounts.size(); }
+    const std::string &label(size_t i) const { return names[i]; }
+    float value(size_t i) const { return amounts[i]; }
+    const std::vector<float> &values() const { return amounts; }
+
+    // Set the value of label, adding a slice at the end if it is new.
+    // Returns the slice.
+    size_t set(const std::string &label, float value) {
+        auto found = slots.find(label);
+        if (found != slots.end()) {
+            amounts[found->second] = value;
+            return found->second;
+        }
+        slots.emplace(label, names.size());
+        names.push_back(label);
+        amounts.push_back(value);
+        return names.size() - 1;
+    }
+
+    void clear() {
+        names.clear();
+        amounts.clear();
+        slots.clear();
+    }
+
+private:
+    std::vector<std::string> names;
+    std::vector<float> amounts;
+    std::unordered_map<std::string, size_t> slots;
+};
+
+// A file read with positioned reads, which stay safe when a writer
+// truncates or replaces it (a memory mapping faults with SIGBUS on pages
+// past a new end of file)
+class DataFile {
+public:
+    DataFile() = default;
+    DataFile(const DataFile &) = delete;
+    DataFile &operator=(const DataFile &) = delete;
+    ~DataFile() { close(); }
+
+    bool open(const char *path) {
+        close();
+        name = path;
+#ifdef _WIN32
+        file = openHandle(path);
+        return file != INVALID_HANDLE_VALUE;
+#else
+        fd = ::open(path, O_RDONLY);
+        return fd >= 0;
+#endif
+    }
+
+    // Whether the path now names another file than the one open (replaced
+    // by writing a new file and renaming it over the old one); if so the
+    // new file is opened
+    bool reopenIfReplaced() {
+#ifdef _WIN32
+        HANDLE current = openHandle(name.c_str());
+        if (current == INVALID_HANDLE_VALUE) return false; // Mid-rename: keep the old one for now
+        BY_HANDLE_FILE_INFORMATION a, b;
+        bool same = GetFileInformationByHandle(file, &a) && GetFileInformationByHandle(current, &b) &&
+                    a.dwVolumeSerialNumber == b.dwVolumeSerialNumber && a.nFileIndexHigh == b.nFileIndexHigh &&
+                    a.nFileIndexLow == b.nFileIndexLow;
+        if (same) {
+            CloseHandle(current);
+            return false;
+        }
+        CloseHandle(file);
+        file = current;
+        return true;
+#else
+        struct stat opened, named;
+        if (fd < 0 || fstat(fd, &opened) != 0 || stat(name.c_str(), &named) != 0) return false;
+        if (opened.st_dev == named.st_dev && opened.st_ino == named.st_ino) return false;
+        int replacement = ::open(name.c_str(), O_RDONLY);
+        if (replacement < 0) return false;
+        ::close(fd);
+        fd = replacement;
+        return true;
+#endif
+    }
+
+    // Size of the file now; false when it cannot be read
+    bool size(size_t &bytes) const {
+#ifdef _WIN32
+        LARGE_INTEGER size;
+        if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &size)) return false;
+        bytes = size_t(size.QuadPart);
+#else
+        struct stat info;
+        if (fd < 0 || fstat(fd, &info) != 0) return false;
+        bytes = size_t(info.st_size);
+#endif
+        return true;
+    }
+
+    // Bytes offset..offset + count into out; false if they are not all there
+    bool read(size_t offset, size_t count, std::string &out) const {
+        out.resize(count);
+        size_t done = 0;
+        while (done < count) {
+#ifdef _WIN32
+            OVERLAPPED at = {};
+            at.Offset = DWORD(uint64_t(offset + done));
+            at.OffsetHigh = DWORD(uint64_t(offset + done) >> 32);
+            DWORD chunk = DWORD(count - done > 0x40000000 ? 0x40000000 : count - done), got = 0;
+            if (!ReadFile(file, &out[done], chunk, &got, &at) || got == 0) break;
+#else
+            ssize_t got = pread(fd, &out[done], count - done, off_t(offset + done));
+            if (got <= 0) break;
+#endif
+            done += size_t(got);
+        }
+        out.resize(done);
+        return done == count;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+#endif
+    }
+
+private:
+    std::string name;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+
+    static HANDLE openHandle(const char *path) {
+        return CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    }
+#else
+    int fd = -1;
+#endif
+};
+
+// Chart data file read as it grows
+class PieDataStream {
+public:
+    bool open(const char *path) {
+        consumed = seen = 0;
+        format = UNKNOWN;
+        provisional.clear();
+        last.clear();
+        if (!file.open(path) || !file.size(seen)) return false; // seen: so the first poll takes an unfinished last line
+        return true;
+    }
+
+    // Apply the records added to the file since the last call to series.
+    // Returns whether anything in series changed.
+    bool poll(PieSeries &series) {
+        bool changed = false;
+        if (file.reopenIfReplaced()) changed |= restart(series);
+        size_t size;
+        if (!file.size(size)) return changed;
+        const bool settled = size == seen; // Not grown since the last poll
+        seen = size;
+
+        // Read again the last bytes already taken: if they differ, the file
+        // was rewritten in place rather than appended to
+        size_t base = consumed - last.size();
+        if (size < consumed || !file.read(base, size - base, window) || window.compare(0, last.size(), last) != 0) {
+            changed |= restart(series);
+            base = 0;
+            if (!file.read(0, size, window)) return changed;
+        }
+        const char *data = window.data();
+        if (format == UNKNOWN) {
+            if (size == 0) return changed;
+            const size_t n = size < 4 ? size : 4;
+            const bool magic = std::memcmp(data, "PIE1", n) == 0;
+            if (magic && n < 4 && !settled) return changed; // Maybe binary, header not all written yet
+            format = magic && n == 4 ? BINARY : CSV;
+            if (format == BINARY) consumed = 4;
+        }
+        changed |= format == BINARY ? readBinary(data, base, size, series) : readCsv(data, base, size, settled, series);
+        const size_t keep = consumed - base < CHECKED_BYTES ? consumed - base : CHECKED_BYTES;
+        last.assign(data + (consumed - base) - keep, keep);
+        return changed;
+    }
+
+private:
+    enum Format { UNKNOWN, CSV, BINARY };
+
+    static const size_t CHECKED_BYTES = 32; // Read again on every poll to notice a rewrite
+
+    DataFile file;
+    Format format = UNKNOWN;
+    size_t consumed = 0;     // Bytes taken so far
+    size_t seen = 0;         // File size at the last poll
+    std::string last;        // The last bytes taken, up to CHECKED_BYTES
+    std::string window;      // Bytes read by the current poll
+    std::string provisional; // Unfinished last CSV line already applied
+
+    bool restart(PieSeries &series) {
+        series.clear();
+        consumed = 0;
+        format = UNKNOWN;
+        last.clear();
+        provisional.clear();
+        return true;
+    }
+
+    // data holds the file from offset base to size
+
+    bool readBinary(const char *data, size_t base, size_t size, PieSeries &series) {
+        bool changed = false;
+        while (consumed < size) {
+            const size_t labelLength = uint8_t(data[consumed - base]);
+            if (size - consumed < 1 + labelLength + 4) break; // Record not all written yet
+            const char *label = data + (consumed - base) + 1;
+            const unsigned char *v = reinterpret_cast<const unsigned char *>(label + labelLength);
+            uint32_t bits = uint32_t(v[0]) | uint32_t(v[1]) << 8 | uint32_t(v[2]) << 16 | uint32_t(v[3]) << 24;
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            series.set(std::string(label, labelLength), value);
+            consumed += 1 + labelLength + 4;
+            changed = true;
+        }
+        return changed;
+    }
+
+    bool readCsv(const char *data, size_t base, size_t size, bool settled, PieSeries &series) {
+        bool changed = false;
+        while (consumed < size) {
+            const char *line = data + (consumed - base);
+            const char *newline = static_cast<const char *>(std::memchr(line, '\n', size - consumed));
+            if (!newline) {
+                // Unfinished last line: apply it once the file has settled,
+                // but read it again from its start when it grows
+                std::string tail(line, data + (size - base));
+                if (settled && tail != provisional) {
+                    provisional = tail;
+                    changed |= readCsvLine(tail.data(), tail.data() + tail.size(), series);
+                }
+                break;
+            }
+            changed |= readCsvLine(line, newline, series);
+            consumed = base + size_t(newline - data) + 1;
+            provisional.clear();
+        }
+        return changed;
+    }
+
+    // One "label,value" line; false if it is not a record
+    static bool readCsvLine(const char *begin, const char *end, PieSeries &series) {
+        while (end > begin && (end[-1] == '\r' || end[-1] == ' ' || end[-1] == '\t')) end--;
+        while (begin < end && (*begin == ' ' || *begin == '\t')) begin++;
+        if (begin == end || *begin == '#') return false;
+        const char *comma = end;
+        while (comma > begin && comma[-1] != ',') comma--;
+        if (comma == begin) return false;
+
+        char number[64];
+        const char *field = comma;
+        while (field < end && (*field == ' ' || *field == '\t')) field++;
+        const size_t length = size_t(end - field);
+        if (length == 0 || length >= sizeof(number)) return false;
+        std::memcpy(number, field, length);
+        number[length] = '\0';
+        char *parsed;
+        const float value = std::strtof(number, &parsed);
+        if (parsed != number + length) return false; // Not a number: a header
+
+        const char *labelEnd = comma - 1;
+        while (labelEnd > begin && (labelEnd[-1] == ' ' || labelEnd[-1] == '\t')) labelEnd--;
+        if (labelEnd - begin >= 2 && *begin == '"' && labelEnd[-1] == '"') {
+            begin++;
+            labelEnd--;
+        }
+        series.set(std::string(begin, labelEnd), value);
+        return true;
+    }
+};
@@ -0,0 +1,250 @@
+// PieGeometry.h
+//
+// Vertices and indices of a pie or donut chart, ready for one indexed
+// vertex buffer (see PieChartRenderer.h). Slices are filled with
+// triangles in their own color; the separators between slices and the rim
+// are line segments in the line color. The arcs come from the level of
+// detail tables of ArcTessellation.h.
+//
+// The geometry of a chart is laid out slice by slice and padded to a fixed
+// capacity that depends only on the number of slices and the level, so new
+// values fit in place: a renderer can overwrite the chart's range of the
+// buffer instead of laying the whole buffer out again. Padding indices
+// repeat the first vertex and draw nothing. For the same reason a change
+// to one value can be laid out from that slice on (updatePieGeometry).
+
+#pragma once
+
+#include "../CAT1 OpenGl/ArcTessellation.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct PieVertex {
+    float x, y;
+    uint8_t color[4];
+};
+
+struct PieChart {
+    float cx = 0.0f, cy = 0.0f, radius = 0.5f;
+    float holeRadius = 0.0f; // > 0 for a donut
+    double startAngle = 0.0; // Where the first slice starts, radians counter-clockwise from +x
+    double fullTurn = 0.0;   // Value shown as a whole circle; 0 for the sum of the values
+    std::vector<float> values;
+    std::vector<std::array<float, 3>> colors; // Slice colors, repeated when there are fewer than slices
+    bool separators = true;                   // Radial lines between slices
+    bool rim = true;                          // Outline of the outer (and inner) circle
+    std::array<float, 3> lineColor = {{1.0f, 1.0f, 1.0f}};
+};
+
+// Slice i runs counter-clockwise from start to end (radians)
+struct PieSlice {
+    double start, end;
+    float fraction; // Share of a full turn, 0..1
+};
+
+// Sum of the values; negative values count as 0
+inline double pieTotal(const PieChart &chart) {
+    double total = 0.0;
+    for (float v : chart.values) total += v > 0.0f ? v : 0.0f;
+    return total;
+}
+
+// Value of a whole circle for values that add up to total
+inline double pieTurn(const PieChart &chart, double total) { return chart.fullTurn > 0.0 ? chart.fullTurn : total; }
+
+// Angles of slices first onward for values that add up to total; each
+// starts where the previous one ends, so the slices before first are kept
+// as they are. Negative values count as 0, a chart with nothing in it has
+// empty slices, and no slice goes past a full turn.
+inline void pieSlicesFrom(const PieChart &chart, double total, size_t first, std::vector<PieSlice> &slices) {
+    const double turn = pieTurn(chart, total), last = chart.startAngle + 2.0 * 3.14159265358979323846;
+    slices.resize(chart.values.size());
+    double angle = first == 0 ? chart.startAngle : slices[first - 1].end;
+    for (size_t i = first; i < chart.values.size(); i++) {
+        double share = (turn > 0.0 && chart.values[i] > 0.0f) ? chart.values[i] / turn : 0.0;
+        slices[i].start = angle;
+        angle += 2.0 * 3.14159265358979323846 * share;
+        if (angle > last) angle = last;
+        slices[i].end = angle;
+        slices[i].fraction = float(share);
+    }
+}
+
+// Angles of every slice
+inline void pieSlices(const PieChart &chart, std::vector<PieSlice> &slices) {
+    pieSlicesFrom(chart, pieTotal(chart), 0, slices);
+}
+
+// Where each slice's part of the geometry starts
+struct PieSliceRange {
+    uint32_t firstVertex, firstFill, firstLine;
+};
+
+struct PieGeometry {
+    int level = ARC_MIN_LEVEL;
+    double turn = 0.0; // Value of a full turn the slices were laid out for
+    std::vector<PieSlice> slices;
+    std::vector<PieSliceRange> ranges;
+    std::vector<PieVertex> vertices; // Always vertexCapacity long
+    std::vector<uint32_t> fill;      // Triangles, always fillCapacity long; indices into vertices
+    std::vector<uint32_t> lines;     // Line segments, always lineCapacity long
+    size_t usedVertices = 0, usedFill = 0, usedLines = 0;
+
+    // Fixed sizes for a chart of slices slices at level. The table points
+    // inside the slices number at most 2^level in all; each slice adds its
+    // two ends.
+    static size_t arcPointCapacity(size_t slices, int level) { return (size_t(1) << level) + 2 * slices; }
+
+    static size_t vertexCapacity(size_t slices, int level, bool donut) {
+        size_t arc = arcPointCapacity(slices, level);
+        size_t fillVertices = donut ? 2 * arc : arc + slices;
+        return fillVertices + 2 * slices + (donut ? 2 * arc : arc); // Fill, separators, rim
+    }
+
+    static size_t fillCapacity(size_t slices, int level, bool donut) {
+        return (donut ? 6 : 3) * arcPointCapacity(slices, level);
+    }
+
+    static size_t lineCapacity(size_t slices, int level, bool donut) {
+        return 2 * slices + (donut ? 4 : 2) * arcPointCapacity(slices, level);
+    }
+};
+
+inline PieVertex pieVertex(float x, float y, const std::array<float, 3> &rgb) {
+    PieVertex v = {x, y, {0, 0, 0, 255}};
+    for (int k = 0; k < 3; k++) {
+        float c = rgb[k] < 0.0f ? 0.0f : (rgb[k] > 1.0f ? 1.0f : rgb[k]);
+        v.color[k] = uint8_t(c * 255.0f + 0.5f);
+    }
+    return v;
+}
+
+// Geometry of slice i at the end of what is in g so far
+inline void appendPieSlice(const PieChart &chart, size_t i, PieGeometry &g, std::vector<float> &outer,
+                           std::vector<float> &inner) {
+    static const std::array<float, 3> grey = {{0.5f, 0.5f, 0.5f}};
+    const PieSlice &s = g.slices[i];
+    const std::array<float, 3> &color = chart.colors.empty() ? grey : chart.colors[i % chart.colors.size()];
+    const bool donut = chart.holeRadius > 0.0f;
+    g.ranges[i] = {uint32_t(g.usedVertices), uint32_t(g.usedFill), uint32_t(g.usedLines)};
+
+    outer.clear();
+    size_t n = tessellateArc(chart.cx, chart.cy, chart.radius, s.start, s.end, g.level, outer);
+    if (donut) {
+        inner.clear();
+        tessellateArc(chart.cx, chart.cy, chart.holeRadius, s.start, s.end, g.level, inner);
+    }
+    auto addVertex = [&](float x, float y, const std::array<float, 3> &rgb) {
+        g.vertices[g.usedVertices] = pieVertex(x, y, rgb);
+        return uint32_t(g.usedVertices++);
+    };
+
+    // Fill: a fan from the centre, or a band between the two arcs
+    uint32_t centre = 0, firstOuter, firstInner = 0;
+    if (!donut) centre = addVertex(chart.cx, chart.cy, color);
+    firstOuter = uint32_t(g.usedVertices);
+    for (size_t k = 0; k < n; k++) addVertex(outer[2 * k], outer[2 * k + 1], color);
+    if (donut) {
+        firstInner = uint32_t(g.usedVertices);
+        for (size_t k = 0; k < n; k++) addVertex(inner[2 * k], inner[2 * k + 1], color);
+    }
+    for (uint32_t k = 0; k + 1 < n; k++) {
+        uint32_t *t = &g.fill[g.usedFill];
+        if (donut) {
+            uint32_t o = firstOuter + k, in = firstInner + k;
+            uint32_t quad[6] = {o, o + 1, in + 1, o, in + 1, in};
+            for (int j = 0; j < 6; j++) t[j] = quad[j];
+            g.usedFill += 6;
+        }
+        else {
+            t[0] = centre;
+            t[1] = firstOuter + k;
+            t[2] = firstOuter + k + 1;
+            g.usedFill += 3;
+        }
+    }
+
+    // Lines: the separator where the slice starts, then its part of the rim
+    auto addLine = [&](uint32_t a, uint32_t b) {
+        g.lines[g.usedLines++] = a;
+        g.lines[g.usedLines++] = b;
+    };
+    auto addRim = [&](const std::vector<float> &arc) {
+        uint32_t first = uint32_t(g.usedVertices);
+        for (size_t k = 0; k < n; k++) addVertex(arc[2 * k], arc[2 * k + 1], chart.lineColor);
+        for (uint32_t k = 0; k + 1 < n; k++) addLine(first + k, first + k + 1);
+    };
+    if (chart.separators) {
+        uint32_t from = donut ? addVertex(inner[0], inner[1], chart.lineColor)
+                              : addVertex(chart.cx, chart.cy, chart.lineColor);
+        addLine(from, addVertex(outer[0], outer[1], chart.lineColor));
+    }
+    if (chart.rim) {
+        addRim(outer);
+        if (donut) addRim(inner);
+    }
+}
+
+// Lay out chart at level into g, sized to its capacity, for values that
+// add up to total
+inline void buildPieGeometry(const PieChart &chart, int level, PieGeometry &g, double total) {
+    const size_t count = chart.values.size();
+    const bool donut = chart.holeRadius > 0.0f;
+    g.level = level;
+    g.turn = pieTurn(chart, total);
+    pieSlicesFrom(chart, total, 0, g.slices);
+    g.ranges.assign(count, PieSliceRange{0, 0, 0});
+    g.vertices.assign(PieGeometry::vertexCapacity(count, level, donut), PieVertex{0.0f, 0.0f, {0, 0, 0, 0}});
+    g.fill.assign(PieGeometry::fillCapacity(count, level, donut), 0);
+    g.lines.assign(PieGeometry::lineCapacity(count, level, donut), 0);
+    g.usedVertices = g.usedFill = g.usedLines = 0;
+
+    std::vector<float> outer, inner;
+    for (size_t i = 0; i < count; i++) appendPieSlice(chart, i, g, outer, inner);
+}
+
+inline void buildPieGeometry(const PieChart &chart, int level, PieGeometry &g) {
+    buildPieGeometry(chart, level, g, pieTotal(chart));
+}
+
+// The parts of a PieGeometry's arrays an update rewrote, [first, end) of each
+struct PieGeometryChange {
+    size_t firstVertex, endVertex, firstFill, endFill, firstLine, endLine;
+};
+
+// Lay out slices first onward again after values first onward changed, in
+// place: g must have been built for chart at its level with as many slices.
+// A changed value only moves the slices after it, so the ones before first
+// are kept, unless the value of a full turn changed, which moves every
+// slice. Without fullTurn the turn is the total, so that is any change
+// that does not keep the sum. total is the caller's running sum of the
+// values; when every slice is laid out again it is summed afresh, so
+// rounding from adding and subtracting values does not pile up. Indices
+// the slices no longer use go back to padding. Gives the parts of g that
+// changed, which come out the same as building g from scratch.
+inline PieGeometryChange updatePieGeometry(const PieChart &chart, double &total, size_t first, PieGeometry &g) {
+    const size_t count = chart.values.size();
+    if (pieTurn(chart, total) != g.turn) {
+        total = pieTotal(chart);
+        if (pieTurn(chart, total) != g.turn) first = 0;
+    }
+    if (first >= count) return {0, 0, 0, 0, 0, 0};
+    g.turn = pieTurn(chart, total);
+    pieSlicesFrom(chart, total, first, g.slices);
+
+    const PieSliceRange from = g.ranges[first];
+    const size_t usedFill = g.usedFill, usedLines = g.usedLines;
+    g.usedVertices = from.firstVertex;
+    g.usedFill = from.firstFill;
+    g.usedLines = from.firstLine;
+    std::vector<float> outer, inner;
+    for (size_t i = first; i < count; i++) appendPieSlice(chart, i, g, outer, inner);
+    for (size_t k = g.usedFill; k < usedFill; k++) g.fill[k] = 0;
+    for (size_t k = g.usedLines; k < usedLines; k++) g.lines[k] = 0;
+    return {from.firstVertex, g.usedVertices,
+            from.firstFill,   usedFill > g.usedFill ? usedFill : g.usedFill,
+            from.firstLine,   usedLines > g.usedLines ? usedLines : g.usedLines};
+}
@@ -3,6 +3,7 @@
 // -----------------------------------------------------------------------------
 // The program calculates slice angles proportionally, renders them using triangle fans, and labels each slice with a white percentage and fruit name positioned slightly outside the chart circumference.
 // Radial lines divide the chart, and label positions for certain slices (like Banana and Kiwifruit) are adjusted for optimal clarity.
+// Given a CSV or binary data file (see PieData.h), the program charts its figures instead and follows updates appended to it.
 // -----------------------------------------------------------------------------
 
 /*Data
@@ -20,16 +21,20 @@
     Grapes : 16
 */
 
+#include <GL/glew.h>
 #include <GL/glut.h>
 #include <cmath>
 #include <cstdio>
 #include <string>
 
+#include "../PieChartRenderer.h"
+#include "../PieData.h"
+
 // Define window width/height
 const int WINDOW_WIDTH = 600;
 const int WINDOW_HEIGHT = 600;
 
-// Data for the pie chart
+// Data for the pie chart when no data file is given
 static float values[] = {36.0f, 41.0f, 19.0f, 28.0f, 30.0f, 16.0f};
 static const char *labels[] = {
     "Ovacado",
@@ -45,8 +50,25 @@ static const int NUM_SLICES = sizeof(values) / sizeof(values[0]);
 // The title of the pie chart
 static const char *chartTitle = "Youth Fruit Preferences in Gachororo";
 
-// PI constant
-const float PI = 3.14159265f;
+// Visible area and window size, kept up to date by reshape(). Arcs get as
+// many segments as their size on screen needs (see ArcTessellation.h).
+static OrthoView view = {-1.0, 1.0, -1.0, 1.0, WINDOW_WIDTH, WINDOW_HEIGHT};
+
+// Pie chart parameters.
+const float centerX = 0.0f;
+const float centerY = 0.0f;
+const float radius = 0.5f; // Pie radius.
+
+// The chart's slices, radial lines and outline, kept in vertex buffers and
+// only rebuilt when the data change (see PieChartRenderer.h).
+static PieChartRenderer pies;
+static size_t chartId = 0;
+
+// Labels and values shown, and the data file they come from (if any), checked
+// for new records every POLL_MS milliseconds.
+static PieSeries series;
+static PieDataStream dataFile;
+const int POLL_MS = 250;
 
 // -------------------------------------------------------------------------
 //  Function to draw text on the screen using a simple bitmap font.
@@ -73,59 +95,29 @@ void display()
     // Clear the window with the background color.
     glClear(GL_COLOR_BUFFER_BIT);
 
-    // Compute total value for percentage calculations.
-    float total = 0.0f;
-    for (int i = 0; i < NUM_SLICES; ++i)
-    {
-        total += values[i];
-    }
-
-    // Pie chart parameters.
-    float centerX = 0.0f;
-    float centerY = 0.0f;
-    float radius = 0.5f;       // Pie radius.
-    float currentAngle = 0.0f; // Starting angle in degrees.
+    // Keep the chart in step with the data (the chart has no fixed scale,
+    // so any change rebuilds every slice), then draw the black slices with
+    // their white radial lines and outline.
+    pies.setValues(chartId, series.values().data(), series.size());
+    pies.draw();
 
-    // First, draw the filled slices.
-    for (int i = 0; i < NUM_SLICES; ++i)
+    for (size_t i = 0; i < series.size(); ++i)
     {
-        // Calculate the slice angle (in degrees).
-        float slicePercentage = values[i] / total;
-        float sliceAngle = slicePercentage * 360.0f;
-
-        // Fill each slice with black for simplicity.
-        glColor3f(0.0f, 0.0f, 0.0f);
-        // Draw the pie slice using triangle fan.
-        glBegin(GL_TRIANGLE_FAN);
-        // Center of the pie.
-        glVertex2f(centerX, centerY);
-        // Draw the arc.
-        for (float angle = currentAngle; angle <= currentAngle + sliceAngle; angle += 1.0f)
-        {
-            // Convert angle to radians for OpenGL.
-            float rad = angle * PI / 180.0f;
-            // Calculate vertex position on the circle boundary.
-            glVertex2f(centerX + cos(rad) * radius, centerY + sin(rad) * radius);
-        }
-        // Ensure the last vertex reaches the exact end angle.
-        // This is important for the last slice and a workaround to ensure the last vertex reaches the exact end angle.
-        float endRad = (currentAngle + sliceAngle) * PI / 180.0f;
-        glVertex2f(centerX + cos(endRad) * radius, centerY + sin(endRad) * radius);
-        glEnd();
+        // Angles (radians) and share of this slice.
+        const PieSlice &slice = pies.slice(chartId, i);
+        float slicePercentage = slice.fraction;
 
         // Compute the midpoint angle for placing the label.
-        float midAngle = currentAngle + sliceAngle / 2.0f;
-        // Convert to radians for label positioning.
-        float midRad = midAngle * PI / 180.0f;
+        float midRad = float((slice.start + slice.end) / 2.0);
         // Calculate label position based on the midpoint angle.
         float labelRadius = radius + 0.1f;
         // Increase label distance for Banana slice due to its size.
-        if (std::string(labels[i]) == "Banana")
+        if (series.label(i) == "Banana")
         {
             labelRadius = radius + 0.42f;
         }
         // Increase label distance for Kiwifruit slice
-        if (std::string(labels[i]) == "Kiwifruit")
+        if (series.label(i) == "Kiwifruit")
         {
             labelRadius = radius + 0.20f;
         }
@@ -133,7 +125,7 @@ void display()
         float labelY = centerY + sin(midRad) * labelRadius;
 
         // Adjust KiwiFruit label position further to the left.
-        if (std::string(labels[i]) == "Kiwifruit")
+        if (series.label(i) == "Kiwifruit")
         {
             labelX -= 0.09f; // Change the value as needed to move it further left.
         }
@@ -143,50 +135,14 @@ void display()
         // Format the label string to include the percentage.
         float percentage = slicePercentage * 100.0f;
         // Use snprintf to format the string safely.
-        std::snprintf(labelString, sizeof(labelString), "%s (%.1f%%)", labels[i], percentage);
+        std::snprintf(labelString, sizeof(labelString), "%s (%.1f%%)", series.label(i).c_str(), percentage);
         // Draw the label string at the calculated position.
         glColor3f(1.0f, 1.0f, 1.0f); // White text.
         drawBitmapText(labelX, labelY, labelString);
-
-        // After filling this slice, draw the radial line (boundary) at the starting angle.
-        glColor3f(1.0f, 1.0f, 1.0f); // White line.
-        glBegin(GL_LINES);
-        float rad = currentAngle * PI / 180.0f;
-        // Draw the line from the center to the edge of the pie slice.
-        glVertex2f(centerX, centerY);
-        // Calculate the end point of the line at the edge of the pie slice.
-        glVertex2f(centerX + cos(rad) * radius, centerY + sin(rad) * radius);
-        glEnd();
-
-        // Update the current angle for the next slice.
-        currentAngle += sliceAngle;
     }
 
-    // Draw the final radial boundary at 360 degrees (or currentAngle).
-    // This is to ensure the last slice has a boundary line.
-    glColor3f(1.0f, 1.0f, 1.0f);
-    // Draw the line from the center to the edge of the pie slice.
-    glBegin(GL_LINES);
-    // Use the final angle to draw the last line.
-    float finalRad = currentAngle * PI / 180.0f;
-    glVertex2f(centerX, centerY);
-    glVertex2f(centerX + cos(finalRad) * radius, centerY + sin(finalRad) * radius);
-    glEnd();
-
-    // Draw the overall circle outline (white).
-    glColor3f(1.0f, 1.0f, 1.0f);
-    // Draw the outer circle boundary for the pie chart using a line loop.
-    glBegin(GL_LINE_LOOP);
-    for (int angle = 0; angle < 360; angle += 1)
-    {
-        // Convert angle to radians for OpenGL.
-        float rad = angle * PI / 180.0f;
-        // Calculate vertex position on the circle boundary.
-        glVertex2f(centerX + cos(rad) * radius, centerY + sin(rad) * radius);
-    }
-    glEnd();
-
     // Draw the chart title at the top.
+    glColor3f(1.0f, 1.0f, 1.0f);
     drawBitmapText(-0.3f, 0.8f, chartTitle);
 
     // Flush the OpenGL commands and swap buffers.
@@ -198,6 +154,9 @@ void display()
 // -------------------------------------------------------------------------
 void reshape(int w, int h)
 {
+    view.width = w;
+    view.height = h;
+    pies.setView(view);
     glViewport(0, 0, w, h);
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
@@ -207,6 +166,18 @@ void reshape(int w, int h)
     glLoadIdentity();
 }
 
+// -------------------------------------------------------------------------
+//  Timer callback: pick up records appended to the data file.
+// -------------------------------------------------------------------------
+void pollData(int)
+{
+    if (dataFile.poll(series))
+    {
+        glutPostRedisplay();
+    }
+    glutTimerFunc(POLL_MS, pollData, 0);
+}
+
 // -------------------------------------------------------------------------
 //  Main entry point.
 // -------------------------------------------------------------------------
@@ -214,6 +185,26 @@ int main(int argc, char **argv)
 {
     // Initialize GLUT and create a window.
     glutInit(&argc, argv);
+
+    // Read the data file named on the command line, or use the data above.
+    const bool streaming = argc > 1;
+    if (streaming)
+    {
+        if (!dataFile.open(argv[1]))
+        {
+            std::fprintf(stderr, "Cannot read %s\n", argv[1]);
+            return 1;
+        }
+        dataFile.poll(series);
+    }
+    else
+    {
+        for (int i = 0; i < NUM_SLICES; ++i)
+        {
+            series.set(labels[i], values[i]);
+        }
+    }
+
     // Initialize GLUT with double buffering and RGB color mode.
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB);
     // Set the initial window size and position.
@@ -221,12 +212,37 @@ int main(int argc, char **argv)
     glutInitWindowPosition(100, 100);
     glutCreateWindow("Fruit Consumption Pie Chart");
 
+    // Initialize GLEW for vertex buffer objects.
+    if (glewInit() != GLEW_OK)
+    {
+        std::fprintf(stderr, "Failed to initialize GLEW\n");
+        return -1;
+    }
+
+    // Build the chart once: black slices, white radial lines and outline.
+    PieChart chart;
+    chart.cx = centerX;
+    chart.cy = centerY;
+    chart.radius = radius;
+    chart.values = series.values();
+    // Slices are shares of the total, so a change to one value moves them
+    // all. Only with a fixed chart.fullTurn would a change rebuild just the
+    // slices after it; these counts have no such scale.
+    chart.colors = {{{0.0f, 0.0f, 0.0f}}};
+    chart.lineColor = {{1.0f, 1.0f, 1.0f}};
+    pies.setView(view);
+    chartId = pies.add(chart);
+
     // Set the background color to black.
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
     // Register callbacks.
     glutDisplayFunc(display);
     glutReshapeFunc(reshape);
+    if (streaming)
+    {
+        glutTimerFunc(POLL_MS, pollData, 0);
+    }
 
     glutMainLoop();
     return 0;
@@ -10,24 +10,30 @@
     - Dynamic pie slice rendering with color differentiation
     - Labeling with percentages and fruit names
     - Title display
+    - Data from a CSV or binary file given on the command line, followed
+      live as records are appended (see PieData.h)
 
     Author: Group 9
 */
+#include <GL/glew.h>
 #include <GL/glut.h>
 #include <cmath>
 #include <cstdio>
 #include <string>
 
+#include "../PieChartRenderer.h"
+#include "../PieData.h"
+
 // Window size constants
 const int WINDOW_WIDTH = 800;
 const int WINDOW_HEIGHT = 800;
 
-// Data values and labels for each fruit
+// Data values and labels for each fruit, used when no data file is given
 static float values[] = {36.0f, 41.0f, 19.0f, 28.0f, 30.0f, 16.0f};
 static const char *labels[] = {"Avocado", "Orange", "Banana", "Kiwifruit", "Mangos", "Grapes"};
 
 // RGB colors for each pie slice
-static float colors[][3] = {
+static std::vector<std::array<float, 3>> colors = {
     {0.82f, 0.81f, 0.41f},
     {0.93f, 0.55f, 0.14f},
     {1.0f, 0.87f, 0.35f},
@@ -42,8 +48,22 @@ static const int NUM_SLICES = sizeof(values) / sizeof(values[0]);
 // Chart title
 static const char *chartTitle = "Youth Fruit Preferences in Gachororo";
 
-// Pi constant
-const float PI = 3.14159265f;
+// Visible area and window size, kept up to date by reshape(); arcs get as
+// many segments as their size on screen needs (see ArcTessellation.h)
+static OrthoView view = {-1.0, 1.0, -1.0, 1.0, WINDOW_WIDTH, WINDOW_HEIGHT};
+
+// Pie position and size
+const float centerX = 0.0f, centerY = 0.0f, radius = 0.6f;
+
+// Slices and their black outlines, kept in vertex buffers and only rebuilt
+// when the data change (see PieChartRenderer.h)
+static PieChartRenderer pies;
+static size_t chartId = 0;
+
+// Labels and values shown, and the data file they come from (if any)
+static PieSeries series;
+static PieDataStream dataFile;
+static const int POLL_MS = 250;  // How often the data file is checked
 
 // Renders text at a given position
 void drawBitmapText(float x, float y, const char *string) {
@@ -58,48 +78,20 @@ void display() {
     glClear(GL_COLOR_BUFFER_BIT);   // Clear the window
     glLoadIdentity();               // Reset transformations
 
-    float total = 0.0f;
-    for (int i = 0; i < NUM_SLICES; ++i) {
-        total += values[i];         // Sum up the values
-    }
-
-    float centerX = 0.0f, centerY = 0.0f, radius = 0.6f;
-    float currentAngle = 0.0f;
-
     // Draw chart title at the top
     glColor3f(0.0f, 0.0f, 0.0f);
     drawBitmapText(-0.4f, 0.9f, chartTitle);
 
-    // Draw each slice of the pie
-    for (int i = 0; i < NUM_SLICES; ++i) {
-        float sliceAngle = 360.0f * values[i] / total;
-
-        // Set fill color and draw slice as a triangle fan
-        glColor3f(colors[i][0], colors[i][1], colors[i][2]);
-        glBegin(GL_TRIANGLE_FAN);
-        glVertex2f(centerX, centerY);  // Center of the pie
-        for (float angle = currentAngle; angle <= currentAngle + sliceAngle; angle += 1.0f) {
-            float rad = angle * PI / 180.0f;
-            glVertex2f(centerX + cos(rad) * radius, centerY + sin(rad) * radius);
-        }
-        float endRad = (currentAngle + sliceAngle) * PI / 180.0f;
-        glVertex2f(centerX + cos(endRad) * radius, centerY + sin(endRad) * radius);
-        glEnd();
+    // Draw every slice and its outline (all rebuilt when a value changes)
+    pies.setValues(chartId, series.values().data(), series.size());
+    pies.draw(1.0f);
 
-        // Draw slice outline
-        glColor3f(0.0f, 0.0f, 0.0f);
-        glLineWidth(1.0f);
-        glBegin(GL_LINE_LOOP);
-        glVertex2f(centerX, centerY);
-        for (float angle = currentAngle; angle <= currentAngle + sliceAngle; angle += 1.0f) {
-            float rad = angle * PI / 180.0f;
-            glVertex2f(centerX + cos(rad) * radius, centerY + sin(rad) * radius);
-        }
-        glEnd();
+    // Label each slice
+    for (size_t i = 0; i < series.size(); ++i) {
+        const PieSlice &slice = pies.slice(chartId, i);
 
         // Position the label around the middle of the slice
-        float midAngle = currentAngle + sliceAngle / 2.0f;
-        float midRad = midAngle * PI / 180.0f;
+        float midRad = float((slice.start + slice.end) / 2.0);
         float labelRadius = radius + 0.15f;
 
         if (i == 2) labelRadius += 0.1f;   // Slight offset for Banana
@@ -110,13 +102,11 @@ void display() {
 
         // Format label with percentage
         char labelText[50];
-        sprintf(labelText, "%s (%.1f%%)", labels[i], 100.0f * values[i] / total);
+        snprintf(labelText, sizeof labelText, "%s (%.1f%%)", series.label(i).c_str(), 100.0f * slice.fraction);
 
         // Draw label
         glColor3f(0.0f, 0.0f, 0.0f);
         drawBitmapText(labelX - 0.05f, labelY - 0.02f, labelText);
-
-        currentAngle += sliceAngle;  // Move to next slice
     }
 
     glutSwapBuffers();  // Swap buffers to display
@@ -124,6 +114,9 @@ void display() {
 
 // Adjusts viewport and coordinate system when window is resized
 void reshape(int w, int h) {
+    view.width = w;
+    view.height = h;
+    pies.setView(view);
     glViewport(0, 0, w, h);
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
@@ -131,15 +124,53 @@ void reshape(int w, int h) {
     glMatrixMode(GL_MODELVIEW);
 }
 
+// Picks up records appended to the data file
+void pollData(int) {
+    if (dataFile.poll(series)) glutPostRedisplay();
+    glutTimerFunc(POLL_MS, pollData, 0);
+}
+
 // Main program entry
 int main(int argc, char **argv) {
     glutInit(&argc, argv);                                     // Init GLUT
+
+    // Data file named on the command line, or the data above
+    const bool streaming = argc > 1;
+    if (streaming) {
+        if (!dataFile.open(argv[1])) {
+            fprintf(stderr, "Cannot read %s\n", argv[1]);
+            return 1;
+        }
+        dataFile.poll(series);
+    } else {
+        for (int i = 0; i < NUM_SLICES; ++i) series.set(labels[i], values[i]);
+    }
+
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB);               // Double buffering, RGB mode
     glutInitWindowSize(WINDOW_WIDTH, WINDOW_HEIGHT);           // Set window size
     glutCreateWindow("Fruit Preferences Pie Chart");           // Create window
+    if (glewInit() != GLEW_OK) {                               // Vertex buffer objects
+        fprintf(stderr, "Failed to initialize GLEW\n");
+        return -1;
+    }
+
+    // Build the chart once: colored slices with black outlines
+    PieChart chart;
+    chart.cx = centerX;
+    chart.cy = centerY;
+    chart.radius = radius;
+    chart.values = series.values();
+    // Shares of the total: a changed value moves every slice. Setting
+    // chart.fullTurn to a fixed scale would rebuild only the later slices.
+    chart.colors = colors;
+    chart.lineColor = {{0.0f, 0.0f, 0.0f}};
+    pies.setView(view);
+    chartId = pies.add(chart);
+
     glClearColor(1.0f, 1.0f, 1.0f, 1.0f);                       // Set background to white
     glutDisplayFunc(display);                                  // Register draw callback
     glutReshapeFunc(reshape);                                  // Register resize callback
+    if (streaming) glutTimerFunc(POLL_MS, pollData, 0);        // Follow the data file
     glutMainLoop();                                            // Enter main loop
     return 0;
 }
@@ -30,17 +30,24 @@ Banana	(1.0,1.0,0.0)	0.2991.0 + 0.5871.0 + 0.114*0.0=0.89
 Kiwifruit	(0.45,0.76,0.23)	0.2990.45 + 0.5870.76 + 0.114*0.23=0.61
 Mangos	(1.0,0.8,0.0)	0.2991.0 + 0.5870.8 + 0.114*0.0=0.77
 Grapes	(0.5,0.0,0.5)	0.2990.5 + 0.5870.0 + 0.114*0.5=0.21 
+
+Run with a CSV or binary data file (see PieData.h) to chart its figures
+instead; records appended to the file later update the chart.
 */
+#include <GL/glew.h>
 #include <GL/glut.h>
 #include <cmath>
 #include <cstdio>
 #include <string>
 
+#include "../PieChartRenderer.h"
+#include "../PieData.h"
+
 // Window dimensions
 const int WINDOW_WIDTH = 600;
 const int WINDOW_HEIGHT = 600;
 
-// Chart data configuration
+// Chart data configuration, used when no data file is given
 static float values[] = { 36.0f, 41.0f, 19.0f, 28.0f, 30.0f, 16.0f };
 static const char* labels[] = {
     "Avocado",
@@ -51,7 +58,7 @@ static const char* labels[] = {
     "Grapes" };
 
 // Grayscale colors using luminance formula: 0.299*R + 0.587*G + 0.114*B
-static float grayscaleColors[][3] = {
+static std::vector<std::array<float, 3>> grayscaleColors = {
     {0.40f, 0.40f, 0.40f},  // Avocado (dark green -> medium gray)
     {0.59f, 0.59f, 0.59f},  // Orange (orange -> light gray)
     {0.89f, 0.89f, 0.89f},  // Banana (yellow -> near white)
@@ -62,7 +69,24 @@ static float grayscaleColors[][3] = {
 
 const int NUM_SLICES = sizeof(values) / sizeof(values[0]);
 const char *chartTitle = "Youth Fruit Preferences in Gachororo";
-const float PI = 3.14159265f;
+
+// Visible area and window size, kept up to date by reshape(); arcs get as
+// many segments as their size on screen needs (see ArcTessellation.h)
+OrthoView view = { -1.0, 1.0, -1.0, 1.0, WINDOW_WIDTH, WINDOW_HEIGHT };
+
+// Pie chart configuration
+const float centerX = 0.0f, centerY = 0.0f;
+const float radius = 0.5f;  // Chart radius (relative to [-1,1] coordinate system)
+
+// Slices, separation lines and boundary circle, kept in vertex buffers and
+// only rebuilt when the data change (see PieChartRenderer.h)
+PieChartRenderer pies;
+size_t chartId = 0;
+
+// Labels and values shown, and the data file they come from (if any)
+PieSeries series;
+PieDataStream dataFile;
+const int POLL_MS = 250;  // How often the data file is checked
 
 // Text drawing function
 void drawBitmapText(float x, float y, const char* string) {
@@ -78,46 +102,25 @@ void display() {
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
 
-    // Calculate total value for percentage calculations
-    float total = 0.0f;
-    for (int i = 0; i < NUM_SLICES; ++i) total += values[i];
-
-    // Pie chart configuration
-    const float centerX = 0.0f, centerY = 0.0f;
-    const float radius = 0.5f;  // Chart radius (relative to [-1,1] coordinate system)
-    float currentAngle = 0.0f;   // Starting angle for first slice
-
-    // Draw each pie slice
-    for (int i = 0; i < NUM_SLICES; ++i) {
-        // Calculate slice dimensions
-        const float slicePercentage = values[i] / total;
-        const float sliceAngle = slicePercentage * 360.0f;
-
-        // Set grayscale color for this slice
-        glColor3fv(grayscaleColors[i]);
-
-        // Draw slice using triangle fan primitive
-        glBegin(GL_TRIANGLE_FAN);
-        glVertex2f(centerX, centerY);  // Center point
-        for (float angle = currentAngle; angle <= currentAngle + sliceAngle; angle += 1.0f) {
-            const float rad = angle * PI / 180.0f;
-            glVertex2f(centerX + cos(rad) * radius, centerY + sin(rad) * radius);
-        }
-        // Final vertex to ensure complete coverage
-        const float endRad = (currentAngle + sliceAngle) * PI / 180.0f;
-        glVertex2f(centerX + cos(endRad) * radius, centerY + sin(endRad) * radius);
-        glEnd();
+    // Draw the grayscale slices, white separation lines and boundary circle
+    // (all rebuilt when a value changes: they are shares of the total)
+    pies.setValues(chartId, series.values().data(), series.size());
+    pies.draw();
+
+    // Label each slice
+    for (size_t i = 0; i < series.size(); ++i) {
+        const PieSlice& slice = pies.slice(chartId, i);
+        const float slicePercentage = slice.fraction;
 
         // Label positioning calculations -------------------------------
-        const float midAngle = currentAngle + sliceAngle / 2.0f;
-        float midRad = midAngle * PI / 180.0f;
+        float midRad = float((slice.start + slice.end) / 2.0);
         float labelRadius = radius + 0.1f;  // Default label distance
 
         // Special positioning for crowded sections
-        if (std::string(labels[i]) == "Banana") {
+        if (series.label(i) == "Banana") {
             labelRadius = radius + 0.42f;  // Move label further out
         }
-        else if (std::string(labels[i]) == "Kiwifruit") {
+        else if (series.label(i) == "Kiwifruit") {
             labelRadius = radius + 0.20f;
             midRad += 0.05f;  // Angular adjustment for better placement
         }
@@ -128,31 +131,12 @@ void display() {
 
         // Create label text with percentage
         char labelString[64];
-        std::snprintf(labelString, sizeof(labelString), "%s (%.1f%%)", labels[i], slicePercentage * 100.0f);
+        std::snprintf(labelString, sizeof(labelString), "%s (%.1f%%)", series.label(i).c_str(), slicePercentage * 100.0f);
 
         // Draw white text label
         glColor3f(1.0f, 1.0f, 1.0f);
         drawBitmapText(labelX, labelY, labelString);
-
-        // Draw white separation lines between slices
-        glColor3f(1.0f, 1.0f, 1.0f);
-        glBegin(GL_LINES);
-        const float startRad = currentAngle * PI / 180.0f;
-        glVertex2f(centerX, centerY);
-        glVertex2f(centerX + cos(startRad) * radius, centerY + sin(startRad) * radius);
-        glEnd();
-
-        currentAngle += sliceAngle;
-    }
-
-    // Draw outer boundary circle
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glBegin(GL_LINE_LOOP);
-    for (int angle = 0; angle < 360; ++angle) {
-        const float rad = angle * PI / 180.0f;
-        glVertex2f(centerX + cos(rad) * radius, centerY + sin(rad) * radius);
     }
-    glEnd();
 
     // Draw chart title in white
     glColor3f(1.0f, 1.0f, 1.0f);
@@ -163,6 +147,9 @@ void display() {
 
 // Window resize handler
 void reshape(int width, int height) {
+    view.width = width;
+    view.height = height;
+    pies.setView(view);
     glViewport(0, 0, width, height);
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
@@ -170,20 +157,60 @@ void reshape(int width, int height) {
     glMatrixMode(GL_MODELVIEW);
 }
 
+// Data file timer: pick up appended records
+void pollData(int) {
+    if (dataFile.poll(series)) glutPostRedisplay();
+    glutTimerFunc(POLL_MS, pollData, 0);
+}
+
 // Application entry point
 int main(int argc, char** argv) {
     // GLUT initialization
     glutInit(&argc, argv);
+
+    // Chart data: the file named on the command line, or the built-in figures
+    const bool streaming = argc > 1;
+    if (streaming) {
+        if (!dataFile.open(argv[1])) {
+            std::fprintf(stderr, "Cannot read %s\n", argv[1]);
+            return 1;
+        }
+        dataFile.poll(series);
+    }
+    else {
+        for (int i = 0; i < NUM_SLICES; ++i) series.set(labels[i], values[i]);
+    }
+
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB);
     glutInitWindowSize(WINDOW_WIDTH, WINDOW_HEIGHT);
     glutCreateWindow("Grayscale Fruit Consumption Chart");
 
+    // GLEW for vertex buffer objects
+    if (glewInit() != GLEW_OK) {
+        std::fprintf(stderr, "Failed to initialize GLEW\n");
+        return -1;
+    }
+
+    // Build the chart once: grayscale slices, white lines
+    PieChart chart;
+    chart.cx = centerX;
+    chart.cy = centerY;
+    chart.radius = radius;
+    chart.values = series.values();
+    // No chart.fullTurn: the slices are shares of the total, so a changed
+    // value rebuilds them all rather than only the ones after it.
+    chart.colors = grayscaleColors;
+    chart.lineColor = {{1.0f, 1.0f, 1.0f}};
+    pies.setView(view);
+    chartId = pies.add(chart);
+
     // Set initial clear color (black background)
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
     // Register callbacks
     glutDisplayFunc(display);
     glutReshapeFunc(reshape);
+    if (streaming) glutTimerFunc(POLL_MS, pollData, 0);
 
     // Start main event loop
     glutMainLoop();
@@ -0,0 +1,131 @@
+// BresenhamBatch.h
+//
+// Batched Bresenham rasterization with run-length output.
+// Instead of one call per pixel, each segment is walked once with the same
+// error term as rasterLineBresenham() and every straight run of pixels is
+// reported as a single span: horizontal runs for x-major segments, vertical
+// runs for y-major ones. The spans cover exactly the pixels the per-pixel
+// kernel would plot. The ...Clipped forms start at the first visible pixel
+// and trim the runs to a ClipRect (see LineClip.h).
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+
+#include "LineClip.h"
+
+struct LineSegment {
+    int x1, y1; // Start point
+    int x2, y2; // End point
+};
+
+struct LineSpan {
+    int x, y;      // First pixel of the run, in drawing order
+    int length;    // Number of pixels in the run
+    int dir;       // +1 or -1: direction of the run along its axis
+    bool vertical; // true: run steps in y, false: run steps in x
+
+    int lastX() const { return vertical ? x : x + dir * (length - 1); }
+    int lastY() const { return vertical ? y + dir * (length - 1) : y; }
+};
+
+// Walk the part of one segment inside clip and call emit(const LineSpan &)
+// for every run, in order
+template <class Emit>
+void bresenhamRunsClipped(const LineSegment &s, const ClipRect &clip, Emit &&emit) {
+    LineSteps v;
+    if (!visibleLineSteps(s.x1, s.y1, s.x2, s.y2, clip, v)) return;
+    long long dx = v.dx, dy = v.dy;
+    int sx = v.sx, sy = v.sy;
+    bool vertical = !v.xMajor;
+
+    // Seek to step kFrom with the error term rasterLineBresenhamClipped() uses
+    int x, y;
+    long long err;
+    if (v.xMajor) {
+        x = int(s.x1 + sx * v.kFrom);
+        y = int(s.y1 + sy * v.m);
+        err = dx - dy - v.kFrom * dy + v.m * dx;
+    }
+    else {
+        y = int(s.y1 + sy * v.kFrom);
+        x = int(s.x1 + sx * v.m);
+        err = dx - dy + v.kFrom * dx - v.m * dy;
+    }
+
+    LineSpan run = {x, y, 1, vertical ? sy : sx, vertical};
+    for (long long k = v.kFrom; k < v.kTo; k++) {
+        long long e2 = 2 * err;
+        bool stepX = e2 > -dy;
+        bool stepY = e2 < dx;
+        if (stepX) {
+            err -= dy;
+            x += sx;
+        }
+        if (stepY) {
+            err += dx;
+            y += sy;
+        }
+
+        // A step along the minor axis ends the current run
+        if (vertical ? stepX : stepY) {
+            emit(run);
+            run.x = x;
+            run.y = y;
+            run.length = 1;
+        }
+        else {
+            run.length++;
+        }
+    }
+    emit(run);
+}
+
+// Walk one segment and call emit(const LineSpan &) for every run, in order
+template <class Emit>
+void bresenhamRuns(const LineSegment &s, Emit &&emit) {
+    bresenhamRunsClipped(s, ClipRect::unbounded(), emit);
+}
+
+// Rasterize count segments, appending their spans. Returns the number of spans added.
+inline size_t rasterLinesBresenhamSpans(const LineSegment *segments, size_t count, std::vector<LineSpan> &spans) {
+    size_t before = spans.size();
+    for (size_t i = 0; i < count; i++) {
+        bresenhamRuns(segments[i], [&spans](const LineSpan &run) { spans.push_back(run); });
+    }
+    return spans.size() - before;
+}
+
+// Rasterize count segments, appending the spans of their parts inside clip.
+// Returns the number of spans added.
+inline size_t rasterLinesBresenhamSpans(const LineSegment *segments, size_t count, const ClipRect &clip,
+                                        std::vector<LineSpan> &spans) {
+    size_t before = spans.size();
+    for (size_t i = 0; i < count; i++) {
+        bresenhamRunsClipped(segments[i], clip, [&spans](const LineSpan &run) { spans.push_back(run); });
+    }
+    return spans.size() - before;
+}
+
+// Write one span into a target that provides fillRow() and fillColumn()
+template <class Target>
+void fillLineSpan(const LineSpan &span, Target &target) {
+    if (span.vertical) target.fillColumn(span.x, span.y, span.lastY());
+    else target.fillRow(span.x, span.lastX(), span.y);
+}
+
+// Write previously generated spans into a target
+template <class Target>
+void drawLineSpans(const LineSpan *spans, size_t count, Target &target) {
+    for (size_t i = 0; i < count; i++) fillLineSpan(spans[i], target);
+}
+
+// Rasterize count segments straight into a target, one fill per run
+template <class Target>
+void rasterLinesBresenham(const LineSegment *segments, size_t count, Target &target) {
+    for (size_t i = 0; i < count; i++) {
+        bresenhamRuns(segments[i], [&target](const LineSpan &run) { fillLineSpan(run, target); });
+    }
+}
@@ -2,37 +2,30 @@
 #include <iostream>
 #include <cmath>
 #include <string>
+#include "GLRasterTarget.h"
+#include "LineKernels.h"
 
-// Function to implement the DDA Line Drawing Algorithm
-void drawLineDDA(int x1, int y1, int x2, int y2) {
-    float dx = x2 - x1;
-    float dy = y2 - y1;
-    float steps = std::max(abs(dx), abs(dy)); // Determine the number of steps
-    float xInc = dx / steps; // Increment in x for each step
-    float yInc = dy / steps; // Increment in y for each step
+// Pixels visible through the gluOrtho2D() projection set in init(); the
+// kernels skip everything outside it
+const ClipRect VIEWPORT = ClipRect::fromOrtho(-20, 20, -20, 20);
 
-    float x = x1, y = y1;
+// Function to implement the DDA Line Drawing Algorithm (kernel in LineKernels.h)
+void drawLineDDA(int x1, int y1, int x2, int y2) {
     std::cout << "Calculated Points:\n";
 
     glColor3f(1.0, 1.0, 1.0); // Set line color to white
     glPointSize(5.0); // Enlarge the plotted points
+
+    GLVertexTarget points;
     glBegin(GL_POINTS);
-    for (int i = 0; i <= steps; i++) {
-        std::cout << "(" << round(x) << ", " << round(y) << ")\n";
-        glVertex2i(round(x), round(y)); // Plot the pixel
-        x += xInc;
-        y += yInc;
-    }
+    rasterLineDDAClipped(x1, y1, x2, y2, VIEWPORT, points);
     glEnd();
 
     // Draw a line connecting the points
+    GLVertexTarget strip;
+    strip.echo = false;
     glBegin(GL_LINE_STRIP);
-    x = x1, y = y1;
-    for (int i = 0; i <= steps; i++) {
-        glVertex2i(round(x), round(y));
-        x += xInc;
-        y += yInc;
-    }
+    rasterLineDDAClipped(x1, y1, x2, y2, VIEWPORT, strip);
     glEnd();
 
     glFlush();
@@ -0,0 +1,169 @@
+// DDASimd.h
+//
+// DDA for many independent segments at once.
+// The segments are kept in structure-of-arrays form and stepped 8 at a time
+// with AVX2, 4 at a time with SSE4.1, or one at a time otherwise. The code
+// path is picked at compile time (-mavx2 / -msse4.1). Every lane performs
+// the same float operations as rasterLineDDA() in LineKernels.h, in the same
+// order, so each segment produces bit-identical pixels on every path; only
+// the order in which pixels of different segments reach the target differs.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "BresenhamBatch.h" // LineSegment
+#include "LineKernels.h"
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+// Segments in structure-of-arrays layout: lane i of a SIMD group reads x1[i], y1[i], ...
+struct LineSegmentsSoA {
+    std::vector<int> x1, y1, x2, y2;
+
+    size_t size() const { return x1.size(); }
+
+    void reserve(size_t n) {
+        x1.reserve(n);
+        y1.reserve(n);
+        x2.reserve(n);
+        y2.reserve(n);
+    }
+
+    void push_back(const LineSegment &s) {
+        x1.push_back(s.x1);
+        y1.push_back(s.y1);
+        x2.push_back(s.x2);
+        y2.push_back(s.y2);
+    }
+};
+
+#if defined(__AVX2__)
+
+// std::round() for 8 floats: round half away from zero.
+// x - trunc(x) is exact, so the tie test matches the scalar library call.
+inline __m256 ddaRound8(__m256 v) {
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    __m256 t = _mm256_round_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __m256 frac = _mm256_andnot_ps(signMask, _mm256_sub_ps(v, t));
+    __m256 up = _mm256_cmp_ps(frac, _mm256_set1_ps(0.5f), _CMP_GE_OQ);
+    __m256 one = _mm256_or_ps(_mm256_set1_ps(1.0f), _mm256_and_ps(v, signMask));
+    return _mm256_add_ps(t, _mm256_and_ps(up, one));
+}
+
+// Step lines [first, first + 8) together
+template <class Target>
+void rasterLinesDDA8(const LineSegmentsSoA &lines, size_t first, Target &target) {
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    __m256i ix1 = _mm256_loadu_si256((const __m256i *)&lines.x1[first]);
+    __m256i iy1 = _mm256_loadu_si256((const __m256i *)&lines.y1[first]);
+    __m256i ix2 = _mm256_loadu_si256((const __m256i *)&lines.x2[first]);
+    __m256i iy2 = _mm256_loadu_si256((const __m256i *)&lines.y2[first]);
+
+    __m256 dx = _mm256_cvtepi32_ps(_mm256_sub_epi32(ix2, ix1));
+    __m256 dy = _mm256_cvtepi32_ps(_mm256_sub_epi32(iy2, iy1));
+    __m256 steps = _mm256_max_ps(_mm256_andnot_ps(signMask, dx), _mm256_andnot_ps(signMask, dy));
+
+    // Zero-length lanes plot their start point once; keep their increments finite
+    __m256 degenerate = _mm256_cmp_ps(steps, _mm256_setzero_ps(), _CMP_EQ_OQ);
+    __m256 divisor = _mm256_blendv_ps(steps, _mm256_set1_ps(1.0f), degenerate);
+    __m256 xInc = _mm256_div_ps(dx, divisor);
+    __m256 yInc = _mm256_div_ps(dy, divisor);
+
+    __m256 x = _mm256_cvtepi32_ps(ix1);
+    __m256 y = _mm256_cvtepi32_ps(iy1);
+
+    alignas(32) float laneSteps[8];
+    _mm256_store_ps(laneSteps, steps);
+    float maxSteps = 0.0f;
+    for (int k = 0; k < 8; k++) maxSteps = std::max(maxSteps, laneSteps[k]);
+
+    alignas(32) int px[8], py[8];
+    for (int i = 0; i <= maxSteps; i++) {
+        _mm256_store_si256((__m256i *)px, _mm256_cvttps_epi32(ddaRound8(x)));
+        _mm256_store_si256((__m256i *)py, _mm256_cvttps_epi32(ddaRound8(y)));
+        for (int k = 0; k < 8; k++) {
+            if (i <= laneSteps[k]) target.plot(px[k], py[k]);
+        }
+        x = _mm256_add_ps(x, xInc);
+        y = _mm256_add_ps(y, yInc);
+    }
+}
+
+#elif defined(__SSE4_1__)
+
+// std::round() for 4 floats: round half away from zero
+inline __m128 ddaRound4(__m128 v) {
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128 t = _mm_round_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __m128 frac = _mm_andnot_ps(signMask, _mm_sub_ps(v, t));
+    __m128 up = _mm_cmpge_ps(frac, _mm_set1_ps(0.5f));
+    __m128 one = _mm_or_ps(_mm_set1_ps(1.0f), _mm_and_ps(v, signMask));
+    return _mm_add_ps(t, _mm_and_ps(up, one));
+}
+
+// Step lines [first, first + 4) together
+template <class Target>
+void rasterLinesDDA4(const LineSegmentsSoA &lines, size_t first, Target &target) {
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128i ix1 = _mm_loadu_si128((const __m128i *)&lines.x1[first]);
+    __m128i iy1 = _mm_loadu_si128((const __m128i *)&lines.y1[first]);
+    __m128i ix2 = _mm_loadu_si128((const __m128i *)&lines.x2[first]);
+    __m128i iy2 = _mm_loadu_si128((const __m128i *)&lines.y2[first]);
+
+    __m128 dx = _mm_cvtepi32_ps(_mm_sub_epi32(ix2, ix1));
+    __m128 dy = _mm_cvtepi32_ps(_mm_sub_epi32(iy2, iy1));
+    __m128 steps = _mm_max_ps(_mm_andnot_ps(signMask, dx), _mm_andnot_ps(signMask, dy));
+
+    // Zero-length lanes plot their start point once; keep their increments finite
+    __m128 degenerate = _mm_cmpeq_ps(steps, _mm_setzero_ps());
+    __m128 divisor = _mm_blendv_ps(steps, _mm_set1_ps(1.0f), degenerate);
+    __m128 xInc = _mm_div_ps(dx, divisor);
+    __m128 yInc = _mm_div_ps(dy, divisor);
+
+    __m128 x = _mm_cvtepi32_ps(ix1);
+    __m128 y = _mm_cvtepi32_ps(iy1);
+
+    alignas(16) float laneSteps[4];
+    _mm_store_ps(laneSteps, steps);
+    float maxSteps = std::max(std::max(laneSteps[0], laneSteps[1]), std::max(laneSteps[2], laneSteps[3]));
+
+    alignas(16) int px[4], py[4];
+    for (int i = 0; i <= maxSteps; i++) {
+        _mm_store_si128((__m128i *)px, _mm_cvttps_epi32(ddaRound4(x)));
+        _mm_store_si128((__m128i *)py, _mm_cvttps_epi32(ddaRound4(y)));
+        for (int k = 0; k < 4; k++) {
+            if (i <= laneSteps[k]) target.plot(px[k], py[k]);
+        }
+        x = _mm_add_ps(x, xInc);
+        y = _mm_add_ps(y, yInc);
+    }
+}
+
+#endif
+
+// Number of segments stepped together by rasterLinesDDA() in this build
+#if defined(__AVX2__)
+const int DDA_LANES = 8;
+#elif defined(__SSE4_1__)
+const int DDA_LANES = 4;
+#else
+const int DDA_LANES = 1;
+#endif
+
+// Rasterize every segment with the DDA, a lane-group at a time.
+// Leftover segments (and builds without SIMD) use the scalar kernel.
+template <class Target>
+void rasterLinesDDA(const LineSegmentsSoA &lines, Target &target) {
+    size_t n = lines.size();
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 8 <= n; i += 8) rasterLinesDDA8(lines, i, target);
+#elif defined(__SSE4_1__)
+    for (; i + 4 <= n; i += 4) rasterLinesDDA4(lines, i, target);
+#endif
+    for (; i < n; i++) rasterLineDDA(lines.x1[i], lines.y1[i], lines.x2[i], lines.y2[i], target);
+}
@@ -0,0 +1,30 @@
+// GLRasterTarget.h
+//
+// Immediate-mode OpenGL target for the kernels in LineKernels.h.
+// Every plotted pixel becomes one glVertex2i inside the glBegin/glEnd block
+// the caller has opened, and is echoed to the terminal unless echo is off.
+
+#pragma once
+
+#include <GL/glut.h>
+#include <cstdint>
+#include <iostream>
+
+struct GLVertexTarget {
+    bool echo = true; // Print the "Calculated Points" to the terminal
+
+    void plot(int x, int y) {
+        glVertex2i(x, y);
+        if (echo) std::cout << "(" << x << ", " << y << ")\n";
+    }
+
+    void plot(int x, int y, float intensity) {
+        glVertex2i(x, y);
+        if (echo) std::cout << "(" << x << ", " << y << ") Intensity: " << intensity << "\n";
+    }
+
+    // Fixed-point coverage (0..65536) from the kernels in WuFixed.h
+    void accumulate(int x, int y, uint32_t amount) {
+        plot(x, y, amount / 65536.0f);
+    }
+};
@@ -2,67 +2,26 @@
 #include <iostream>
 #include <cmath>
 #include <string>
+#include "GLRasterTarget.h"
+#include "GuptaSproull.h"
 
-// Function to plot a pixel with intensity
-void plotPixel(int x, int y, float intensity) {
-   glColor3f(1.0, 1.0, 1.0);
-   glPointSize(5.0);
-   glBegin(GL_POINTS);
-   glVertex2i(x, y);
-   glEnd();
-
-
-   std::cout << "(" << x << ", " << y << ") Intensity: " << intensity << "\n";
-}
+// Pixels visible through the gluOrtho2D() projection set in init(); the
+// kernels skip everything outside it
+const ClipRect VIEWPORT = ClipRect::fromOrtho(-10, 10, -10, 10);
 
-// Function to calculate the intensity using the Gupta-Sproull filter
-float guptaSproullIntensity(float distance, float lineWidth) {
-   float radius = lineWidth / 2.0f;
-   if (distance > radius) return 0.0f; // Outside the filter radius
-   return 1.0f - (distance / radius); // Linear falloff
-}
-
-// Function to implement the Gupta-Sproull Line Algorithm
-void drawLineGuptaSproull(int x1, int y1, int x2, int y2) {
-   int dx = abs(x2 - x1);
-   int dy = abs(y2 - y1);
-   int sx = (x1 < x2) ? 1 : -1;
-   int sy = (y1 < y2) ? 1 : -1;
-   int err = dx - dy;
-
-   float lineWidth = 2.0f; // Width of the line for anti-aliasing
+// Function to implement the Gupta-Sproull Line Algorithm (kernel in GuptaSproull.h)
+void drawLineGuptaSproull(int x1, int y1, int x2, int y2, float lineWidth = 2.0f) {
+   std::cout << "Calculated Points:\n";
 
    glColor3f(1.0, 1.0, 1.0); // Set line color to white
    glPointSize(5.0); // Enlarge the plotted points
 
-   std::cout << "Calculated Points:\n";
-
-   while (true) {
-       // Plot the main pixel
-       plotPixel(x1, y1, 1.0f);
-
-       // Anti-aliasing: Plot surrounding pixels with intensity
-       for (int i = -1; i <= 1; i++) {
-           for (int j = -1; j <= 1; j++) {
-               if (i == 0 && j == 0) continue; // Skip the main pixel
-               float distance = sqrt(i * i + j * j); // Distance from the main pixel
-               float intensity = guptaSproullIntensity(distance, lineWidth);
-               plotPixel(x1 + i, y1 + j, intensity);
-           }
-       }
+   GuptaSproullTable table(lineWidth); // Distance -> intensity for this width
 
-       if (x1 == x2 && y1 == y2) break; // Exit loop when the endpoint is reached
-
-       int e2 = 2 * err;
-       if (e2 > -dy) {
-           err -= dy;
-           x1 += sx;
-       }
-       if (e2 < dx) {
-           err += dx;
-           y1 += sy;
-       }
-   }
+   GLVertexTarget points;
+   glBegin(GL_POINTS);
+   rasterLineGuptaSproullThickClipped(x1, y1, x2, y2, table, VIEWPORT, points);
+   glEnd();
 
    glFlush();
 }
@@ -0,0 +1,153 @@
+// LineClip.h
+//
+// Clipping in front of the line kernels. A segment is first tested with
+// Cohen-Sutherland region codes, which reject it outright when both ends are
+// beyond the same edge of the viewport. What is left is trimmed analytically
+// to the steps that can be visible:
+//   - the integer kernels (Bresenham, midpoint) get the exact first and last
+//     visible step along the major axis, plus the minor position there, in
+//     closed form (visibleLineSteps);
+//   - the float DDA gets the visible part of its parameter range from
+//     Liang-Barsky (clipLiangBarsky).
+// The integer kernels then start at the first visible pixel, so a segment
+// that is mostly off-screen costs only its visible steps. The float DDA
+// (rasterLineDDAClipped) does not get that far: to land on the same pixels
+// as the unclipped line it still replays the float additions of the hidden
+// steps before the visible range, without plotting, so its cost stays
+// proportional to the hidden length. Xiaolin Wu (rasterLineXiaolinWuClipped)
+// uses neither test; it only limits its column loop to the clip range along
+// the major axis, and columns whose pixels lie above or below the viewport
+// are still computed and dropped pixel by pixel. In every case the pixels
+// drawn are exactly the unclipped pixels that fall in the viewport.
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+// Cohen-Sutherland region code bits
+const int CLIP_LEFT = 1;
+const int CLIP_RIGHT = 2;
+const int CLIP_BOTTOM = 4;
+const int CLIP_TOP = 8;
+
+// Inclusive pixel rectangle used by the clipped kernels
+struct ClipRect {
+    int xMin, yMin;
+    int xMax, yMax;
+
+    bool contains(int x, int y) const { return x >= xMin && x <= xMax && y >= yMin && y <= yMax; }
+
+    // Region code of a point: one bit for every edge it lies beyond
+    int outCode(long long x, long long y) const {
+        int code = 0;
+        if (x < xMin) code |= CLIP_LEFT;
+        else if (x > xMax) code |= CLIP_RIGHT;
+        if (y < yMin) code |= CLIP_BOTTOM;
+        else if (y > yMax) code |= CLIP_TOP;
+        return code;
+    }
+
+    // The rectangle grown by n pixels on every side, saturating at the int range
+    ClipRect grown(int n) const {
+        auto clamp = [](long long v) { return int(std::max<long long>(INT_MIN, std::min<long long>(INT_MAX, v))); };
+        return {clamp((long long)xMin - n), clamp((long long)yMin - n), clamp((long long)xMax + n), clamp((long long)yMax + n)};
+    }
+
+    // Pixels visible through gluOrtho2D(left, right, bottom, top)
+    static ClipRect fromOrtho(int left, int right, int bottom, int top) { return {left, bottom, right, top}; }
+
+    static ClipRect unbounded() { return {INT_MIN, INT_MIN, INT_MAX, INT_MAX}; }
+};
+
+// Cohen-Sutherland trivial reject: both endpoints beyond the same edge
+inline bool clipRejects(const ClipRect &clip, int x1, int y1, int x2, int y2) {
+    return (clip.outCode(x1, y1) & clip.outCode(x2, y2)) != 0;
+}
+
+// Liang-Barsky: the part t0 <= t <= t1 of P(t) = P1 + t (P2 - P1), 0 <= t <= 1,
+// that lies inside clip grown by margin. Returns false when nothing is inside.
+inline bool clipLiangBarsky(double x1, double y1, double x2, double y2, const ClipRect &clip, double margin,
+                            double &t0, double &t1) {
+    double dx = x2 - x1, dy = y2 - y1;
+    const double p[4] = {-dx, dx, -dy, dy};
+    const double q[4] = {x1 - (clip.xMin - margin), (clip.xMax + margin) - x1,
+                         y1 - (clip.yMin - margin), (clip.yMax + margin) - y1};
+    t0 = 0.0;
+    t1 = 1.0;
+    for (int i = 0; i < 4; i++) {
+        if (p[i] == 0.0) {
+            if (q[i] < 0.0) return false; // Parallel to this edge and outside it
+        }
+        else {
+            double t = q[i] / p[i];
+            if (p[i] < 0.0) t0 = std::max(t0, t); // Entering
+            else t1 = std::min(t1, t);            // Leaving
+        }
+    }
+    return t0 <= t1;
+}
+
+// Visible part of a segment for the integer kernels. The segment has major
+// steps 0..major; steps kFrom..kTo are the ones inside the rectangle, and m
+// is the number of minor steps taken before step kFrom.
+struct LineSteps {
+    bool xMajor;
+    int sx, sy;          // Direction of x and y
+    long long dx, dy;    // |x2 - x1|, |y2 - y1|
+    long long major, minor;
+    long long kFrom, kTo;
+    long long m;
+};
+
+// Find the visible steps of the line Bresenham and the midpoint algorithm draw
+// from (x1, y1) to (x2, y2). After k major steps both have taken
+// floor((2k*minor + major - 1) / (2*major)) minor steps, so the first and
+// last visible steps follow from the clip edges in closed form.
+// Returns false when no pixel of the line is inside clip.
+inline bool visibleLineSteps(int x1, int y1, int x2, int y2, const ClipRect &clip, LineSteps &steps) {
+    if (clipRejects(clip, x1, y1, x2, y2)) return false;
+
+    LineSteps &s = steps;
+    s.dx = std::abs((long long)x2 - x1);
+    s.dy = std::abs((long long)y2 - y1);
+    s.sx = (x1 < x2) ? 1 : -1;
+    s.sy = (y1 < y2) ? 1 : -1;
+    s.xMajor = s.dx >= s.dy;
+    s.major = s.xMajor ? s.dx : s.dy;
+    s.minor = s.xMajor ? s.dy : s.dx;
+
+    // Allowed range of major steps k and minor steps m, from the clip rectangle
+    auto stepRange = [](int start, int dir, int lo, int hi, long long &from, long long &to) {
+        from = dir > 0 ? (long long)lo - start : (long long)start - hi;
+        to = dir > 0 ? (long long)hi - start : (long long)start - lo;
+    };
+    long long mFrom, mTo;
+    if (s.xMajor) {
+        stepRange(x1, s.sx, clip.xMin, clip.xMax, s.kFrom, s.kTo);
+        stepRange(y1, s.sy, clip.yMin, clip.yMax, mFrom, mTo);
+    }
+    else {
+        stepRange(y1, s.sy, clip.yMin, clip.yMax, s.kFrom, s.kTo);
+        stepRange(x1, s.sx, clip.xMin, clip.xMax, mFrom, mTo);
+    }
+    s.kFrom = std::max(s.kFrom, 0LL);
+    s.kTo = std::min(s.kTo, s.major);
+    mFrom = std::max(mFrom, 0LL);
+    mTo = std::min(mTo, s.minor);
+    if (mFrom > mTo) return false;
+
+    // Translate the minor-step range into major steps
+    if (s.minor == 0) {
+        // Axis-aligned: the only minor value is 0, already known to be visible
+    }
+    else {
+        if (mFrom > 0) s.kFrom = std::max(s.kFrom, (2 * mFrom * s.major - s.major + 1 + 2 * s.minor - 1) / (2 * s.minor));
+        s.kTo = std::min(s.kTo, (2 * mTo * s.major + s.major) / (2 * s.minor));
+    }
+    if (s.kFrom > s.kTo) return false;
+
+    s.m = s.major ? (2 * s.kFrom * s.minor + s.major - 1) / (2 * s.major) : 0;
+    return true;
+}
@@ -0,0 +1,308 @@
+// LineKernels.h
+//
+// The stepping code of the line algorithms in this folder, separated from
+// the OpenGL calls so every program (and any headless tool) runs the same
+// kernel. Each kernel writes through a Target that provides
+//     void plot(int x, int y);                   // solid pixel
+//     void plot(int x, int y, float intensity);  // anti-aliased pixel
+// See RasterTarget.h (CPU buffer) and GLRasterTarget.h (immediate mode).
+// The ...Clipped variants draw only the pixels inside a ClipRect, starting
+// at the first visible one (see LineClip.h).
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+#include "LineClip.h" // ClipRect and the clip stage
+
+// DDA: float increments along both axes, rounded at every step
+template <class Target>
+void rasterLineDDA(int x1, int y1, int x2, int y2, Target &target) {
+    float dx = x2 - x1;
+    float dy = y2 - y1;
+    float steps = std::max(std::fabs(dx), std::fabs(dy)); // Determine the number of steps
+    if (steps == 0.0f) { // Degenerate segment: a single pixel
+        target.plot(x1, y1);
+        return;
+    }
+    float xInc = dx / steps; // Increment in x for each step
+    float yInc = dy / steps; // Increment in y for each step
+
+    float x = x1, y = y1;
+    for (int i = 0; i <= steps; i++) {
+        target.plot(int(std::round(x)), int(std::round(y)));
+        x += xInc;
+        y += yInc;
+    }
+}
+
+// DDA restricted to the pixels inside clip.
+// The float adds must be replayed to reproduce the unclipped rounding, but
+// Liang-Barsky bounds the steps that can land inside, so hidden steps cost
+// one add each and nothing is plotted or rounded outside that range. The
+// margin covers the half-pixel rounding plus the drift of the float adds.
+template <class Target>
+void rasterLineDDAClipped(int x1, int y1, int x2, int y2, const ClipRect &clip, Target &target) {
+    if (clipRejects(clip, x1, y1, x2, y2)) return;
+    float dx = x2 - x1;
+    float dy = y2 - y1;
+    float steps = std::max(std::fabs(dx), std::fabs(dy));
+    if (steps == 0.0f) {
+        if (clip.contains(x1, y1)) target.plot(x1, y1);
+        return;
+    }
+    double t0, t1;
+    if (!clipLiangBarsky(x1, y1, x2, y2, clip, 1.0 + steps / 4096.0, t0, t1)) return;
+    int first = std::max(0, int(std::floor(t0 * steps)) - 1);
+    int last = std::min(int(steps), int(std::ceil(t1 * steps)) + 1);
+
+    float xInc = dx / steps;
+    float yInc = dy / steps;
+    float x = x1, y = y1;
+    for (int i = 0; i < first; i++) { // Replay the hidden steps without plotting
+        x += xInc;
+        y += yInc;
+    }
+    for (int i = first; i <= last; i++) {
+        int px = int(std::round(x)), py = int(std::round(y));
+        if (clip.contains(px, py)) target.plot(px, py);
+        x += xInc;
+        y += yInc;
+    }
+}
+
+// Bresenham: integer error term covering all octants
+template <class Target>
+void rasterLineBresenham(int x1, int y1, int x2, int y2, Target &target) {
+    int dx = std::abs(x2 - x1);
+    int dy = std::abs(y2 - y1);
+    int sx = (x1 < x2) ? 1 : -1;
+    int sy = (y1 < y2) ? 1 : -1;
+    int err = dx - dy;
+
+    while (true) {
+        target.plot(x1, y1);
+
+        if (x1 == x2 && y1 == y2) break; // Exit loop when the endpoint is reached
+
+        int e2 = 2 * err;
+        if (e2 > -dy) {
+            err -= dy;
+            x1 += sx;
+        }
+        if (e2 < dx) {
+            err += dx;
+            y1 += sy;
+        }
+    }
+}
+
+// Bresenham restricted to the pixels inside clip.
+// visibleLineSteps() finds the first visible step in closed form; seeking
+// there gives exactly the pixels (and error term) of the full walk, without
+// stepping through the hidden part.
+template <class Target>
+void rasterLineBresenhamClipped(int x1, int y1, int x2, int y2, const ClipRect &clip, Target &target) {
+    LineSteps v;
+    if (!visibleLineSteps(x1, y1, x2, y2, clip, v)) return;
+    long long dx = v.dx, dy = v.dy;
+    int sx = v.sx, sy = v.sy;
+
+    // Seek to step kFrom
+    int x, y;
+    long long err;
+    if (v.xMajor) {
+        x = int(x1 + sx * v.kFrom);
+        y = int(y1 + sy * v.m);
+        err = dx - dy - v.kFrom * dy + v.m * dx;
+    }
+    else {
+        y = int(y1 + sy * v.kFrom);
+        x = int(x1 + sx * v.m);
+        err = dx - dy + v.kFrom * dx - v.m * dy;
+    }
+
+    for (long long k = v.kFrom;; k++) {
+        target.plot(x, y);
+        if (k == v.kTo) break;
+
+        long long e2 = 2 * err;
+        if (e2 > -dy) {
+            err -= dy;
+            x += sx;
+        }
+        if (e2 < dx) {
+            err += dx;
+            y += sy;
+        }
+    }
+}
+
+// Mid-point: decision variable d = 2dy - dx tested at each midpoint
+template <class Target>
+void rasterLineMidpoint(int x1, int y1, int x2, int y2, Target &target) {
+    int dx = std::abs(x2 - x1);
+    int dy = std::abs(y2 - y1);
+    int x = x1, y = y1;
+    int sx = (x1 < x2) ? 1 : -1; // Step for x
+    int sy = (y1 < y2) ? 1 : -1; // Step for y
+    bool steep = dy > dx;
+
+    if (steep) std::swap(dx, dy);
+    int d = 2 * dy - dx;
+
+    for (int i = 0; i <= dx; i++) {
+        target.plot(x, y);
+        if (d > 0) {
+            if (steep) x += sx;
+            else y += sy;
+            d -= 2 * dx;
+        }
+        if (steep) y += sy;
+        else x += sx;
+        d += 2 * dy;
+    }
+}
+
+// Mid-point restricted to the pixels inside clip. It draws the same pixels
+// as Bresenham, so visibleLineSteps() gives the seek; the decision variable
+// before step k is 2*minor*(k + 1) - major - 2*major*m.
+template <class Target>
+void rasterLineMidpointClipped(int x1, int y1, int x2, int y2, const ClipRect &clip, Target &target) {
+    LineSteps v;
+    if (!visibleLineSteps(x1, y1, x2, y2, clip, v)) return;
+    bool steep = !v.xMajor;
+    int x = int(x1 + v.sx * (steep ? v.m : v.kFrom));
+    int y = int(y1 + v.sy * (steep ? v.kFrom : v.m));
+    long long d = 2 * v.minor * (v.kFrom + 1) - v.major - 2 * v.major * v.m;
+
+    for (long long k = v.kFrom; k <= v.kTo; k++) {
+        target.plot(x, y);
+        if (d > 0) {
+            if (steep) x += v.sx;
+            else y += v.sy;
+            d -= 2 * v.major;
+        }
+        if (steep) y += v.sy;
+        else x += v.sx;
+        d += 2 * v.minor;
+    }
+}
+
+// Xiaolin Wu restricted to the pixels inside clip
+template <class Target>
+void rasterLineXiaolinWuClipped(int x1, int y1, int x2, int y2, const ClipRect &clip, Target &target) {
+    bool steep = std::abs(y2 - y1) > std::abs(x2 - x1);
+
+    if (steep) {
+        std::swap(x1, y1);
+        std::swap(x2, y2);
+    }
+    if (x1 > x2) {
+        std::swap(x1, x2);
+        std::swap(y1, y2);
+    }
+
+    // Plot with the axes swapped back for steep lines
+    auto plot = [&](int x, int y, float intensity) {
+        if (steep) std::swap(x, y);
+        if (clip.contains(x, y)) target.plot(x, y, intensity);
+    };
+
+    float dx = x2 - x1;
+    float dy = y2 - y1;
+    float gradient = (dx == 0.0f) ? 1.0f : dy / dx;
+
+    // Handle first endpoint
+    int xend = x1;
+    float yend = y1 + gradient * (xend - x1);
+    float xgap = 1.0f - ((x1 + 0.5f) - std::floor(x1 + 0.5f));
+    int xpxl1 = xend;
+    int ypxl1 = int(std::floor(yend));
+    plot(xpxl1, ypxl1, 1.0f - (yend - std::floor(yend)) * xgap);
+    plot(xpxl1, ypxl1 + 1, (yend - std::floor(yend)) * xgap);
+    float ystart = yend;
+
+    // Handle second endpoint
+    xend = x2;
+    yend = y2 + gradient * (xend - x2);
+    xgap = (x2 + 0.5f) - std::floor(x2 + 0.5f);
+    int xpxl2 = xend;
+    int ypxl2 = int(std::floor(yend));
+    plot(xpxl2, ypxl2, 1.0f - (yend - std::floor(yend)) * xgap);
+    plot(xpxl2, ypxl2 + 1, (yend - std::floor(yend)) * xgap);
+
+    // Main loop over the columns that fall inside the clip rectangle.
+    // intery is evaluated per column rather than accumulated, so a clipped
+    // line starts mid-way with exactly the values the full line would use.
+    int first = std::max(xpxl1 + 1, steep ? clip.yMin : clip.xMin);
+    int last = std::min(xpxl2 - 1, steep ? clip.yMax : clip.xMax);
+    for (int x = first; x <= last; x++) {
+        float intery = ystart + gradient * (x - xpxl1);
+        int y = int(std::floor(intery));
+        plot(x, y, 1.0f - (intery - y));
+        plot(x, y + 1, intery - y);
+    }
+}
+
+// Xiaolin Wu: two pixels per column, weighted by distance to the true line
+template <class Target>
+void rasterLineXiaolinWu(int x1, int y1, int x2, int y2, Target &target) {
+    rasterLineXiaolinWuClipped(x1, y1, x2, y2, ClipRect::unbounded(), target);
+}
+
+// Function to calculate the intensity using the Gupta-Sproull filter
+inline float guptaSproullIntensity(float distance, float lineWidth) {
+    float radius = lineWidth / 2.0f;
+    if (distance > radius) return 0.0f; // Outside the filter radius
+    return 1.0f - (distance / radius);  // Linear falloff
+}
+
+// Gupta-Sproull approximation restricted to the pixels inside clip:
+// Bresenham centre pixel plus its 3x3 neighbourhood, each neighbour weighted
+// by its distance from the centre pixel. The centres are walked with the
+// clipped Bresenham over the rectangle grown by one pixel, since a centre just
+// outside can still light a neighbour inside.
+// GuptaSproull.h has the table-driven kernel with true line distances.
+template <class Target>
+void rasterLineGuptaSproullClipped(int x1, int y1, int x2, int y2, const ClipRect &clip, Target &target,
+                                   float lineWidth = 2.0f) {
+    // Neighbour weights depend only on the offset
+    float weight[3][3];
+    for (int i = -1; i <= 1; i++) {
+        for (int j = -1; j <= 1; j++) {
+            float distance = std::sqrt(float(i * i + j * j)); // Distance from the main pixel
+            weight[i + 1][j + 1] = guptaSproullIntensity(distance, lineWidth);
+        }
+    }
+
+    struct Neighbourhood {
+        const ClipRect &clip;
+        const float (&weight)[3][3];
+        Target &target;
+
+        void plot(int x, int y) {
+            // Plot the main pixel
+            if (clip.contains(x, y)) target.plot(x, y, 1.0f);
+
+            // Anti-aliasing: Plot surrounding pixels with intensity
+            for (int i = -1; i <= 1; i++) {
+                for (int j = -1; j <= 1; j++) {
+                    if (i == 0 && j == 0) continue; // Skip the main pixel
+                    if (clip.contains(x + i, y + j)) target.plot(x + i, y + j, weight[i + 1][j + 1]);
+                }
+            }
+        }
+    } centres = {clip, weight, target};
+    rasterLineBresenhamClipped(x1, y1, x2, y2, clip.grown(1), centres);
+}
+
+// Gupta-Sproull approximation over the whole line
+template <class Target>
+void rasterLineGuptaSproull(int x1, int y1, int x2, int y2, Target &target, float lineWidth = 2.0f) {
+    rasterLineGuptaSproullClipped(x1, y1, x2, y2, ClipRect::unbounded(), target, lineWidth);
+}
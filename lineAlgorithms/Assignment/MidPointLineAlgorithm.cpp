@@ -2,35 +2,25 @@
 #include <iostream>
 #include <cmath>
 #include <string>
+#include "GLRasterTarget.h"
+#include "LineKernels.h"
 
-// Function to implement the Mid-Point Line Drawing Algorithm
+// Pixels visible through the gluOrtho2D() projection set in init(); the
+// kernels skip everything outside it
+const ClipRect VIEWPORT = ClipRect::fromOrtho(-5, 5, -5, 5);
+
+// Function to implement the Mid-Point Line Drawing Algorithm (kernel in LineKernels.h)
 void drawLineMidpoint(int x1, int y1, int x2, int y2) {
-   int dx = abs(x2 - x1);
-   int dy = abs(y2 - y1);
-   int x = x1, y = y1;
-   int sx = (x1 < x2) ? 1 : -1; // Step for x
-   int sy = (y1 < y2) ? 1 : -1; // Step for y
-   bool steep = dy > dx;
+   std::cout << "Calculated Points:\n";
 
-   if (steep) std::swap(dx, dy);
-   int d = 2 * dy - dx;
+   glColor3f(1.0, 1.0, 1.0); // Set line color to white
+   glPointSize(5.0); // Enlarge the plotted points
 
-   glColor3f(1.0, 1.0, 1.0);
-   glPointSize(5.0);
+   GLVertexTarget points;
    glBegin(GL_POINTS);
-   for (int i = 0; i <= dx; i++) {
-       glVertex2i(x, y);
-       std::cout << "(" << x << ", " << y << ")\n";
-       if (d > 0) {
-           if (steep) x += sx;
-           else y += sy;
-           d -= 2 * dx;
-       }
-       if (steep) y += sy;
-       else x += sx;
-       d += 2 * dy;
-   }
+   rasterLineMidpointClipped(x1, y1, x2, y2, VIEWPORT, points);
    glEnd();
+
    glFlush();
 }
 
@@ -0,0 +1,181 @@
+// RasterTarget.h
+//
+// A plain CPU raster target for the line algorithms in this folder.
+// The kernels in LineKernels.h write pixels through a target object, so the
+// same stepping code can draw into an OpenGL window (GLRasterTarget.h) or
+// into this in-memory RGBA/coverage buffer with no GL context at all.
+//
+// Coordinates are the Cartesian ones used by the exercises (they may be
+// negative). originX/originY give the buffer pixel that holds (0, 0).
+// Row 0 is the bottom row, the same layout glReadPixels returns.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Pack an RGBA color (components 0-255) into one 32-bit pixel
+inline uint32_t packRGBA(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255) {
+    return uint32_t(r) | (uint32_t(g) << 8) | (uint32_t(b) << 16) | (uint32_t(a) << 24);
+}
+
+struct RasterTarget {
+    int width;
+    int height;
+    int originX; // Buffer column of x = 0
+    int originY; // Buffer row of y = 0
+
+    std::vector<uint32_t> rgba;    // Packed RGBA8 color, one per pixel
+    std::vector<uint8_t> coverage; // 0 = untouched, 255 = fully covered
+
+    uint32_t color = packRGBA(255, 255, 255); // Current drawing color (white)
+    size_t pixelsWritten = 0;                 // Plots that landed inside the buffer
+
+    RasterTarget(int w, int h, int ox = 0, int oy = 0)
+        : width(w), height(h), originX(ox), originY(oy),
+          rgba(size_t(w) * size_t(h), 0), coverage(size_t(w) * size_t(h), 0) {}
+
+    // Build a target that covers the Cartesian window [xMin, xMax] x [yMin, yMax]
+    static RasterTarget forWindow(int xMin, int xMax, int yMin, int yMax) {
+        return RasterTarget(xMax - xMin + 1, yMax - yMin + 1, -xMin, -yMin);
+    }
+
+    void clear() {
+        std::fill(rgba.begin(), rgba.end(), 0u);
+        std::fill(coverage.begin(), coverage.end(), uint8_t(0));
+        pixelsWritten = 0;
+    }
+
+    bool contains(int x, int y) const {
+        return unsigned(x + originX) < unsigned(width) && unsigned(y + originY) < unsigned(height);
+    }
+
+    size_t index(int x, int y) const {
+        return size_t(y + originY) * size_t(width) + size_t(x + originX);
+    }
+
+    uint8_t coverageAt(int x, int y) const {
+        return contains(x, y) ? coverage[index(x, y)] : 0;
+    }
+
+    // Plot a fully covered pixel
+    void plot(int x, int y) {
+        if (!contains(x, y)) return;
+        size_t i = index(x, y);
+        rgba[i] = color;
+        coverage[i] = 255;
+        pixelsWritten++;
+    }
+
+    // Plot an anti-aliased pixel; intensity is clamped to [0, 1].
+    // Coverage keeps the strongest sample written to the pixel so far.
+    void plot(int x, int y, float intensity) {
+        if (!contains(x, y)) return;
+        if (!(intensity > 0.0f)) return;
+        if (intensity > 1.0f) intensity = 1.0f;
+        uint8_t a = uint8_t(intensity * 255.0f + 0.5f);
+        size_t i = index(x, y);
+        if (a > coverage[i]) {
+            coverage[i] = a;
+            rgba[i] = (color & 0x00FFFFFFu) | (uint32_t(a) << 24);
+        }
+        pixelsWritten++;
+    }
+
+    // Add an amount of coverage (0..65536 = 0..1) to a pixel, compositing it
+    // over what is already there: a' = a + c(1 - a). Overlapping anti-aliased
+    // lines then add up instead of the stronger one winning, and (up to
+    // rounding) the result does not depend on drawing order.
+    void accumulate(int x, int y, uint32_t amount) {
+        if (!contains(x, y)) return;
+        size_t i = index(x, y);
+        uint32_t a = coverage[i];
+        a += ((255u - a) * std::min(amount, 65536u) + 32768u) >> 16;
+        coverage[i] = uint8_t(a);
+        rgba[i] = (color & 0x00FFFFFFu) | (a << 24);
+        pixelsWritten++;
+    }
+
+    // Fill the horizontal run x0..x1 (inclusive, either order) on row y
+    void fillRow(int x0, int x1, int y) {
+        if (x0 > x1) std::swap(x0, x1);
+        if (unsigned(y + originY) >= unsigned(height)) return;
+        x0 = std::max(x0, -originX);
+        x1 = std::min(x1, width - 1 - originX);
+        if (x0 > x1) return;
+        size_t i = index(x0, y);
+        size_t n = size_t(x1 - x0 + 1);
+        std::fill_n(rgba.begin() + i, n, color);
+        std::fill_n(coverage.begin() + i, n, uint8_t(255));
+        pixelsWritten += n;
+    }
+
+    // Fill the vertical run y0..y1 (inclusive, either order) in column x
+    void fillColumn(int x, int y0, int y1) {
+        if (y0 > y1) std::swap(y0, y1);
+        if (unsigned(x + originX) >= unsigned(width)) return;
+        y0 = std::max(y0, -originY);
+        y1 = std::min(y1, height - 1 - originY);
+        for (int y = y0; y <= y1; y++) {
+            size_t i = index(x, y);
+            rgba[i] = color;
+            coverage[i] = 255;
+        }
+        if (y0 <= y1) pixelsWritten += size_t(y1 - y0 + 1);
+    }
+};
+
+// Single-channel coverage buffer with 8-bit (uint8_t) or 16-bit (uint16_t)
+// samples, for kernels that only produce alpha. Same coordinates as RasterTarget.
+template <class T>
+struct AlphaBuffer {
+    static const uint32_t MAX_ALPHA = (uint32_t(1) << (8 * sizeof(T))) - 1;
+
+    int width;
+    int height;
+    int originX; // Buffer column of x = 0
+    int originY; // Buffer row of y = 0
+    std::vector<T> alpha;
+    size_t pixelsWritten = 0;
+
+    AlphaBuffer(int w, int h, int ox = 0, int oy = 0)
+        : width(w), height(h), originX(ox), originY(oy), alpha(size_t(w) * size_t(h), 0) {}
+
+    void clear() {
+        std::fill(alpha.begin(), alpha.end(), T(0));
+        pixelsWritten = 0;
+    }
+
+    bool contains(int x, int y) const {
+        return unsigned(x + originX) < unsigned(width) && unsigned(y + originY) < unsigned(height);
+    }
+
+    size_t index(int x, int y) const {
+        return size_t(y + originY) * size_t(width) + size_t(x + originX);
+    }
+
+    T alphaAt(int x, int y) const {
+        return contains(x, y) ? alpha[index(x, y)] : T(0);
+    }
+
+    // Composite an amount of coverage (0..65536 = 0..1) over the stored alpha: a' = a + c(1 - a)
+    void accumulate(int x, int y, uint32_t amount) {
+        if (!contains(x, y)) return;
+        T &a = alpha[index(x, y)];
+        a = T(a + ((uint64_t(MAX_ALPHA - a) * std::min(amount, 65536u) + 32768u) >> 16));
+        pixelsWritten++;
+    }
+
+    void plot(int x, int y) { accumulate(x, y, 65536u); }
+
+    void plot(int x, int y, float intensity) {
+        if (!(intensity > 0.0f)) return;
+        accumulate(x, y, intensity >= 1.0f ? 65536u : uint32_t(intensity * 65536.0f + 0.5f));
+    }
+};
+
+typedef AlphaBuffer<uint8_t> AlphaBuffer8;
+typedef AlphaBuffer<uint16_t> AlphaBuffer16;
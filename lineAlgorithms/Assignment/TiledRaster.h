@@ -0,0 +1,189 @@
+// TiledRaster.h
+//
+// Multithreaded line rasterization into a RasterTarget.
+// The target is cut into square tiles. Segments are first binned into every
+// tile their pixels can touch, then a pool of worker threads takes tiles one
+// at a time and rasterizes the tile's segments, clipped to the tile, into a
+// private tile buffer that is copied back when the tile is done. Tiles never
+// overlap, so the framebuffer needs no locking, and the output does not
+// depend on the number of threads.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "BresenhamBatch.h" // LineSegment
+#include "LineKernels.h"
+#include "RasterTarget.h"
+#include "WuFixed.h"
+
+enum class TileKernel {
+    Bresenham,
+    XiaolinWu,
+    XiaolinWuFixed // 16.16 kernel from WuFixed.h, coverage composited with accumulate()
+};
+
+struct TiledRasterOptions {
+    TileKernel kernel = TileKernel::Bresenham;
+    int tileSize = 64;    // Tile edge in pixels
+    unsigned threads = 0; // 0 = one per hardware thread
+};
+
+// Segments binned per tile, in compressed form: tile t owns
+// segmentIndex[tileStart[t] .. tileStart[t + 1])
+struct TileBins {
+    int tilesX = 0, tilesY = 0;
+    std::vector<size_t> tileStart;
+    std::vector<size_t> segmentIndex;
+};
+
+// Call visit(tile) for every tile the segment's pixels may touch.
+// Works one tile row at a time, using the segment's x extent inside that
+// row band widened by one pixel (Wu also writes the pixel next to the line).
+template <class Visit>
+void forEachSegmentTile(const LineSegment &s, const RasterTarget &target, int tileSize, int tilesX, Visit &&visit) {
+    // Segment in buffer coordinates
+    double ax = double(s.x1) + target.originX, ay = double(s.y1) + target.originY;
+    double bx = double(s.x2) + target.originX, by = double(s.y2) + target.originY;
+    double rowLo = std::floor(std::min(ay, by)) - 1.0, rowHi = std::ceil(std::max(ay, by)) + 1.0;
+    if (rowHi < 0.0 || rowLo > target.height - 1) return;
+    int rowMin = int(std::max(rowLo, 0.0)); // Clamped in double, so far-off rows convert safely
+    int rowMax = int(std::min(rowHi, double(target.height - 1)));
+    double segMinX = std::min(ax, bx) - 1.0, segMaxX = std::max(ax, bx) + 1.0;
+
+    for (int ty = rowMin / tileSize; ty <= rowMax / tileSize; ty++) {
+        double bandLo = std::max(ty * tileSize, rowMin) - 1.0;
+        double bandHi = std::min(ty * tileSize + tileSize - 1, rowMax) + 1.0;
+        double xLo = segMinX, xHi = segMaxX;
+        if (ay != by) {
+            double xa = ax + (bx - ax) * (bandLo - ay) / (by - ay);
+            double xb = ax + (bx - ax) * (bandHi - ay) / (by - ay);
+            xLo = std::max(xLo, std::min(xa, xb) - 1.0);
+            xHi = std::min(xHi, std::max(xa, xb) + 1.0);
+        }
+        double colLo = std::floor(xLo), colHi = std::ceil(xHi);
+        if (colHi < 0.0 || colLo > target.width - 1) continue;
+        int colMin = int(std::max(colLo, 0.0));
+        int colMax = int(std::min(colHi, double(target.width - 1)));
+        for (int tx = colMin / tileSize; colMin <= colMax && tx <= colMax / tileSize; tx++) {
+            visit(ty * tilesX + tx);
+        }
+    }
+}
+
+// Run body(worker, begin, end) over [0, count) split into one chunk per worker
+template <class Body>
+void runChunks(unsigned workers, size_t count, Body &&body) {
+    std::vector<std::thread> pool;
+    size_t chunk = (count + workers - 1) / workers;
+    for (unsigned w = 0; w < workers; w++) {
+        size_t begin = std::min(count, w * chunk);
+        size_t end = std::min(count, begin + chunk);
+        pool.emplace_back([&body, w, begin, end]() { body(w, begin, end); });
+    }
+    for (std::thread &t : pool) t.join();
+}
+
+// Bin segments into tiles. Each worker counts and then scatters its own
+// chunk, so a tile lists its segments in input order.
+inline TileBins binSegments(const LineSegment *segments, size_t count, const RasterTarget &target,
+                            int tileSize, unsigned workers) {
+    TileBins bins;
+    bins.tilesX = (target.width + tileSize - 1) / tileSize;
+    bins.tilesY = (target.height + tileSize - 1) / tileSize;
+    size_t tiles = size_t(bins.tilesX) * size_t(bins.tilesY);
+
+    // Pass 1: per-worker tile counts
+    std::vector<size_t> counts(size_t(workers) * tiles, 0);
+    runChunks(workers, count, [&](unsigned w, size_t begin, size_t end) {
+        size_t *myCounts = &counts[size_t(w) * tiles];
+        for (size_t i = begin; i < end; i++) {
+            forEachSegmentTile(segments[i], target, tileSize, bins.tilesX, [myCounts](int t) { myCounts[t]++; });
+        }
+    });
+
+    // Prefix sum, tile-major then worker-major, turns counts into write offsets
+    bins.tileStart.assign(tiles + 1, 0);
+    size_t offset = 0;
+    for (size_t t = 0; t < tiles; t++) {
+        bins.tileStart[t] = offset;
+        for (unsigned w = 0; w < workers; w++) {
+            size_t n = counts[size_t(w) * tiles + t];
+            counts[size_t(w) * tiles + t] = offset;
+            offset += n;
+        }
+    }
+    bins.tileStart[tiles] = offset;
+
+    // Pass 2: scatter segment indices
+    bins.segmentIndex.resize(offset);
+    runChunks(workers, count, [&](unsigned w, size_t begin, size_t end) {
+        size_t *myOffsets = &counts[size_t(w) * tiles];
+        for (size_t i = begin; i < end; i++) {
+            forEachSegmentTile(segments[i], target, tileSize, bins.tilesX,
+                               [&bins, myOffsets, i](int t) { bins.segmentIndex[myOffsets[t]++] = i; });
+        }
+    });
+    return bins;
+}
+
+// Rasterize count segments into target with a pool of worker threads
+inline void rasterLinesTiled(const LineSegment *segments, size_t count, RasterTarget &target,
+                             const TiledRasterOptions &options = TiledRasterOptions()) {
+    int tileSize = std::max(8, options.tileSize);
+    unsigned workers = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+
+    TileBins bins = binSegments(segments, count, target, tileSize, workers);
+    size_t tiles = size_t(bins.tilesX) * size_t(bins.tilesY);
+
+    std::atomic<size_t> nextTile(0);
+    std::atomic<size_t> pixelsWritten(0);
+    runChunks(workers, workers, [&](unsigned, size_t, size_t) {
+        // Private tile buffer, reused for every tile this worker takes
+        RasterTarget tile(tileSize, tileSize);
+        tile.color = target.color;
+        size_t written = 0;
+
+        for (size_t t = nextTile++; t < tiles; t = nextTile++) {
+            size_t first = bins.tileStart[t], last = bins.tileStart[t + 1];
+            if (first == last) continue;
+
+            // Place the tile buffer over this tile's pixels
+            int col0 = int(t % bins.tilesX) * tileSize, row0 = int(t / bins.tilesX) * tileSize;
+            tile.width = std::min(tileSize, target.width - col0);
+            tile.height = std::min(tileSize, target.height - row0);
+            tile.originX = target.originX - col0;
+            tile.originY = target.originY - row0;
+            tile.pixelsWritten = 0;
+            for (int r = 0; r < tile.height; r++) {
+                size_t src = size_t(row0 + r) * size_t(target.width) + size_t(col0);
+                std::copy_n(&target.rgba[src], tile.width, &tile.rgba[size_t(r) * tile.width]);
+                std::copy_n(&target.coverage[src], tile.width, &tile.coverage[size_t(r) * tile.width]);
+            }
+
+            // Each segment starts at its first pixel inside the tile, not at its start point
+            ClipRect clip = {col0 - target.originX, row0 - target.originY,
+                             col0 - target.originX + tile.width - 1, row0 - target.originY + tile.height - 1};
+            for (size_t k = first; k < last; k++) {
+                const LineSegment &s = segments[bins.segmentIndex[k]];
+                if (options.kernel == TileKernel::XiaolinWu) rasterLineXiaolinWuClipped(s.x1, s.y1, s.x2, s.y2, clip, tile);
+                else if (options.kernel == TileKernel::XiaolinWuFixed) rasterLineWuFixedClipped(s.x1, s.y1, s.x2, s.y2, clip, tile);
+                else rasterLineBresenhamClipped(s.x1, s.y1, s.x2, s.y2, clip, tile);
+            }
+
+            for (int r = 0; r < tile.height; r++) {
+                size_t dst = size_t(row0 + r) * size_t(target.width) + size_t(col0);
+                std::copy_n(&tile.rgba[size_t(r) * tile.width], tile.width, &target.rgba[dst]);
+                std::copy_n(&tile.coverage[size_t(r) * tile.width], tile.width, &target.coverage[dst]);
+            }
+            written += tile.pixelsWritten;
+        }
+        pixelsWritten += written;
+    });
+    target.pixelsWritten += pixelsWritten;
+}
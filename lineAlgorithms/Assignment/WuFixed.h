@@ -0,0 +1,171 @@
+// WuFixed.h
+//
+// Xiaolin Wu's anti-aliased line in 16.16 fixed point.
+// Endpoints may be sub-pixel (16 fractional bits) and lie within about
+// +-32768 pixels, which is all 16.16 holds; whole-pixel lines reaching
+// further are cut down to the part near the clip rectangle first. The slope is divided out
+// once per line; after that each column costs one integer add and two
+// shifts, with no floor() or float conversion. Coverage is handed to the
+// target as an integer in 0..65536 (= 0..1) through
+//     void accumulate(int x, int y, uint32_t amount);
+// which RasterTarget and AlphaBuffer8/AlphaBuffer16 composite with the
+// "over" rule, so pixels shared by overlapping lines add up correctly.
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+
+#include "LineKernels.h" // ClipRect, clipLiangBarsky
+
+const int WU_FIXED_SHIFT = 16;
+const int64_t WU_FIXED_ONE = int64_t(1) << WU_FIXED_SHIFT;
+const int64_t WU_FIXED_MASK = WU_FIXED_ONE - 1;
+
+// 16.16 holds pixel coordinates from -32768 up to just under 32768
+const int WU_FIXED_MIN_PIXEL = -32768;
+const int WU_FIXED_MAX_PIXEL = 32767;
+
+// Convert a pixel coordinate to 16.16 fixed point. Coordinates outside the
+// range above saturate to the nearest representable value (NaN gives 0).
+inline int32_t toFixed16(int v) {
+    int64_t f = int64_t(v) * WU_FIXED_ONE;
+    return int32_t(std::min<int64_t>(std::max<int64_t>(f, INT32_MIN), INT32_MAX));
+}
+inline int32_t toFixed16(double v) {
+    double f = v * 65536.0 + (v < 0.0 ? -0.5 : 0.5);
+    if (!(f > double(INT32_MIN))) return v != v ? 0 : INT32_MIN;
+    if (!(f < double(INT32_MAX))) return INT32_MAX;
+    return int32_t(f);
+}
+inline int32_t toFixed16(float v) { return toFixed16(double(v)); }
+
+// Wu line between 16.16 endpoints, restricted to the pixels inside clip.
+// The y intercept of column x is intery0 + (x - first) * gradient in exact
+// integer arithmetic, so a clipped line reproduces the unclipped pixels.
+template <class Target>
+void rasterLineWuFixed16Clipped(int32_t fx1, int32_t fy1, int32_t fx2, int32_t fy2, const ClipRect &clip, Target &target) {
+    int64_t x1 = fx1, y1 = fy1, x2 = fx2, y2 = fy2;
+    bool steep = std::llabs(y2 - y1) > std::llabs(x2 - x1);
+
+    if (steep) {
+        std::swap(x1, y1);
+        std::swap(x2, y2);
+    }
+    if (x1 > x2) {
+        std::swap(x1, x2);
+        std::swap(y1, y2);
+    }
+
+    // Endpoint pixels: axis-swapped, clipped, zero coverage skipped
+    auto plot = [&](int64_t x, int64_t y, int64_t amount) {
+        if (amount <= 0) return;
+        int px = int(steep ? y : x), py = int(steep ? x : y);
+        if (clip.contains(px, py)) target.accumulate(px, py, uint32_t(amount));
+    };
+
+    int64_t dx = x2 - x1;
+    int64_t dy = y2 - y1;
+
+    // The slope and the running intercept keep 32 fractional bits, so the
+    // intercept does not drift on long lines; coverage uses the top 16.
+    const int GRADIENT_SHIFT = 32;
+    int64_t gradient = int64_t(1) << GRADIENT_SHIFT;
+    if (dx != 0) {
+        // (dy << 32) / dx in two halves, so nothing overflows 64 bits; the
+        // shifts are written as products because dy may be negative
+        int64_t high = (dy * WU_FIXED_ONE) / dx, rest = (dy * WU_FIXED_ONE) % dx;
+        gradient = high * WU_FIXED_ONE + (rest * WU_FIXED_ONE) / dx;
+    }
+
+    // Handle first endpoint
+    int64_t xend = (x1 + WU_FIXED_ONE / 2) & ~WU_FIXED_MASK; // round(x1)
+    int64_t yend = y1 + ((gradient * (xend - x1)) >> GRADIENT_SHIFT);
+    int64_t xgap = WU_FIXED_ONE - ((x1 + WU_FIXED_ONE / 2) & WU_FIXED_MASK); // rfpart(x1 + 0.5)
+    int64_t xpxl1 = xend >> WU_FIXED_SHIFT;
+    int64_t frac = yend & WU_FIXED_MASK;
+    plot(xpxl1, yend >> WU_FIXED_SHIFT, ((WU_FIXED_ONE - frac) * xgap) >> WU_FIXED_SHIFT);
+    plot(xpxl1, (yend >> WU_FIXED_SHIFT) + 1, (frac * xgap) >> WU_FIXED_SHIFT);
+    int64_t intery = yend * (int64_t(1) << (GRADIENT_SHIFT - WU_FIXED_SHIFT)) + gradient; // y intercept of column xpxl1 + 1
+
+    // Handle second endpoint
+    xend = (x2 + WU_FIXED_ONE / 2) & ~WU_FIXED_MASK;
+    yend = y2 + ((gradient * (xend - x2)) >> GRADIENT_SHIFT);
+    xgap = (x2 + WU_FIXED_ONE / 2) & WU_FIXED_MASK; // fpart(x2 + 0.5)
+    int64_t xpxl2 = xend >> WU_FIXED_SHIFT;
+    frac = yend & WU_FIXED_MASK;
+    plot(xpxl2, yend >> WU_FIXED_SHIFT, ((WU_FIXED_ONE - frac) * xgap) >> WU_FIXED_SHIFT);
+    plot(xpxl2, (yend >> WU_FIXED_SHIFT) + 1, (frac * xgap) >> WU_FIXED_SHIFT);
+
+    // Columns of the main loop that fall inside the clip rectangle
+    int64_t first = std::max<int64_t>(xpxl1 + 1, steep ? clip.yMin : clip.xMin);
+    int64_t last = std::min<int64_t>(xpxl2 - 1, steep ? clip.yMax : clip.xMax);
+    if (first > last) return;
+    intery += (first - (xpxl1 + 1)) * gradient;
+
+    // The minor coordinate is monotonic, so one test on the run's two ends
+    // tells whether any pixel of the run can leave the clip rectangle
+    int64_t yFirst = intery >> GRADIENT_SHIFT;
+    int64_t yLast = (intery + (last - first) * gradient) >> GRADIENT_SHIFT;
+    int64_t minorMin = steep ? clip.xMin : clip.yMin, minorMax = steep ? clip.xMax : clip.yMax;
+    bool inside = std::min(yFirst, yLast) >= minorMin && std::max(yFirst, yLast) + 1 <= minorMax;
+
+    // Main loop: one add and two shifts per column. The lower pixel always
+    // gets coverage; the upper one only when the line is off-centre.
+    auto run = [&](auto put) {
+        for (int64_t x = first; x <= last; x++) {
+            int y = int(intery >> GRADIENT_SHIFT);
+            uint32_t f = uint32_t(intery >> (GRADIENT_SHIFT - WU_FIXED_SHIFT)) & uint32_t(WU_FIXED_MASK);
+            put(int(x), y, uint32_t(WU_FIXED_ONE) - f);
+            if (f) put(int(x), y + 1, f);
+            intery += gradient;
+        }
+    };
+    if (inside) {
+        if (steep) run([&](int x, int y, uint32_t a) { target.accumulate(y, x, a); });
+        else run([&](int x, int y, uint32_t a) { target.accumulate(x, y, a); });
+    }
+    else {
+        if (steep) run([&](int x, int y, uint32_t a) { if (y >= minorMin && y <= minorMax) target.accumulate(y, x, a); });
+        else run([&](int x, int y, uint32_t a) { if (y >= minorMin && y <= minorMax) target.accumulate(x, y, a); });
+    }
+}
+
+// Wu line between 16.16 fixed-point endpoints
+template <class Target>
+void rasterLineWuFixed16(int32_t fx1, int32_t fy1, int32_t fx2, int32_t fy2, Target &target) {
+    rasterLineWuFixed16Clipped(fx1, fy1, fx2, fy2, ClipRect::unbounded(), target);
+}
+
+// Wu line between whole-pixel endpoints, restricted to clip. A line with an
+// endpoint outside WU_FIXED_MIN_PIXEL..WU_FIXED_MAX_PIXEL does not fit 16.16:
+// it is first cut (Liang-Barsky) to one pixel inside that range, and the
+// new ends become sub-pixel 16.16 points on the same line. The pixels
+// inside clip then match the unclipped line to within the rounding of
+// those points; only a clip reaching the edge of the range sees the
+// partial coverage of the new ends. The cut does not depend on clip, so
+// the tiles of TiledRaster.h agree with one serial pass.
+template <class Target>
+void rasterLineWuFixedClipped(int x1, int y1, int x2, int y2, const ClipRect &clip, Target &target) {
+    auto inRange = [](int v) { return v >= WU_FIXED_MIN_PIXEL && v <= WU_FIXED_MAX_PIXEL; };
+    if (inRange(x1) && inRange(y1) && inRange(x2) && inRange(y2)) {
+        rasterLineWuFixed16Clipped(toFixed16(x1), toFixed16(y1), toFixed16(x2), toFixed16(y2), clip, target);
+        return;
+    }
+    const ClipRect window = {WU_FIXED_MIN_PIXEL + 1, WU_FIXED_MIN_PIXEL + 1, WU_FIXED_MAX_PIXEL - 1,
+                             WU_FIXED_MAX_PIXEL - 1};
+    double t0, t1;
+    if (clipRejects(clip, x1, y1, x2, y2) || !clipLiangBarsky(x1, y1, x2, y2, window, 0.0, t0, t1)) return;
+    double dx = double(x2) - x1, dy = double(y2) - y1;
+    rasterLineWuFixed16Clipped(toFixed16(x1 + t0 * dx), toFixed16(y1 + t0 * dy), toFixed16(x1 + t1 * dx),
+                               toFixed16(y1 + t1 * dy), clip, target);
+}
+
+// Wu line between whole-pixel endpoints
+template <class Target>
+void rasterLineWuFixed(int x1, int y1, int x2, int y2, Target &target) {
+    rasterLineWuFixedClipped(x1, y1, x2, y2, ClipRect::unbounded(), target);
+}
@@ -2,82 +2,24 @@
 #include <iostream>
 #include <cmath>
 #include <string>
+#include "GLRasterTarget.h"
+#include "WuFixed.h"
 
-// Function to plot a pixel with intensity
-void plotPixel(int x, int y, float intensity) {
-   glColor3f(1.0, 1.0, 1.0)
-   glPointSize(5.0); 
-   glBegin(GL_POINTS);
-   glVertex2i(x, y);
-   glEnd();
-
-
-   std::cout << "(" << x << ", " << y << ") Intensity: " << intensity << "\n";
-}
+// Pixels visible through the gluOrtho2D() projection set in init(); the
+// kernels skip everything outside it
+const ClipRect VIEWPORT = ClipRect::fromOrtho(-10, 10, -10, 10);
 
-// Function to implement Xiaolin Wu's Line Algorithm
+// Function to implement Xiaolin Wu's Line Algorithm (16.16 fixed-point kernel in WuFixed.h)
 void drawLineXiaolinWu(int x1, int y1, int x2, int y2) {
-   bool steep = abs(y2 - y1) > abs(x2 - x1);
+   std::cout << "Calculated Points:\n";
 
-   if (steep) {
-       std::swap(x1, y1);
-       std::swap(x2, y2);
-   }
-   if (x1 > x2) {
-       std::swap(x1, x2);
-       std::swap(y1, y2);
-   }
-
-   float dx = x2 - x1;
-   float dy = y2 - y1;
-   float gradient = (dx == 0.0f) ? 1.0f : dy / dx;
-
-   // Handle first endpoint
-   int xend = round(x1);
-   float yend = y1 + gradient * (xend - x1);
-   float xgap = 1.0f - (x1 + 0.5f) - floor(x1 + 0.5f);
-   int xpxl1 = xend;
-   int ypxl1 = floor(yend);
-   if (steep) {
-       plotPixel(ypxl1, xpxl1, 1.0f - (yend - floor(yend)) * xgap);
-       plotPixel(ypxl1 + 1, xpxl1, (yend - floor(yend)) * xgap);
-   }
-   else {
-       plotPixel(xpxl1, ypxl1, 1.0f - (yend - floor(yend)) * xgap);
-       plotPixel(xpxl1, ypxl1 + 1, (yend - floor(yend)) * xgap);
-   }
-   float intery = yend + gradient;
-
-   // Handle second endpoint
-   xend = round(x2);
-   yend = y2 + gradient * (xend - x2);
-   xgap = (x2 + 0.5f) - floor(x2 + 0.5f);
-   int xpxl2 = xend;
-   int ypxl2 = floor(yend);
-   if (steep) {
-       plotPixel(ypxl2, xpxl2, 1.0f - (yend - floor(yend)) * xgap);
-       plotPixel(ypxl2 + 1, xpxl2, (yend - floor(yend)) * xgap);
-   }
-   else {
-       plotPixel(xpxl2, ypxl2, 1.0f - (yend - floor(yend)) * xgap);
-       plotPixel(xpxl2, ypxl2 + 1, (yend - floor(yend)) * xgap);
-   }
+   glColor3f(1.0, 1.0, 1.0); // Set line color to white
+   glPointSize(5.0); // Enlarge the plotted points
 
-   // Main loop
-   if (steep) {
-       for (int x = xpxl1 + 1; x < xpxl2; x++) {
-           plotPixel(floor(intery), x, 1.0f - (intery - floor(intery)));
-           plotPixel(floor(intery) + 1, x, intery - floor(intery));
-           intery += gradient;
-       }
-   }
-   else {
-       for (int x = xpxl1 + 1; x < xpxl2; x++) {
-           plotPixel(x, floor(intery), 1.0f - (intery - floor(intery)));
-           plotPixel(x, floor(intery) + 1, intery - floor(intery));
-           intery += gradient;
-       }
-   }
+   GLVertexTarget points;
+   glBegin(GL_POINTS);
+   rasterLineWuFixedClipped(x1, y1, x2, y2, VIEWPORT, points);
+   glEnd();
 
    glFlush();
 }
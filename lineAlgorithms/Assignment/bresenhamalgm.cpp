@@ -2,60 +2,71 @@
 #include <iostream>
 #include <cmath>
 #include <string>
-
-// Function to implement Bresenham�s Line-Drawing Algorithm
-void drawLineBresenham(int x1, int y1, int x2, int y2) {
-   int dx = abs(x2 - x1);
-   int dy = abs(y2 - y1);
-   int sx = (x1 < x2) ? 1 : -1;
-   int sy = (y1 < y2) ? 1 : -1;
-   int err = dx - dy;
-
-   glColor3f(1.0, 1.0, 1.0);
-   glPointSize(5.0); 
+#include <vector>
+#include "GLRasterTarget.h"
+#include "BresenhamBatch.h"
+
+// Pixels visible through the gluOrtho2D() projection set in init(); the
+// kernels skip everything outside it
+const ClipRect VIEWPORT = ClipRect::fromOrtho(-10, 10, -10, 10);
+
+// Segments drawn by display(); add entries here to draw more lines
+const LineSegment segments[] = {
+   {1, 5, 2, 8},
+};
+const int NUM_SEGMENTS = sizeof(segments) / sizeof(segments[0]);
+
+// Runs produced by the Bresenham batch, and where each segment's runs start
+std::vector<LineSpan> lineSpans;
+std::vector<size_t> segmentFirstSpan;
+
+// Function to implement Bresenham's Line-Drawing Algorithm (kernel in BresenhamBatch.h).
+// Every segment is stepped once; the runs are kept for both drawing passes.
+void computeLineSpans() {
+   lineSpans.clear();
+   segmentFirstSpan.clear();
+   for (int i = 0; i < NUM_SEGMENTS; i++) {
+       segmentFirstSpan.push_back(lineSpans.size());
+       rasterLinesBresenhamSpans(&segments[i], 1, VIEWPORT, lineSpans);
+   }
+   segmentFirstSpan.push_back(lineSpans.size());
 
    std::cout << "Calculated Points:\n";
+   for (const LineSpan &span : lineSpans) {
+       for (int i = 0; i < span.length; i++) {
+           int x = span.vertical ? span.x : span.x + span.dir * i;
+           int y = span.vertical ? span.y + span.dir * i : span.y;
+           std::cout << "(" << x << ", " << y << ")\n"; // Print the point to the terminal
+       }
+   }
+}
 
-   glBegin(GL_POINTS);
-   while (true) {
-       glVertex2i(x1, y1); 
-       std::cout << "(" << x1 << ", " << y1 << ")\n"; // Print the point to the terminal
-
-       if (x1 == x2 && y1 == y2) break; // Exit loop when the endpoint is reached
+// Draw the computed runs as points, then connect them with a line strip per segment
+void drawLinesBresenham() {
+   glColor3f(1.0, 1.0, 1.0); // Set line color to white
+   glPointSize(5.0); // Enlarge the plotted points
 
-       int e2 = 2 * err;
-       if (e2 > -dy) {
-           err -= dy;
-           x1 += sx;
-       }
-       if (e2 < dx) {
-           err += dx;
-           y1 += sy;
+   GLVertexTarget points;
+   points.echo = false; // Already printed by computeLineSpans()
+   glBegin(GL_POINTS);
+   for (const LineSpan &span : lineSpans) {
+       for (int i = 0; i < span.length; i++) {
+           if (span.vertical) points.plot(span.x, span.y + span.dir * i);
+           else points.plot(span.x + span.dir * i, span.y);
        }
    }
    glEnd();
 
-   // Draw a line connecting the points
-   glBegin(GL_LINE_STRIP);
-   x1 = x1, y1 = y1;
-   int x = x1, y = y1;
-   err = dx - dy;
-   while (true) {
-       glVertex2i(x, y);
-
-       if (x == x2 && y == y2) break;
-
-       int e2 = 2 * err;
-       if (e2 > -dy) {
-           err -= dy;
-           x += sx;
-       }
-       if (e2 < dx) {
-           err += dx;
-           y += sy;
+   // Draw a line connecting the points: a run is straight, so only its ends are needed
+   for (int s = 0; s < NUM_SEGMENTS; s++) {
+       glBegin(GL_LINE_STRIP);
+       for (size_t i = segmentFirstSpan[s]; i < segmentFirstSpan[s + 1]; i++) {
+           const LineSpan &span = lineSpans[i];
+           glVertex2i(span.x, span.y);
+           if (span.length > 1) glVertex2i(span.lastX(), span.lastY());
        }
+       glEnd();
    }
-   glEnd();
 
    glFlush();
 }
@@ -125,7 +136,7 @@ void display() {
    glClear(GL_COLOR_BUFFER_BIT);
 
    drawCartesianPlane(); // Draw the Cartesian plane
-   drawLineBresenham(1, 5, 2, 8); // Draw the Bresenham line
+   drawLinesBresenham(); // Draw the Bresenham lines
 
    glFlush();
 }
@@ -135,6 +146,7 @@ void init() {
    glClearColor(0.0, 0.0, 0.0, 1.0); // Set background to black
    glMatrixMode(GL_PROJECTION);
    gluOrtho2D(-10, 10, -10, 10); // Define coordinate system (Cartesian plane)
+   computeLineSpans(); // Rasterize the segments once, not on every redisplay
 }
 
 // Main function
@@ -0,0 +1,257 @@
+// lineBenchmark.cpp
+//
+// Headless benchmark of the line kernels in this folder. Every kernel draws
+// the same segment sets into a RasterTarget (no window or GL context) and the
+// program reports pixels/s, segments/s, ns/pixel and, on Linux, last-level
+// cache misses per 1000 pixels read from perf_event_open.
+//
+// Build: g++ -O2 -std=c++17 lineBenchmark.cpp -o lineBenchmark -pthread
+//        (add -mavx2 or -msse4.1 for the SIMD DDA)
+// Run:   ./lineBenchmark [segments per set] [repeats]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BresenhamBatch.h"
+#include "DDASimd.h"
+#include "GuptaSproull.h"
+#include "LineKernels.h"
+#include "RasterTarget.h"
+#include "TiledRaster.h"
+#include "WuFixed.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+const int CANVAS_SIZE = 1024; // Canvas covers [-512, 511] on both axes
+const ClipRect CANVAS = {-CANVAS_SIZE / 2, -CANVAS_SIZE / 2, CANVAS_SIZE / 2 - 1, CANVAS_SIZE / 2 - 1};
+
+// One segment set, in both array-of-structs and structure-of-arrays form
+struct BenchData {
+    std::string name;
+    std::vector<LineSegment> segments;
+    LineSegmentsSoA soa;
+};
+
+// A kernel under test: draws every segment of data into target
+struct BenchKernel {
+    const char *name;
+    bool antiAliased;
+    void (*run)(const BenchData &data, RasterTarget &target);
+};
+
+// Counts last-level cache misses of this thread (and threads it starts) on Linux;
+// available() is false when the counter cannot be opened
+struct CacheMissCounter {
+    int fd = -1;
+
+    CacheMissCounter() {
+#ifdef __linux__
+        perf_event_attr attr = {};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = int(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~CacheMissCounter() {
+#ifdef __linux__
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+#ifdef __linux__
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    uint64_t stop() {
+        uint64_t count = 0;
+#ifdef __linux__
+        if (fd < 0) return 0;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != sizeof(count)) count = 0;
+#endif
+        return count;
+    }
+};
+
+// Function to generate count segments whose length and direction come from pick(rng, dx, dy).
+// Endpoints lie in [-half, half - 1]; a half beyond the canvas makes segments that cross its edges.
+template <class Pick>
+BenchData makeSegments(const std::string &name, size_t count, unsigned seed, Pick pick, int half = CANVAS_SIZE / 2) {
+    BenchData data;
+    data.name = name;
+    std::mt19937 rng(seed);
+    while (data.segments.size() < count) {
+        int dx, dy;
+        pick(rng, dx, dy);
+        // Place the segment so both endpoints are on the canvas
+        int xLo = -half + std::max(0, -dx), xHi = half - 1 - std::max(0, dx);
+        int yLo = -half + std::max(0, -dy), yHi = half - 1 - std::max(0, dy);
+        if (xLo > xHi || yLo > yHi) continue;
+        int x = std::uniform_int_distribution<int>(xLo, xHi)(rng);
+        int y = std::uniform_int_distribution<int>(yLo, yHi)(rng);
+        data.segments.push_back({x, y, x + dx, y + dy});
+    }
+    data.soa.reserve(count);
+    for (const LineSegment &s : data.segments) data.soa.push_back(s);
+    return data;
+}
+
+// Random direction with length in [minLength, maxLength] and |dy| / |dx| in [minSlope, maxSlope]
+auto segmentShape(double minLength, double maxLength, double minSlope, double maxSlope) {
+    return [=](std::mt19937 &rng, int &dx, int &dy) {
+        double length = std::uniform_real_distribution<double>(minLength, maxLength)(rng);
+        double angle = std::atan(std::uniform_real_distribution<double>(minSlope, maxSlope)(rng));
+        int quadrant = std::uniform_int_distribution<int>(0, 3)(rng);
+        dx = int(std::lround(length * std::cos(angle))) * ((quadrant & 1) ? -1 : 1);
+        dy = int(std::lround(length * std::sin(angle))) * ((quadrant & 2) ? -1 : 1);
+    };
+}
+
+// Width-2 table shared by the Gupta-Sproull runs
+const GuptaSproullTable &benchGuptaSproullTable() {
+    static GuptaSproullTable table(2.0f);
+    return table;
+}
+
+// Function to run one kernel over a segment set, keeping the fastest of repeats runs.
+// Returns the segments drawn per second.
+double runBenchmark(const BenchKernel &kernel, const BenchData &data, RasterTarget &target, int repeats,
+                  CacheMissCounter &misses) {
+    double best = 1e30;
+    uint64_t bestMisses = 0;
+    size_t pixels = 0;
+    for (int r = 0; r < repeats; r++) {
+        target.clear();
+        misses.start();
+        auto t0 = std::chrono::steady_clock::now();
+        kernel.run(data, target);
+        auto t1 = std::chrono::steady_clock::now();
+        uint64_t m = misses.stop();
+        double seconds = std::chrono::duration<double>(t1 - t0).count();
+        if (seconds < best) {
+            best = seconds;
+            bestMisses = m;
+        }
+        pixels = target.pixelsWritten;
+    }
+
+    double segments = double(data.segments.size());
+    std::printf("%-10s %-22s %10.1f %10.2f %10.2f", data.name.c_str(), kernel.name, pixels / best / 1e6,
+                segments / best / 1e6, best * 1e9 / std::max<double>(1.0, double(pixels)));
+    if (misses.available()) std::printf(" %12.2f\n", 1000.0 * double(bestMisses) / std::max<double>(1.0, double(pixels)));
+    else std::printf(" %12s\n", "-");
+    return segments / best;
+}
+
+int main(int argc, char **argv) {
+    size_t count = argc > 1 ? size_t(std::strtoul(argv[1], nullptr, 10)) : 200000;
+    int repeats = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+
+    std::vector<BenchData> sets;
+    sets.push_back(makeSegments("short", count, 1, segmentShape(1.0, 8.0, 0.0, 1e3)));
+    sets.push_back(makeSegments("long", count / 50 + 1, 2, segmentShape(200.0, 900.0, 0.0, 1e3)));
+    sets.push_back(makeSegments("shallow", count / 5 + 1, 3, segmentShape(20.0, 120.0, 0.0, 0.25)));
+    sets.push_back(makeSegments("steep", count / 5 + 1, 4, segmentShape(20.0, 120.0, 4.0, 1e3)));
+    sets.push_back(makeSegments("mixed", count / 5 + 1, 5, segmentShape(1.0, 300.0, 0.0, 1e3)));
+    // Zoomed-in view: long segments over an area 16x the canvas, most of them partly or wholly off-screen
+    sets.push_back(makeSegments("zoomed", count / 20 + 1, 6, segmentShape(500.0, 8000.0, 0.0, 1e3), 8 * CANVAS_SIZE));
+
+    const BenchKernel kernels[] = {
+        {"DDA", false, [](const BenchData &d, RasterTarget &t) {
+             for (const LineSegment &s : d.segments) rasterLineDDA(s.x1, s.y1, s.x2, s.y2, t);
+         }},
+        {"DDA clipped", false, [](const BenchData &d, RasterTarget &t) {
+             for (const LineSegment &s : d.segments) rasterLineDDAClipped(s.x1, s.y1, s.x2, s.y2, CANVAS, t);
+         }},
+        {"DDA batch (SIMD)", false, [](const BenchData &d, RasterTarget &t) { rasterLinesDDA(d.soa, t); }},
+        {"Bresenham", false, [](const BenchData &d, RasterTarget &t) {
+             for (const LineSegment &s : d.segments) rasterLineBresenham(s.x1, s.y1, s.x2, s.y2, t);
+         }},
+        {"Bresenham clipped", false, [](const BenchData &d, RasterTarget &t) {
+             for (const LineSegment &s : d.segments) rasterLineBresenhamClipped(s.x1, s.y1, s.x2, s.y2, CANVAS, t);
+         }},
+        {"Bresenham spans", false, [](const BenchData &d, RasterTarget &t) {
+             rasterLinesBresenham(d.segments.data(), d.segments.size(), t);
+         }},
+        {"Bresenham tiled", false, [](const BenchData &d, RasterTarget &t) {
+             rasterLinesTiled(d.segments.data(), d.segments.size(), t);
+         }},
+        {"Midpoint", false, [](const BenchData &d, RasterTarget &t) {
+             for (const LineSegment &s : d.segments) rasterLineMidpoint(s.x1, s.y1, s.x2, s.y2, t);
+         }},
+        {"Midpoint clipped", false, [](const BenchData &d, RasterTarget &t) {
+             for (const LineSegment &s : d.segments) rasterLineMidpointClipped(s.x1, s.y1, s.x2, s.y2, CANVAS, t);
+         }},
+        {"Wu (float)", true, [](const BenchData &d, RasterTarget &t) {
+             for (const LineSegment &s : d.segments) rasterLineXiaolinWu(s.x1, s.y1, s.x2, s.y2, t);
+         }},
+        {"Wu (16.16)", true, [](const BenchData &d, RasterTarget &t) {
+             for (const LineSegment &s : d.segments) rasterLineWuFixed(s.x1, s.y1, s.x2, s.y2, t);
+         }},
+        {"Wu (16.16) clipped", true, [](const BenchData &d, RasterTarget &t) {
+             for (const LineSegment &s : d.segments) rasterLineWuFixedClipped(s.x1, s.y1, s.x2, s.y2, CANVAS, t);
+         }},
+        {"Wu (16.16) tiled", true, [](const BenchData &d, RasterTarget &t) {
+             TiledRasterOptions options;
+             options.kernel = TileKernel::XiaolinWuFixed;
+             rasterLinesTiled(d.segments.data(), d.segments.size(), t, options);
+         }},
+        {"Gupta-Sproull 3x3", true, [](const BenchData &d, RasterTarget &t) {
+             for (const LineSegment &s : d.segments) rasterLineGuptaSproull(s.x1, s.y1, s.x2, s.y2, t);
+         }},
+        {"Gupta-Sproull table", true, [](const BenchData &d, RasterTarget &t) {
+             const GuptaSproullTable &table = benchGuptaSproullTable();
+             for (const LineSegment &s : d.segments) rasterLineGuptaSproullThick(s.x1, s.y1, s.x2, s.y2, table, t);
+         }},
+        {"Gupta-Sproull clipped", true, [](const BenchData &d, RasterTarget &t) {
+             const GuptaSproullTable &table = benchGuptaSproullTable();
+             for (const LineSegment &s : d.segments)
+                 rasterLineGuptaSproullThickClipped(s.x1, s.y1, s.x2, s.y2, table, CANVAS, t);
+         }},
+    };
+
+    RasterTarget target = RasterTarget::forWindow(-CANVAS_SIZE / 2, CANVAS_SIZE / 2 - 1, -CANVAS_SIZE / 2, CANVAS_SIZE / 2 - 1);
+    CacheMissCounter misses;
+
+    std::printf("Canvas %dx%d, DDA lanes %d, best of %d runs%s\n", CANVAS_SIZE, CANVAS_SIZE, DDA_LANES, repeats,
+                misses.available() ? "" : " (cache-miss counter unavailable)");
+    std::printf("%-10s %-22s %10s %10s %10s %12s\n", "segments", "kernel", "Mpixel/s", "Mseg/s", "ns/pixel", "LLC miss/1k");
+    for (const BenchData &data : sets) {
+        // Fastest solid and anti-aliased kernel for this segment set
+        const char *bestName[2] = {"", ""};
+        double bestRate[2] = {0.0, 0.0};
+        for (const BenchKernel &kernel : kernels) {
+            double rate = runBenchmark(kernel, data, target, repeats, misses);
+            if (rate > bestRate[kernel.antiAliased]) {
+                bestRate[kernel.antiAliased] = rate;
+                bestName[kernel.antiAliased] = kernel.name;
+            }
+        }
+        std::printf("%-10s fastest solid: %s, fastest anti-aliased: %s\n\n", data.name.c_str(), bestName[0], bestName[1]);
+    }
+    return 0;
+}
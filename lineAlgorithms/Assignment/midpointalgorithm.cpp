@@ -2,59 +2,31 @@
 #include <iostream>
 #include <cmath>
 #include <string>
+#include "GLRasterTarget.h"
+#include "LineKernels.h"
+
+// Pixels visible through the gluOrtho2D() projection set in init(); the
+// kernels skip everything outside it
+const ClipRect VIEWPORT = ClipRect::fromOrtho(-10, 10, -10, 10);
 
 // Function to implement the Midpoint Line Drawing Algorithm
+// (this version steps with the Bresenham error term from LineKernels.h)
 void drawLineMidpoint(int x1, int y1, int x2, int y2) {
-    int dx = abs(x2 - x1);
-    int dy = abs(y2 - y1);
-    int sx = (x1 < x2) ? 1 : -1;
-    int sy = (y1 < y2) ? 1 : -1;
-    int err = dx - dy;
+    std::cout << "Calculated Points:\n";
 
     glColor3f(1.0, 1.0, 1.0); // Set line color to white
     glPointSize(5.0); // Enlarge the plotted points
 
-    std::cout << "Calculated Points:\n";
-
+    GLVertexTarget points;
     glBegin(GL_POINTS);
-    while (true) {
-        glVertex2i(x1, y1); // Plot the pixel
-        std::cout << "(" << x1 << ", " << y1 << ")\n"; // Print the point to the terminal
-
-        if (x1 == x2 && y1 == y2) break; // Exit loop when the endpoint is reached
-
-        int e2 = 2 * err;
-        if (e2 > -dy) {
-            err -= dy;
-            x1 += sx;
-        }
-        if (e2 < dx) {
-            err += dx;
-            y1 += sy;
-        }
-    }
+    rasterLineBresenhamClipped(x1, y1, x2, y2, VIEWPORT, points);
     glEnd();
 
     // Draw a line connecting the points
+    GLVertexTarget strip;
+    strip.echo = false;
     glBegin(GL_LINE_STRIP);
-    x1 = x1, y1 = y1;
-    int x = x1, y = y1;
-    err = dx - dy;
-    while (true) {
-        glVertex2i(x, y);
-
-        if (x == x2 && y == y2) break;
-
-        int e2 = 2 * err;
-        if (e2 > -dy) {
-            err -= dy;
-            x += sx;
-        }
-        if (e2 < dx) {
-            err += dx;
-            y += sy;
-        }
-    }
+    rasterLineBresenhamClipped(x1, y1, x2, y2, VIEWPORT, strip);
     glEnd();
 
     glFlush();
@@ -0,0 +1,1752 @@
+// rasterOracle.cpp
+//
+// Headless correctness check for every rasterizer in the repo: the line
+// kernels in this folder and the circle, ellipse and parabola kernels of
+// CAT1 OpenGl. Each kernel is run on randomized inputs and its pixels are
+// compared against the ideal curve (or a double-precision reference) with a
+// tolerance chosen for that algorithm. Optimized variants (spans, SIMD,
+// clipped, tiled) must reproduce the pixels of the kernel they replace
+// exactly. No window or GL context is needed; the exit status is 0 only when
+// every check passes.
+//
+// Build: g++ -O2 -std=c++17 rasterOracle.cpp -o rasterOracle -pthread
+// Run:   ./rasterOracle [trials per check] [seed]
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BresenhamBatch.h"
+#include "DDASimd.h"
+#include "GuptaSproull.h"
+#include "LineKernels.h"
+#include "RasterTarget.h"
+#include "TiledRaster.h"
+#include "WuFixed.h"
+
+#include "../StripLayout.h"
+
+#include "../../CAT1 OpenGl/Affine2D.h"
+#include "../../CAT1 OpenGl/ArcTessellation.h"
+#include "../../CAT1 OpenGl/FloodFill.h"
+#include "../../CAT1 OpenGl/RegionFill.h"
+#include "../../CAT1 OpenGl/QUESTION 1- Circle Drawing and triangle/BresenhamCircle.h"
+#include "../../CAT1 OpenGl/QUESTION 1- Circle Drawing and triangle/Circumcircle.h"
+#include "../../CAT1 OpenGl/QUESTION 1- Circle Drawing and triangle/Delaunay.h"
+#include "../../CAT1 OpenGl/QUESTION 2- Ellipse drawing/MidpointEllipse.h"
+#include "../../CAT1 OpenGl/QUESTION 4- Polygon drawing/PointInPolygon.h"
+#include "../../CAT1 OpenGl/QUESTION 4- Polygon drawing/ScanlinePolygon.h"
+#include "../../CAT1 OpenGl/QUESTION 4- Polygon drawing/Triangulate.h"
+#include "../../CAT1 OpenGl/QUESTION 5-PARABOLA Drawing/MidpointConic.h"
+#include "../../Group9_PieChart/PieGeometry.h"
+
+typedef std::pair<int, int> Pixel;
+
+// Records solid pixels in plotting order
+struct PixelList {
+    std::vector<Pixel> pixels;
+
+    void plot(int x, int y) { pixels.push_back({x, y}); }
+};
+
+// Sums coverage per pixel, from either plot(x, y, intensity) or accumulate()
+struct CoverageMap {
+    std::map<Pixel, double> coverage;
+    std::vector<Pixel> solid; // plot(x, y) and plot(x, y, 1.0f) pixels
+
+    void plot(int x, int y) { solid.push_back({x, y}); }
+
+    void plot(int x, int y, float intensity) {
+        if (intensity >= 1.0f) solid.push_back({x, y});
+        if (intensity > 0.0f) coverage[{x, y}] += intensity;
+    }
+
+    void accumulate(int x, int y, uint32_t amount) { coverage[{x, y}] += amount / 65536.0; }
+};
+
+// Result of one trial: empty when it passed
+typedef std::string Failure;
+
+// Function to format a failure message with the offending input
+template <class... Args>
+Failure failure(const char *format, Args... args) {
+    char text[256];
+    std::snprintf(text, sizeof(text), format, args...);
+    return text;
+}
+
+std::vector<Pixel> sorted(std::vector<Pixel> pixels) {
+    std::sort(pixels.begin(), pixels.end());
+    return pixels;
+}
+
+std::vector<Pixel> insideClip(const std::vector<Pixel> &pixels, const ClipRect &clip) {
+    std::vector<Pixel> kept;
+    for (const Pixel &p : pixels) {
+        if (clip.contains(p.first, p.second)) kept.push_back(p);
+    }
+    return kept;
+}
+
+std::map<Pixel, double> insideClip(const std::map<Pixel, double> &coverage, const ClipRect &clip) {
+    std::map<Pixel, double> kept;
+    for (const auto &entry : coverage) {
+        if (clip.contains(entry.first.first, entry.first.second)) kept.insert(entry);
+    }
+    return kept;
+}
+
+// ---------------------------------------------------------------------------
+// Random inputs
+
+// Segment with endpoints in [-range, range]; every 8th one is axis-aligned, diagonal or a point
+LineSegment randomSegment(std::mt19937 &rng, int range) {
+    std::uniform_int_distribution<int> coord(-range, range);
+    LineSegment s = {coord(rng), coord(rng), coord(rng), coord(rng)};
+    switch (std::uniform_int_distribution<int>(0, 31)(rng)) {
+    case 0: s.y2 = s.y1; break;
+    case 1: s.x2 = s.x1; break;
+    case 2: s.y2 = s.y1 + (s.x2 - s.x1); break;
+    case 3: s.x2 = s.x1, s.y2 = s.y1; break;
+    }
+    return s;
+}
+
+ClipRect randomClip(std::mt19937 &rng, int range) {
+    std::uniform_int_distribution<int> coord(-range, range);
+    int x0 = coord(rng), x1 = coord(rng), y0 = coord(rng), y1 = coord(rng);
+    return {std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1)};
+}
+
+// ---------------------------------------------------------------------------
+// Solid lines
+
+// One pixel per step along the major axis, the endpoints included, and every
+// pixel within maxError of the ideal line measured along the minor axis
+Failure checkSolidLine(const std::vector<Pixel> &pixels, const LineSegment &s, double maxError) {
+    int dx = std::abs(s.x2 - s.x1), dy = std::abs(s.y2 - s.y1);
+    bool xMajor = dx >= dy;
+    int major = std::max(dx, dy);
+    if (int(pixels.size()) != major + 1)
+        return failure("(%d,%d)-(%d,%d): %zu pixels, expected %d", s.x1, s.y1, s.x2, s.y2, pixels.size(), major + 1);
+
+    std::set<int> steps;
+    for (const Pixel &p : pixels) {
+        int u = xMajor ? p.first : p.second, v = xMajor ? p.second : p.first;
+        int u1 = xMajor ? s.x1 : s.y1, v1 = xMajor ? s.y1 : s.x1;
+        int u2 = xMajor ? s.x2 : s.y2, v2 = xMajor ? s.y2 : s.x2;
+        if (u < std::min(u1, u2) || u > std::max(u1, u2) || !steps.insert(u).second)
+            return failure("(%d,%d)-(%d,%d): stray or repeated pixel (%d,%d)", s.x1, s.y1, s.x2, s.y2, p.first, p.second);
+        double ideal = (u1 == u2) ? v1 : v1 + double(v2 - v1) * (u - u1) / (u2 - u1);
+        if (std::fabs(v - ideal) > maxError + 1e-9)
+            return failure("(%d,%d)-(%d,%d): pixel (%d,%d) is %.4f from the line", s.x1, s.y1, s.x2, s.y2, p.first,
+                           p.second, std::fabs(v - ideal));
+    }
+    std::vector<Pixel> all = sorted(pixels);
+    if (!std::binary_search(all.begin(), all.end(), Pixel(s.x1, s.y1)) ||
+        !std::binary_search(all.begin(), all.end(), Pixel(s.x2, s.y2)))
+        return failure("(%d,%d)-(%d,%d): endpoint missing", s.x1, s.y1, s.x2, s.y2);
+    return "";
+}
+
+// maxError grows by driftPerStep for every step along the major axis
+template <class Kernel>
+Failure checkLineKernel(std::mt19937 &rng, double maxError, double driftPerStep, int range, Kernel kernel) {
+    LineSegment s = randomSegment(rng, range);
+    PixelList list;
+    kernel(s, list);
+    int major = std::max(std::abs(s.x2 - s.x1), std::abs(s.y2 - s.y1));
+    return checkSolidLine(list.pixels, s, maxError + driftPerStep * major);
+}
+
+Failure checkDDA(std::mt19937 &rng) {
+    // Float increments are rounded to the precision of coordinates up to 4096,
+    // and the rounding error of every add accumulates along the line
+    return checkLineKernel(rng, 0.5, 1.0 / 4096.0, 2000, [](const LineSegment &s, PixelList &t) {
+        rasterLineDDA(s.x1, s.y1, s.x2, s.y2, t);
+    });
+}
+
+Failure checkBresenham(std::mt19937 &rng) {
+    return checkLineKernel(rng, 0.5, 0.0, 2000, [](const LineSegment &s, PixelList &t) {
+        rasterLineBresenham(s.x1, s.y1, s.x2, s.y2, t);
+    });
+}
+
+Failure checkMidpoint(std::mt19937 &rng) {
+    return checkLineKernel(rng, 0.5, 0.0, 2000, [](const LineSegment &s, PixelList &t) {
+        rasterLineMidpoint(s.x1, s.y1, s.x2, s.y2, t);
+    });
+}
+
+// Function to plot every pixel of a span, in drawing order
+void plotSpan(const LineSpan &run, PixelList &target) {
+    for (int i = 0; i < run.length; i++) {
+        if (run.vertical) target.plot(run.x, run.y + run.dir * i);
+        else target.plot(run.x + run.dir * i, run.y);
+    }
+}
+
+// Run-length spans cover exactly the per-pixel Bresenham pixels
+Failure checkBresenhamSpans(std::mt19937 &rng) {
+    LineSegment s = randomSegment(rng, 300);
+    PixelList reference, spans;
+    rasterLineBresenham(s.x1, s.y1, s.x2, s.y2, reference);
+    bresenhamRuns(s, [&spans](const LineSpan &run) { plotSpan(run, spans); });
+    if (spans.pixels != reference.pixels) return failure("(%d,%d)-(%d,%d): spans differ", s.x1, s.y1, s.x2, s.y2);
+    return "";
+}
+
+// A clipped kernel draws the unclipped pixels that are inside the rectangle,
+// in the same order. Segments reach well past the rectangle so that most of
+// them enter or leave it.
+template <class Full, class Clipped>
+Failure checkClippedKernel(std::mt19937 &rng, Full full, Clipped clipped) {
+    LineSegment s = randomSegment(rng, 2000);
+    ClipRect clip = randomClip(rng, 300);
+    PixelList all, kept;
+    full(s, all);
+    clipped(s, clip, kept);
+    if (kept.pixels != insideClip(all.pixels, clip))
+        return failure("(%d,%d)-(%d,%d) clip [%d,%d]x[%d,%d]: differs from the unclipped line", s.x1, s.y1, s.x2, s.y2,
+                       clip.xMin, clip.xMax, clip.yMin, clip.yMax);
+    return "";
+}
+
+Failure checkDDAClipped(std::mt19937 &rng) {
+    return checkClippedKernel(
+        rng, [](const LineSegment &s, PixelList &t) { rasterLineDDA(s.x1, s.y1, s.x2, s.y2, t); },
+        [](const LineSegment &s, const ClipRect &c, PixelList &t) { rasterLineDDAClipped(s.x1, s.y1, s.x2, s.y2, c, t); });
+}
+
+Failure checkBresenhamClipped(std::mt19937 &rng) {
+    return checkClippedKernel(
+        rng, [](const LineSegment &s, PixelList &t) { rasterLineBresenham(s.x1, s.y1, s.x2, s.y2, t); },
+        [](const LineSegment &s, const ClipRect &c, PixelList &t) {
+            rasterLineBresenhamClipped(s.x1, s.y1, s.x2, s.y2, c, t);
+        });
+}
+
+Failure checkMidpointClipped(std::mt19937 &rng) {
+    return checkClippedKernel(
+        rng, [](const LineSegment &s, PixelList &t) { rasterLineMidpoint(s.x1, s.y1, s.x2, s.y2, t); },
+        [](const LineSegment &s, const ClipRect &c, PixelList &t) { rasterLineMidpointClipped(s.x1, s.y1, s.x2, s.y2, c, t); });
+}
+
+Failure checkBresenhamSpansClipped(std::mt19937 &rng) {
+    return checkClippedKernel(
+        rng, [](const LineSegment &s, PixelList &t) { rasterLineBresenham(s.x1, s.y1, s.x2, s.y2, t); },
+        [](const LineSegment &s, const ClipRect &c, PixelList &t) {
+            std::vector<LineSpan> spans;
+            rasterLinesBresenhamSpans(&s, 1, c, spans);
+            for (const LineSpan &run : spans) plotSpan(run, t);
+        });
+}
+
+// The SIMD batch gives every segment the pixels of the scalar DDA
+Failure checkDDABatch(std::mt19937 &rng) {
+    LineSegmentsSoA lines;
+    PixelList scalar, batch;
+    for (int i = 0; i < 3 * DDA_LANES + 1; i++) {
+        LineSegment s = randomSegment(rng, 500);
+        lines.push_back(s);
+        rasterLineDDA(s.x1, s.y1, s.x2, s.y2, scalar);
+    }
+    rasterLinesDDA(lines, batch);
+    if (sorted(batch.pixels) != sorted(scalar.pixels)) return failure("batch of %zu segments differs", lines.size());
+    return "";
+}
+
+// Tiled rasterization equals drawing the segments one after another
+Failure checkTiled(std::mt19937 &rng) {
+    std::vector<LineSegment> segments;
+    for (int i = 0; i < 200; i++) segments.push_back(randomSegment(rng, 150));
+    // Lines running out to the end of the int range, where adding the
+    // buffer origin overflows int
+    std::uniform_int_distribution<int> inside(0, 127), far(INT_MAX - 127, INT_MAX);
+    for (int i = 0; i < 4; i++) {
+        int x = inside(rng), y = inside(rng), f = far(rng), g = inside(rng);
+        segments.push_back(i % 2 ? LineSegment{x, y, f, g} : LineSegment{x, y, g, f});
+    }
+    const ClipRect window = {-128, -128, 127, 127};
+    const TileKernel kernels[] = {TileKernel::Bresenham, TileKernel::XiaolinWu, TileKernel::XiaolinWuFixed};
+    for (TileKernel kernel : kernels) {
+        RasterTarget serial = RasterTarget::forWindow(-128, 127, -128, 127), tiled = serial;
+        for (const LineSegment &s : segments) {
+            if (kernel == TileKernel::Bresenham) rasterLineBresenhamClipped(s.x1, s.y1, s.x2, s.y2, window, serial);
+            else if (kernel == TileKernel::XiaolinWu) rasterLineXiaolinWuClipped(s.x1, s.y1, s.x2, s.y2, window, serial);
+            else rasterLineWuFixedClipped(s.x1, s.y1, s.x2, s.y2, window, serial);
+        }
+        TiledRasterOptions options;
+        options.kernel = kernel;
+        options.tileSize = 32;
+        options.threads = 3;
+        rasterLinesTiled(segments.data(), segments.size(), tiled, options);
+        if (tiled.rgba != serial.rgba || tiled.coverage != serial.coverage)
+            return failure("tiled kernel %d differs from serial", int(kernel));
+    }
+    return "";
+}
+
+// Line strips streamed through ring regions the way PolylineStream.h does:
+// every segment of every strip is drawn exactly once and no segment joins
+// two strips, also when a strip begins exactly on a full region
+Failure checkStripLayout(std::mt19937 &rng) {
+    std::uniform_int_distribution<int> pick(0, 99);
+    const int regionVerts = 2 + pick(rng) % 15, regions = 3;
+    std::vector<std::pair<int, int>> ring(regions * regionVerts); // (strip, vertex)
+    std::map<std::pair<int, int>, int> drawn;                       // Segment (strip, from vertex) -> times
+    StripLayout layout;
+    layout.setup(regionVerts);
+    int region = 0;
+    bool mapped = false;
+    std::pair<int, int> last(-1, -1);
+    Failure bad;
+
+    auto beginRegion = [&]() {
+        mapped = true;
+        return layout.openRegion(region * regionVerts);
+    };
+    auto submitRegion = [&]() {
+        layout.closeRegion();
+        for (size_t d = 0; d < layout.firsts().size(); d++)
+            for (int k = 1; k < layout.counts()[d]; k++) {
+                std::pair<int, int> a = ring[layout.firsts()[d] + k - 1], b = ring[layout.firsts()[d] + k];
+                if (b.first != a.first || b.second != a.second + 1) {
+                    if (bad.empty())
+                        bad = failure("region of %d: segment from strip %d vertex %d to strip %d vertex %d", regionVerts,
+                                      a.first, a.second, b.first, b.second);
+                }
+                else drawn[a]++;
+            }
+        layout.clearDraws();
+        mapped = false;
+        region = (region + 1) % regions;
+    };
+    auto addVertex = [&](std::pair<int, int> v) {
+        if (!mapped) {
+            beginRegion();
+            layout.beginStrip();
+        }
+        else if (layout.full()) {
+            submitRegion();
+            if (beginRegion()) ring[region * regionVerts + layout.add()] = last;
+        }
+        last = v;
+        ring[region * regionVerts + layout.add()] = v;
+    };
+
+    // Strips of exactly a region first, so later ones begin on full regions
+    std::vector<int> lengths;
+    for (int i = 0; i < 3; i++) lengths.push_back(regionVerts);
+    for (int i = 0; i < 40; i++) lengths.push_back(pick(rng) % 3 == 0 ? regionVerts : pick(rng) % (3 * regionVerts));
+    for (size_t strip = 0; strip < lengths.size(); strip++) {
+        if (!mapped) beginRegion();
+        layout.beginStrip();
+        for (int k = 0; k < lengths[strip]; k++) addVertex(std::make_pair(int(strip), k));
+        layout.endStrip();
+        if (pick(rng) < 10 && mapped) submitRegion(); // draw() between strips
+    }
+    if (mapped) submitRegion();
+    if (!bad.empty()) return bad;
+
+    for (size_t strip = 0; strip < lengths.size(); strip++)
+        for (int k = 0; k + 1 < lengths[strip]; k++) {
+            int times = drawn.count(std::make_pair(int(strip), k)) ? drawn[std::make_pair(int(strip), k)] : 0;
+            if (times != 1)
+                return failure("region of %d: strip %d segment %d drawn %d times", regionVerts, int(strip), k, times);
+        }
+    return "";
+}
+
+// ---------------------------------------------------------------------------
+// Anti-aliased lines
+
+// Xiaolin Wu in double precision with the textbook endpoint weights
+void referenceWu(double x1, double y1, double x2, double y2, std::map<Pixel, double> &coverage) {
+    bool steep = std::fabs(y2 - y1) > std::fabs(x2 - x1);
+    if (steep) {
+        std::swap(x1, y1);
+        std::swap(x2, y2);
+    }
+    if (x1 > x2) {
+        std::swap(x1, x2);
+        std::swap(y1, y2);
+    }
+    auto plot = [&](double x, double y, double c) {
+        if (c <= 0.0) return;
+        Pixel p = steep ? Pixel(int(y), int(x)) : Pixel(int(x), int(y));
+        coverage[p] += c;
+    };
+    auto fpart = [](double v) { return v - std::floor(v); };
+    double dx = x2 - x1, dy = y2 - y1;
+    double gradient = (dx == 0.0) ? 1.0 : dy / dx;
+
+    double xend = std::floor(x1 + 0.5), yend = y1 + gradient * (xend - x1), xgap = 1.0 - fpart(x1 + 0.5);
+    double xpxl1 = xend;
+    plot(xpxl1, std::floor(yend), (1.0 - fpart(yend)) * xgap);
+    plot(xpxl1, std::floor(yend) + 1, fpart(yend) * xgap);
+    double intery = yend + gradient;
+
+    xend = std::floor(x2 + 0.5), yend = y2 + gradient * (xend - x2), xgap = fpart(x2 + 0.5);
+    double xpxl2 = xend;
+    plot(xpxl2, std::floor(yend), (1.0 - fpart(yend)) * xgap);
+    plot(xpxl2, std::floor(yend) + 1, fpart(yend) * xgap);
+
+    for (double x = xpxl1 + 1; x <= xpxl2 - 1; x++) {
+        plot(x, std::floor(intery), 1.0 - fpart(intery));
+        plot(x, std::floor(intery) + 1, fpart(intery));
+        intery += gradient;
+    }
+}
+
+// Largest per-pixel coverage difference between two maps
+double coverageError(const std::map<Pixel, double> &a, const std::map<Pixel, double> &b, Pixel &worst) {
+    double error = 0.0;
+    auto visit = [&](const std::map<Pixel, double> &from, const std::map<Pixel, double> &other) {
+        for (const auto &entry : from) {
+            auto it = other.find(entry.first);
+            double e = std::fabs(entry.second - (it == other.end() ? 0.0 : it->second));
+            if (e > error) {
+                error = e;
+                worst = entry.first;
+            }
+        }
+    };
+    visit(a, b);
+    visit(b, a);
+    return error;
+}
+
+// Interior columns only: the float kernel keeps the original program's endpoint weights
+Failure checkWuFloat(std::mt19937 &rng) {
+    LineSegment s = randomSegment(rng, 500);
+    if (std::max(std::abs(s.x2 - s.x1), std::abs(s.y2 - s.y1)) < 2) return "";
+    CoverageMap kernel;
+    std::map<Pixel, double> reference;
+    rasterLineXiaolinWu(s.x1, s.y1, s.x2, s.y2, kernel);
+    referenceWu(s.x1, s.y1, s.x2, s.y2, reference);
+    bool xMajor = std::abs(s.x2 - s.x1) >= std::abs(s.y2 - s.y1);
+    auto interior = [&](std::map<Pixel, double> &m) {
+        for (auto it = m.begin(); it != m.end();) {
+            int u = xMajor ? it->first.first : it->first.second;
+            int u1 = xMajor ? s.x1 : s.y1, u2 = xMajor ? s.x2 : s.y2;
+            if (u <= std::min(u1, u2) || u >= std::max(u1, u2)) it = m.erase(it);
+            else ++it;
+        }
+    };
+    interior(kernel.coverage);
+    interior(reference);
+    Pixel worst;
+    double error = coverageError(kernel.coverage, reference, worst);
+    if (error > 2.0 / 255.0)
+        return failure("(%d,%d)-(%d,%d): coverage off by %.4f at (%d,%d)", s.x1, s.y1, s.x2, s.y2, error, worst.first,
+                       worst.second);
+    return "";
+}
+
+// 16.16 kernel with sub-pixel endpoints against the double reference
+Failure checkWuFixed(std::mt19937 &rng) {
+    std::uniform_int_distribution<int32_t> coord(-300 * 65536, 300 * 65536);
+    int32_t fx1 = coord(rng), fy1 = coord(rng), fx2 = coord(rng), fy2 = coord(rng);
+    CoverageMap kernel;
+    std::map<Pixel, double> reference;
+    rasterLineWuFixed16(fx1, fy1, fx2, fy2, kernel);
+    referenceWu(fx1 / 65536.0, fy1 / 65536.0, fx2 / 65536.0, fy2 / 65536.0, reference);
+    Pixel worst;
+    double error = coverageError(kernel.coverage, reference, worst);
+    if (error > 1.0 / 255.0)
+        return failure("16.16 (%d,%d)-(%d,%d): coverage off by %.4f at (%d,%d)", fx1, fy1, fx2, fy2, error, worst.first,
+                       worst.second);
+
+    // The clipped kernel keeps exactly the unclipped samples
+    ClipRect clip = randomClip(rng, 300);
+    CoverageMap clipped;
+    rasterLineWuFixed16Clipped(fx1, fy1, fx2, fy2, clip, clipped);
+    if (clipped.coverage != insideClip(kernel.coverage, clip)) return failure("16.16 (%d,%d)-(%d,%d): clipped line differs", fx1, fy1, fx2, fy2);
+
+    // Coordinates beyond 16.16 saturate
+    std::uniform_int_distribution<int> far(WU_FIXED_MAX_PIXEL + 1, INT_MAX);
+    int big = far(rng);
+    if (toFixed16(big) != INT32_MAX || toFixed16(-big) != INT32_MIN || toFixed16(float(big)) != INT32_MAX ||
+        toFixed16(-float(big)) != INT32_MIN || toFixed16(WU_FIXED_MIN_PIXEL) != INT32_MIN)
+        return failure("toFixed16(%d) does not saturate", big);
+
+    // A whole-pixel line from inside clip to far off the canvas still draws
+    // its visible part; the reference is the double Wu line cut to a
+    // margin around clip, so its ends stay outside it (clip is well inside
+    // the 16.16 range, so the kernel's own cut ends are too)
+    std::uniform_int_distribution<int> near(-300, 300), sign(0, 1);
+    int ix = std::uniform_int_distribution<int>(clip.xMin, clip.xMax)(rng);
+    int iy = std::uniform_int_distribution<int>(clip.yMin, clip.yMax)(rng);
+    int ox = sign(rng) ? big : -big, oy = near(rng);
+    if (sign(rng)) std::swap(ox, oy);
+    CoverageMap offCanvas;
+    rasterLineWuFixedClipped(ix, iy, ox, oy, clip, offCanvas);
+    double t0, t1, dx = double(ox) - ix, dy = double(oy) - iy;
+    std::map<Pixel, double> visible;
+    if (clipLiangBarsky(ix, iy, ox, oy, clip.grown(3), 0.0, t0, t1))
+        referenceWu(ix + t0 * dx, iy + t0 * dy, ix + t1 * dx, iy + t1 * dy, visible);
+    error = coverageError(offCanvas.coverage, insideClip(visible, clip), worst);
+    if (error > 1.0 / 255.0)
+        return failure("(%d,%d)-(%d,%d), past 16.16: coverage off by %.4f at (%d,%d)", ix, iy, ox, oy, error,
+                       worst.first, worst.second);
+    return "";
+}
+
+// Table kernel against the table read at each pixel's exact distance from the line
+Failure checkGuptaSproullTable(std::mt19937 &rng) {
+    float width = std::uniform_real_distribution<float>(0.5f, 8.0f)(rng);
+    GuptaSproullTable table(width);
+    LineSegment s = randomSegment(rng, 200);
+    CoverageMap kernel;
+    rasterLineGuptaSproullThick(s.x1, s.y1, s.x2, s.y2, table, kernel);
+
+    // One table step is the per-pixel tolerance
+    double step = 0.0;
+    for (size_t i = 1; i < table.amount.size(); i++)
+        step = std::max(step, std::fabs(double(table.amount[i]) - double(table.amount[i - 1])) / 65536.0);
+
+    double dx = s.x2 - s.x1, dy = s.y2 - s.y1;
+    bool xMajor = std::fabs(dx) >= std::fabs(dy);
+    if (dx == 0.0 && dy == 0.0) dx = 1.0;
+    double len = std::hypot(dx, dy);
+    int reach = int(table.amount.size()) / table.resolution + 2;
+    std::map<Pixel, double> reference;
+    for (int u = std::min(xMajor ? s.x1 : s.y1, xMajor ? s.x2 : s.y2); u <= std::max(xMajor ? s.x1 : s.y1, xMajor ? s.x2 : s.y2); u++) {
+        double centre = xMajor ? (dx == 0.0 ? s.y1 : s.y1 + dy * (u - s.x1) / dx) : s.x1 + dx * (u - s.y1) / dy;
+        for (int v = int(std::floor(centre)) - reach; v <= int(std::ceil(centre)) + reach; v++) {
+            int x = xMajor ? u : v, y = xMajor ? v : u;
+            double d = std::fabs((y - s.y1) * dx - (x - s.x1) * dy) / len;
+            size_t i = size_t(d * table.resolution);
+            if (i < table.amount.size() && table.amount[i] > 0) reference[{x, y}] = table.amount[i] / 65536.0;
+        }
+    }
+    Pixel worst;
+    double error = coverageError(kernel.coverage, reference, worst);
+    if (error > step + 1e-6)
+        return failure("(%d,%d)-(%d,%d) width %.2f: coverage off by %.4f at (%d,%d)", s.x1, s.y1, s.x2, s.y2, width,
+                       error, worst.first, worst.second);
+
+    ClipRect clip = randomClip(rng, 200);
+    CoverageMap clipped;
+    rasterLineGuptaSproullThickClipped(s.x1, s.y1, s.x2, s.y2, table, clip, clipped);
+    if (clipped.coverage != insideClip(kernel.coverage, clip))
+        return failure("(%d,%d)-(%d,%d) width %.2f: clipped line differs", s.x1, s.y1, s.x2, s.y2, width);
+    return "";
+}
+
+// The 3x3 kernel's solid centre pixels are the Bresenham line
+Failure checkGuptaSproull3x3(std::mt19937 &rng) {
+    LineSegment s = randomSegment(rng, 200);
+    CoverageMap kernel;
+    PixelList reference;
+    rasterLineGuptaSproull(s.x1, s.y1, s.x2, s.y2, kernel);
+    rasterLineBresenham(s.x1, s.y1, s.x2, s.y2, reference);
+    if (kernel.solid != reference.pixels) return failure("(%d,%d)-(%d,%d): centre pixels differ", s.x1, s.y1, s.x2, s.y2);
+
+    // The clipped kernel keeps exactly the unclipped pixels
+    ClipRect clip = randomClip(rng, 200);
+    CoverageMap clipped;
+    rasterLineGuptaSproullClipped(s.x1, s.y1, s.x2, s.y2, clip, clipped);
+    if (clipped.solid != insideClip(kernel.solid, clip) || clipped.coverage != insideClip(kernel.coverage, clip))
+        return failure("(%d,%d)-(%d,%d): clipped line differs", s.x1, s.y1, s.x2, s.y2);
+    return "";
+}
+
+// ---------------------------------------------------------------------------
+// Curves
+
+// Every pixel within maxError of the curve (distance(x, y)), and every curve
+// sample within maxGap pixels (Chebyshev distance) of some plotted pixel
+template <class Distance>
+Failure checkCurve(const char *name, const std::vector<Pixel> &pixels, Distance distance,
+                   const std::vector<std::pair<double, double>> &samples, double maxError, double maxGap) {
+    for (const Pixel &p : pixels) {
+        double d = distance(p.first, p.second);
+        if (d > maxError) return failure("%s: pixel (%d,%d) is %.4f from the curve", name, p.first, p.second, d);
+    }
+    std::set<Pixel> set(pixels.begin(), pixels.end());
+    int reach = int(std::ceil(maxGap));
+    for (const auto &s : samples) {
+        bool covered = false;
+        int cx = int(std::lround(s.first)), cy = int(std::lround(s.second));
+        for (int x = cx - reach; x <= cx + reach && !covered; x++) {
+            for (int y = cy - reach; y <= cy + reach && !covered; y++) {
+                covered = set.count({x, y}) && std::max(std::fabs(x - s.first), std::fabs(y - s.second)) <= maxGap;
+            }
+        }
+        if (!covered) return failure("%s: gap near (%.2f,%.2f)", name, s.first, s.second);
+    }
+    return "";
+}
+
+Failure checkCircleBresenham(std::mt19937 &rng) {
+    std::uniform_int_distribution<int> coord(-100, 100), size(0, 300);
+    int cx = coord(rng), cy = coord(rng), r = size(rng);
+    PixelList list;
+    rasterCircleBresenham(cx, cy, r, list);
+    std::vector<std::pair<double, double>> samples;
+    int n = 8 * r + 8;
+    for (int i = 0; i < n; i++) {
+        double t = 2.0 * M_PI * i / n;
+        samples.push_back({cx + r * std::cos(t), cy + r * std::sin(t)});
+    }
+    char name[64];
+    std::snprintf(name, sizeof(name), "circle c=(%d,%d) r=%d", cx, cy, r);
+    return checkCurve(name, list.pixels, [&](int x, int y) { return std::fabs(std::hypot(x - cx, y - cy) - r); },
+                      samples, 0.5, 1.0);
+}
+
+// The stamp's outline is the per-pixel circle without repeats, and its disc
+// rows run between the outermost outline pixels of each row
+Failure checkCircleStamp(std::mt19937 &rng) {
+    std::uniform_int_distribution<int> coord(-100, 100), size(0, 300);
+    int cx = coord(rng), cy = coord(rng), r = size(rng);
+    CircleStamp stamp(r);
+    PixelList reference, outline;
+    rasterCircleBresenham(cx, cy, r, reference);
+    plotCircleOutline(stamp, cx, cy, outline);
+    std::vector<Pixel> distinct = sorted(reference.pixels);
+    distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+    std::vector<Pixel> stamped = sorted(outline.pixels);
+    if (stamped != distinct)
+        return failure("stamp c=(%d,%d) r=%d: %zu outline pixels, expected %zu distinct", cx, cy, r, stamped.size(),
+                       distinct.size());
+
+    std::map<int, std::pair<int, int>> rows;
+    for (const Pixel &p : distinct) {
+        auto it = rows.find(p.second);
+        if (it == rows.end()) rows[p.second] = {p.first, p.first};
+        else it->second = {std::min(it->second.first, p.first), std::max(it->second.second, p.first)};
+    }
+    std::vector<CircleSpan> spans(stamp.discSpans());
+    writeDiscSpans(stamp, cx, cy, spans.data());
+    if (spans.size() != rows.size()) return failure("stamp c=(%d,%d) r=%d: %zu disc rows", cx, cy, r, spans.size());
+    for (const CircleSpan &span : spans) {
+        auto it = rows.find(span.y);
+        if (it == rows.end() || it->second != std::make_pair(span.x0, span.x1))
+            return failure("stamp c=(%d,%d) r=%d: disc row %d is %d..%d", cx, cy, r, span.y, span.x0, span.x1);
+    }
+    return "";
+}
+
+// The ordered outline holds the distinct pixels of the circle once each,
+// 8-connected and strictly counter-clockwise from (cx + r, cy), and the
+// stamp's outline is the same sequence
+Failure checkCircleOrdered(std::mt19937 &rng) {
+    std::uniform_int_distribution<int> coord(-100, 100), size(0, 300);
+    int cx = coord(rng), cy = coord(rng), r = size(rng);
+    PixelList reference, ordered, stamped;
+    rasterCircleBresenham(cx, cy, r, reference);
+    rasterCircleOrdered(cx, cy, r, ordered);
+    std::vector<Pixel> distinct = sorted(reference.pixels);
+    distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+    if (sorted(ordered.pixels) != distinct)
+        return failure("ordered c=(%d,%d) r=%d: %zu pixels, expected %zu distinct", cx, cy, r, ordered.pixels.size(),
+                       distinct.size());
+    if (ordered.pixels[0] != Pixel(cx + r, cy)) return failure("ordered c=(%d,%d) r=%d: starts elsewhere", cx, cy, r);
+
+    const std::vector<Pixel> &p = ordered.pixels;
+    double last = -1.0;
+    for (size_t i = 0; i < p.size(); i++) {
+        double angle = std::atan2(double(p[i].second - cy), double(p[i].first - cx));
+        if (angle < 0.0) angle += 2.0 * M_PI;
+        if (angle <= last)
+            return failure("ordered c=(%d,%d) r=%d: (%d,%d) is out of angular order", cx, cy, r, p[i].first, p[i].second);
+        last = angle;
+        const Pixel &next = p[(i + 1) % p.size()];
+        if (p.size() > 1 && std::max(std::abs(next.first - p[i].first), std::abs(next.second - p[i].second)) != 1)
+            return failure("ordered c=(%d,%d) r=%d: (%d,%d) and (%d,%d) are not neighbours", cx, cy, r, p[i].first,
+                           p[i].second, next.first, next.second);
+    }
+
+    plotCircleOutline(CircleStamp(r), cx, cy, stamped);
+    if (stamped.pixels != p) return failure("ordered c=(%d,%d) r=%d: the stamp's outline is in another order", cx, cy, r);
+    return "";
+}
+
+// Euclidean distance from (x, y) to the ellipse with semi-axes a, b centred at
+// the origin (Eberly's method: bisection on the foot point's parameter)
+double ellipseDistance(double a, double b, double x, double y) {
+    x = std::fabs(x);
+    y = std::fabs(y);
+    if (a < b) {
+        std::swap(a, b);
+        std::swap(x, y);
+    }
+    if (b == 0.0) return std::hypot(std::max(0.0, x - a), y); // Segment -a..a
+    if (y == 0.0) {
+        double numer = a * x, denom = a * a - b * b;
+        if (numer >= denom) return std::fabs(x - a);
+        double c = numer / denom;
+        return std::hypot(a * c - x, b * std::sqrt(1.0 - c * c));
+    }
+    if (x == 0.0) return std::fabs(y - b);
+
+    double z0 = x / a, z1 = y / b, g = z0 * z0 + z1 * z1 - 1.0;
+    if (g == 0.0) return 0.0;
+    double r0 = (a / b) * (a / b), n0 = r0 * z0;
+    double s0 = z1 - 1.0, s1 = g < 0.0 ? 0.0 : std::hypot(n0, z1) - 1.0, s = 0.0;
+    for (int i = 0; i < 200; i++) {
+        s = 0.5 * (s0 + s1);
+        if (s == s0 || s == s1) break;
+        double t0 = n0 / (s + r0), t1 = z1 / (s + 1.0);
+        double f = t0 * t0 + t1 * t1 - 1.0;
+        if (f > 0.0) s0 = s;
+        else if (f < 0.0) s1 = s;
+        else break;
+    }
+    return std::hypot(r0 * x / (s + r0) - x, y / (s + 1.0) - y);
+}
+
+Failure checkEllipseMidpoint(std::mt19937 &rng) {
+    // Every fourth ellipse is thin (a semi-axis below 8 pixels)
+    std::uniform_int_distribution<int> coord(-100, 100), size(0, 2000), thin(0, 7);
+    int cx = coord(rng), cy = coord(rng), a = size(rng), b = size(rng);
+    switch (std::uniform_int_distribution<int>(0, 3)(rng)) {
+    case 0: a = thin(rng); break;
+    case 1: b = thin(rng); break;
+    }
+    PixelList list;
+    rasterEllipseMidpoint(cx, cy, a, b, list);
+    std::vector<std::pair<double, double>> samples;
+    int n = 8 * (a + b) + 8;
+    for (int i = 0; i < n; i++) {
+        double t = 2.0 * M_PI * i / n;
+        samples.push_back({cx + a * std::cos(t), cy + b * std::sin(t)});
+    }
+    auto distance = [&](int px, int py) { return ellipseDistance(a, b, px - cx, py - cy); };
+    char name[64];
+    std::snprintf(name, sizeof(name), "ellipse c=(%d,%d) a=%d b=%d", cx, cy, a, b);
+    return checkCurve(name, list.pixels, distance, samples, 0.5, 1.0);
+}
+
+// Ellipse spans run between the outermost outline pixels of each row, and a
+// batch gives every ellipse the spans and outline it gets on its own
+Failure checkEllipseSpans(std::mt19937 &rng) {
+    std::uniform_int_distribution<int> coord(-100, 100), size(0, 300);
+    std::vector<EllipseParams> batch;
+    for (int i = 0; i < 4; i++) {
+        EllipseParams e = {coord(rng), coord(rng), size(rng), size(rng)};
+        batch.push_back(e);
+        if (i == 1) batch.push_back({coord(rng), coord(rng), e.a, e.b}); // Repeated axes reuse the quadrant
+    }
+
+    std::vector<EllipseSpan> single, batched;
+    PixelList outlines, batchedOutlines;
+    for (const EllipseParams &e : batch) {
+        PixelList outline;
+        rasterEllipseMidpoint(e.cx, e.cy, e.a, e.b, outline);
+        outlines.pixels.insert(outlines.pixels.end(), outline.pixels.begin(), outline.pixels.end());
+        size_t first = single.size();
+        rasterEllipseSpans(e.cx, e.cy, e.a, e.b, single);
+
+        std::map<int, std::pair<int, int>> rows;
+        for (const Pixel &p : outline.pixels) {
+            auto it = rows.find(p.second);
+            if (it == rows.end()) rows[p.second] = {p.first, p.first};
+            else it->second = {std::min(it->second.first, p.first), std::max(it->second.second, p.first)};
+        }
+        if (single.size() - first != rows.size())
+            return failure("ellipse c=(%d,%d) a=%d b=%d: %zu spans for %zu rows", e.cx, e.cy, e.a, e.b,
+                           single.size() - first, rows.size());
+        for (size_t i = first; i < single.size(); i++) {
+            auto it = rows.find(single[i].y);
+            if (it == rows.end() || it->second != std::make_pair(single[i].x0, single[i].x1))
+                return failure("ellipse c=(%d,%d) a=%d b=%d: span on row %d is %d..%d", e.cx, e.cy, e.a, e.b,
+                               single[i].y, single[i].x0, single[i].x1);
+        }
+    }
+
+    rasterEllipsesSpans(batch.data(), batch.size(), batched);
+    rasterEllipses(batch.data(), batch.size(), batchedOutlines);
+    bool sameSpans = batched.size() == single.size();
+    for (size_t i = 0; sameSpans && i < single.size(); i++)
+        sameSpans = batched[i].x0 == single[i].x0 && batched[i].x1 == single[i].x1 && batched[i].y == single[i].y;
+    if (!sameSpans) return failure("batch of %zu ellipses: spans differ", batch.size());
+    if (batchedOutlines.pixels != outlines.pixels) return failure("batch of %zu ellipses: outlines differ", batch.size());
+    return "";
+}
+
+// x = y^2 is sampled once per row, so points are exact but not connected
+// x = y^2 as question5Parabola.cpp traces it: the walk from (yMax^2, yMax)
+// to (yMax^2, -yMax) passes through every point (y^2, y) of the curve, in
+// 8-connected steps.
+Failure checkParabolaMidpoint(std::mt19937 &rng) {
+    int yMax = std::uniform_int_distribution<int>(1, 2000)(rng); // 0: start = end, the whole curve
+    std::vector<ConicPixel> points;
+    rasterConicArcPoints(Conic::parabola(0, 0, 1), yMax * yMax, yMax, yMax * yMax, -yMax, ConicClip::unbounded(), points);
+    std::set<int> rows;
+    for (size_t i = 0; i < points.size(); i++) {
+        const ConicPixel &p = points[i];
+        if (p.x == p.y * p.y) rows.insert(p.y);
+        if (i > 0 && (std::abs(p.x - points[i - 1].x) > 1 || std::abs(p.y - points[i - 1].y) > 1))
+            return failure("parabola yMax=%d: gap before (%d,%d)", yMax, p.x, p.y);
+    }
+    if (int(rows.size()) != 2 * yMax + 1)
+        return failure("parabola yMax=%d: %zu of %d curve points", yMax, rows.size(), 2 * yMax + 1);
+    return "";
+}
+
+// Random ellipses (closed), hyperbola and parabola arcs, rotated by
+// Pythagorean angles so the coefficients stay integers. Every pixel lies
+// within a pixel of the curve, consecutive pixels are 8-neighbours, the arc
+// has no gaps, and clipping (with its early exit) keeps exactly the
+// unclipped pixels inside the rectangle.
+Failure checkConic(std::mt19937 &rng) {
+    static const int rotations[][3] = {{1, 0, 1}, {3, 4, 5}, {4, 3, 5}, {5, 12, 13}, {12, 5, 13}, {8, 15, 17}, {-3, 4, 5}, {-15, 8, 17}};
+    const int *rot = rotations[std::uniform_int_distribution<int>(0, 7)(rng)];
+    long long p = rot[0], q = rot[1], r = rot[2];
+    double cosR = double(p) / r, sinR = double(q) / r;
+    std::uniform_int_distribution<int> centre(-200, 200), axis(3, 300), kind(0, 3);
+    long long cx = centre(rng), cy = centre(rng), a = axis(rng), b = axis(rng);
+    int shape = kind(rng); // 0, 1 ellipse, 2 hyperbola, 3 parabola
+    // Tips sharper than a pixel (radius of curvature a^2 / b, b^2 / a at the
+    // vertices) cannot be followed pixel by pixel
+    while ((shape < 2 && a * a < b) || (shape < 3 && b * b < a)) b = axis(rng);
+
+    // alpha U^2 + beta V^2 + gamma U + delta V + eps in U = p x' + q y',
+    // V = -q x' + p y' (r times the rotated coordinates), x' = x - cx
+    long long alpha, beta, gamma = 0, delta = 0, eps;
+    if (shape < 2) alpha = b * b, beta = a * a, eps = -a * a * b * b * r * r;
+    else if (shape == 2) alpha = b * b, beta = -a * a, eps = -a * a * b * b * r * r;
+    else alpha = 0, beta = 1, gamma = -a * r, eps = 0; // v^2 = a u
+    long long A = alpha * p * p + beta * q * q, B = 2 * p * q * (alpha - beta), C = alpha * q * q + beta * p * p;
+    long long D = gamma * p - delta * q, E = gamma * q + delta * p;
+    Conic conic = {A, B, C, D - 2 * A * cx - B * cy, E - 2 * C * cy - B * cx,
+                   A * cx * cx + B * cx * cy + C * cy * cy - D * cx - E * cy + eps};
+
+    // Curve point at parameter t, in pixels
+    auto at = [&](double t) {
+        double u, v;
+        if (shape < 2) u = a * std::cos(t), v = b * std::sin(t);
+        else if (shape == 2) u = a * std::cosh(t), v = b * std::sinh(t);
+        else u = t * t / a, v = t;
+        return std::make_pair(cx + cosR * u - sinR * v, cy + sinR * u + cosR * v);
+    };
+    double t0, t1;
+    if (shape < 2) t0 = 0.0, t1 = 2.0 * M_PI;
+    else if (shape == 2) t0 = -2.0, t1 = 2.0;
+    else t0 = -std::sqrt(600.0 * a), t1 = -t0; // Out to u = 600
+    std::uniform_real_distribution<double> param(t0, t1);
+    if (shape >= 2) {
+        double s0 = param(rng), s1 = param(rng);
+        t0 = std::min(s0, s1);
+        t1 = std::max(s0, s1);
+    }
+    else t0 = param(rng), t1 = t0 + 2.0 * M_PI;
+
+    auto gradient = [&](double x, double y) {
+        return std::make_pair(2.0 * A * x + double(B) * y + double(conic.D), double(B) * x + 2.0 * C * y + double(conic.E));
+    };
+    // Walk in the direction the kernel goes (F < 0 on the left)
+    std::pair<double, double> start = at(t0), ahead = at(t0 + 1e-4);
+    std::pair<double, double> g = gradient(start.first, start.second);
+    bool forward = (ahead.first - start.first) * -g.second + (ahead.second - start.second) * g.first > 0;
+    if (!forward) std::swap(t0, t1);
+    std::pair<double, double> from = at(t0), to = at(t1);
+    int x0 = int(std::lround(from.first)), y0 = int(std::lround(from.second));
+    int x1 = shape < 2 ? x0 : int(std::lround(to.first)), y1 = shape < 2 ? y0 : int(std::lround(to.second));
+    if (shape >= 2 && std::max(std::abs(x1 - x0), std::abs(y1 - y0)) <= 1) return ""; // Would trace the whole branch
+
+    char name[128];
+    std::snprintf(name, sizeof(name), "conic %d (%lld,%lld,%lld,%lld,%lld,%lld) from (%d,%d) to (%d,%d)", shape, conic.A,
+                  conic.B, conic.C, conic.D, conic.E, conic.F, x0, y0, x1, y1);
+    std::vector<ConicPixel> walk;
+    rasterConicArcPoints(conic, x0, y0, x1, y1, ConicClip::unbounded(), walk);
+    std::vector<Pixel> pixels;
+    for (const ConicPixel &px : walk) pixels.push_back({px.x, px.y});
+    if (pixels.empty() || pixels.front() != Pixel(x0, y0)) return failure("%s: does not start at the start", name);
+    if (shape >= 2 && pixels.back() != Pixel(x1, y1)) return failure("%s: does not end at the end", name);
+    for (size_t i = 1; i < pixels.size(); i++) {
+        int dx = std::abs(pixels[i].first - pixels[i - 1].first), dy = std::abs(pixels[i].second - pixels[i - 1].second);
+        if (std::max(dx, dy) != 1)
+            return failure("%s: step %zu from (%d,%d) to (%d,%d)", name, i, pixels[i - 1].first, pixels[i - 1].second,
+                           pixels[i].first, pixels[i].second);
+    }
+    if (shape < 2 && std::max(std::abs(pixels.back().first - x0), std::abs(pixels.back().second - y0)) > 1)
+        return failure("%s: ellipse does not close", name);
+
+    // Arc samples every quarter pixel or so
+    std::vector<std::pair<double, double>> samples;
+    double length = 0.0;
+    std::pair<double, double> last = from;
+    const int probes = 4000;
+    for (int i = 1; i <= probes; i++) {
+        std::pair<double, double> p = at(t0 + (t1 - t0) * i / probes);
+        length += std::hypot(p.first - last.first, p.second - last.second);
+        last = p;
+    }
+    int n = int(std::min(200000.0, 4.0 * length)) + 2;
+    for (int i = 0; i <= n; i++) samples.push_back(at(t0 + (t1 - t0) * i / n));
+    auto distance = [&](int x, int y) {
+        std::pair<double, double> g = gradient(x, y);
+        return std::fabs(double(conic.value(x, y))) / std::hypot(g.first, g.second);
+    };
+    Failure f = checkCurve(name, pixels, distance, samples, 1.0, 1.0);
+    if (!f.empty()) return f;
+
+    // Clipped walks, through a caller's buffer
+    ClipRect rect = randomClip(rng, 400);
+    ConicClip clip = {rect.xMin, rect.yMin, rect.xMax, rect.yMax};
+    std::vector<ConicPixel> buffer(std::uniform_int_distribution<size_t>(0, pixels.size())(rng));
+    size_t total = rasterConicArcInto(conic, x0, y0, x1, y1, clip, buffer.data(), buffer.size());
+    std::vector<Pixel> expected = insideClip(pixels, rect);
+    if (total != expected.size()) return failure("%s: clipped to (%d,%d)-(%d,%d): %zu pixels, expected %zu", name,
+                                                 clip.xMin, clip.yMin, clip.xMax, clip.yMax, total, expected.size());
+    for (size_t i = 0; i < std::min(total, buffer.size()); i++) {
+        if (Pixel(buffer[i].x, buffer[i].y) != expected[i])
+            return failure("%s: clipped to (%d,%d)-(%d,%d): pixel %zu differs", name, clip.xMin, clip.yMin, clip.xMax,
+                           clip.yMax, i);
+    }
+    return "";
+}
+
+// ---------------------------------------------------------------------------
+// Fills
+
+// Span flood fill against a breadth-first pixel fill, on boundaries drawn by
+// the line, circle and ellipse kernels plus scattered single pixels
+Failure checkFloodFill(std::mt19937 &rng) {
+    const int size = 96;
+    PixelMask mask(-size / 2, size / 2 - 1, -size / 2, size / 2 - 1);
+    std::uniform_int_distribution<int> coord(-size / 2 - 8, size / 2 + 8), radius(1, size / 2), pick(0, 3);
+    for (int i = 0; i < 6; i++) {
+        switch (pick(rng)) {
+        case 0: rasterLineBresenham(coord(rng), coord(rng), coord(rng), coord(rng), mask); break;
+        case 1: rasterCircleBresenham(coord(rng), coord(rng), radius(rng), mask); break;
+        case 2: rasterEllipseMidpoint(coord(rng), coord(rng), radius(rng), radius(rng), mask); break;
+        default:
+            for (int j = 0; j < 40; j++) mask.plot(coord(rng), coord(rng));
+        }
+    }
+    int connectivity = pick(rng) < 2 ? 4 : 8;
+    int sx = coord(rng), sy = coord(rng);
+    if (!mask.contains(sx, sy)) return "";
+
+    // Reference: breadth-first search over single pixels
+    PixelMask reference = mask;
+    uint8_t target = mask.at(sx, sy);
+    std::vector<Pixel> queue = {{sx, sy}};
+    auto index = [&](int x, int y) { return size_t(y + mask.originY) * mask.width + (x + mask.originX); };
+    reference.cells[index(sx, sy)] = 3;
+    for (size_t i = 0; i < queue.size(); i++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                if ((dx == 0 && dy == 0) || (connectivity == 4 && dx != 0 && dy != 0)) continue;
+                int x = queue[i].first + dx, y = queue[i].second + dy;
+                if (!reference.contains(x, y) || reference.at(x, y) != target) continue;
+                reference.cells[index(x, y)] = 3;
+                queue.push_back({x, y});
+            }
+        }
+    }
+
+    PixelMask spans = mask;
+    spans.value = 3;
+    FloodFillStats stats = floodFill(mask, sx, sy, 3, connectivity,
+                                     [&spans](int x0, int x1, int y) { spans.fillRow(x0, x1, y); });
+    if (mask.cells != reference.cells)
+        return failure("%d-connected fill from (%d,%d) differs from the pixel fill", connectivity, sx, sy);
+    if (spans.cells != reference.cells || stats.pixels != queue.size())
+        return failure("%d-connected fill from (%d,%d): spans do not cover the fill exactly", connectivity, sx, sy);
+    if (stats.maxStack > 3 * stats.spans)
+        return failure("%d-connected fill from (%d,%d): %zu stack entries for %zu spans", connectivity, sx, sy,
+                       stats.maxStack, stats.spans);
+    return "";
+}
+
+// Tiled union-find fill against seeded flood fills: first the outside from
+// every edge cell, then one fill per remaining region
+Failure checkRegionFill(std::mt19937 &rng) {
+    std::uniform_int_distribution<int> side(1, 120), pick(0, 4), tile(8, 40), threads(1, 4);
+    int width = side(rng), height = side(rng);
+    PixelMask mask(0, width - 1, 0, height - 1);
+    std::uniform_int_distribution<int> x(-8, width + 8), y(-8, height + 8), radius(1, 60);
+    int shapes = pick(rng) * 3;
+    for (int i = 0; i < shapes; i++) {
+        switch (pick(rng)) {
+        case 0: rasterCircleBresenham(x(rng), y(rng), radius(rng), mask); break;
+        case 1: rasterEllipseMidpoint(x(rng), y(rng), radius(rng), radius(rng), mask); break;
+        case 2: {
+            // Closed polygon outline, as question4Polygon.cpp would draw it
+            int n = 3 + pick(rng), x0 = x(rng), y0 = y(rng), px = x0, py = y0;
+            for (int k = 1; k <= n; k++) {
+                int qx = k < n ? x(rng) : x0, qy = k < n ? y(rng) : y0;
+                rasterLineBresenham(px, py, qx, qy, mask);
+                px = qx;
+                py = qy;
+            }
+            break;
+        }
+        case 3: rasterLineBresenham(x(rng), y(rng), x(rng), y(rng), mask); break;
+        default:
+            for (int j = 0; j < 30; j++) mask.plot(x(rng), y(rng));
+        }
+    }
+    RegionFillOptions options;
+    options.connectivity = pick(rng) < 2 ? 8 : 4;
+    options.tileSize = tile(rng);
+    options.threads = unsigned(threads(rng));
+
+    const uint8_t OUTSIDE = 3;
+    PixelMask reference = mask;
+    for (int py = 0; py < height; py++) {
+        for (int px = 0; px < width; px++) {
+            if ((px == 0 || py == 0 || px == width - 1 || py == height - 1) && reference.at(px, py) == MASK_EMPTY)
+                floodFill(reference, px, py, OUTSIDE, options.connectivity);
+        }
+    }
+    RegionFillStats expected;
+    for (int py = 0; py < height; py++) {
+        for (int px = 0; px < width; px++) {
+            if (reference.at(px, py) != MASK_EMPTY) continue;
+            expected.pixels += floodFill(reference, px, py, MASK_FILLED, options.connectivity).pixels;
+            expected.regions++;
+        }
+    }
+    std::replace(reference.cells.begin(), reference.cells.end(), OUTSIDE, MASK_EMPTY);
+
+    RegionFillStats stats = fillEnclosedRegions(mask, MASK_FILLED, options);
+    if (mask.cells != reference.cells)
+        return failure("%dx%d mask, %d-connected, tile %d, %u threads: filled cells differ", width, height,
+                       options.connectivity, options.tileSize, options.threads);
+    if (stats.regions != expected.regions || stats.pixels != expected.pixels)
+        return failure("%dx%d mask: %zu regions / %zu pixels, expected %zu / %zu", width, height, stats.regions,
+                       stats.pixels, expected.regions, expected.pixels);
+    return "";
+}
+
+// Scanline polygon fill against a ray cast from every grid point, in exact
+// integer arithmetic. Several contours with integer or half-integer
+// vertices; both fill rules.
+Failure checkScanlinePolygon(std::mt19937 &rng) {
+    struct Vertex {
+        double x, y;
+    };
+    std::uniform_int_distribution<int> contoursPick(1, 3), verticesPick(3, 12), coord(-60, 60), halves(0, 1);
+    bool half = halves(rng) == 1; // Vertices on the half-pixel grid
+    FillRule rule = halves(rng) ? FillRule::NonZero : FillRule::EvenOdd;
+    std::vector<std::vector<Vertex>> contours(contoursPick(rng));
+    for (auto &c : contours) {
+        c.resize(verticesPick(rng));
+        for (Vertex &v : c) v = {coord(rng) / (half ? 2.0 : 1.0), coord(rng) / (half ? 2.0 : 1.0)};
+    }
+
+    PolygonEdgeTable table;
+    for (auto &c : contours) table.addContour(c.data(), c.size());
+    std::set<Pixel> filled;
+    int lastY = INT_MIN, lastX1 = INT_MIN;
+    bool ordered = true;
+    table.scan(rule, [&](int x0, int x1, int y) {
+        if (x0 > x1 || y < lastY || (y == lastY && x0 <= lastX1 + 1)) ordered = false;
+        lastY = y;
+        lastX1 = x1;
+        for (int x = x0; x <= x1; x++) filled.insert({x, y});
+    });
+    if (!ordered) return failure("spans out of order, empty or touching (%zu contours)", contours.size());
+
+    // Reference: doubling half-integer coordinates makes every vertex an integer
+    int scale = half ? 2 : 1;
+    for (int y = -70; y <= 70; y++) {
+        for (int x = -70; x <= 70; x++) {
+            long long px = (long long)x * scale, py = (long long)y * scale;
+            int winding = 0, crossings = 0;
+            for (auto &c : contours) {
+                for (size_t i = 0, j = c.size() - 1; i < c.size(); j = i++) {
+                    long long xi = (long long)std::llround(c[i].x * scale), yi = (long long)std::llround(c[i].y * scale);
+                    long long xj = (long long)std::llround(c[j].x * scale), yj = (long long)std::llround(c[j].y * scale);
+                    if ((yi > py) == (yj > py)) continue;
+                    // Crossing right of the point: px < xj + (xi - xj) * (py - yj) / (yi - yj)
+                    long long lhs = (px - xj) * (yi - yj), rhs = (xi - xj) * (py - yj);
+                    bool right = (yi > yj) ? lhs < rhs : lhs > rhs;
+                    if (!right) continue;
+                    crossings++;
+                    winding += (yi > yj) ? 1 : -1;
+                }
+            }
+            bool inside = (rule == FillRule::NonZero) ? winding != 0 : (crossings & 1) != 0;
+            if (inside != (filled.count({x, y}) != 0))
+                return failure("%s fill of %zu contours at (%d,%d): scanline %d, ray cast %d",
+                               rule == FillRule::NonZero ? "non-zero" : "even-odd", contours.size(), x, y,
+                               int(!inside), int(inside));
+        }
+    }
+    return "";
+}
+
+// Batched and slab point-in-polygon queries against the scalar edge test
+// (bit-identical on every SIMD path), and against a double-precision ray
+// cast wherever a point is not within rounding distance of an edge
+Failure checkPointInPolygon(std::mt19937 &rng) {
+    struct Vertex {
+        float x, y;
+    };
+    std::uniform_int_distribution<int> contoursPick(1, 3), verticesPick(3, 40), slabsPick(0, 20), grid(0, 1);
+    std::uniform_real_distribution<float> coord(-50.0f, 50.0f);
+    bool integer = grid(rng) == 1; // Integer vertices and points, so many points lie on edges and rows
+    auto value = [&]() { return integer ? std::round(coord(rng)) : coord(rng); };
+    std::vector<std::vector<Vertex>> contours(contoursPick(rng));
+    PolygonEdgesSoA edges;
+    for (auto &c : contours) {
+        c.resize(verticesPick(rng));
+        for (Vertex &v : c) v = {value(), value()};
+        edges.addContour(c.data(), c.size());
+    }
+    size_t realEdges = edges.size();
+    edges.pad();
+    PolygonSlabs slabs;
+    slabs.build(edges, slabsPick(rng));
+
+    const size_t count = 500;
+    std::vector<float> xs(count), ys(count);
+    for (size_t i = 0; i < count; i++) {
+        xs[i] = value() * 1.1f;
+        ys[i] = value() * 1.1f;
+    }
+    std::vector<uint8_t> batch(count), slabbed(count);
+    pointsInPolygon(edges, xs.data(), ys.data(), count, batch.data());
+    pointsInPolygon(slabs, xs.data(), ys.data(), count, slabbed.data());
+
+    for (size_t i = 0; i < count; i++) {
+        float x = xs[i], y = ys[i];
+        int scalar = 0;
+        bool nearEdge = false;
+        int exact = 0;
+        for (size_t e = 0; e < realEdges; e++) {
+            scalar += edgeCrossedRight(edges, e, x, y) ? 1 : 0;
+            if (!(edges.yLo[e] <= y && y < edges.yHi[e])) continue;
+            double xCross = double(edges.xLo[e]) + double(edges.slope[e]) * (double(y) - edges.yLo[e]);
+            if (std::fabs(xCross - x) < 1e-3) nearEdge = true;
+            exact += x < xCross ? 1 : 0;
+        }
+        bool inside = (scalar & 1) != 0;
+        if (batch[i] != inside)
+            return failure("batch says %d at (%g,%g), scalar edge test %d", batch[i], x, y, int(inside));
+        if (slabbed[i] != inside)
+            return failure("%d slabs say %d at (%g,%g), scalar edge test %d", slabs.count, slabbed[i], x, y, int(inside));
+        if (!nearEdge && inside != ((exact & 1) != 0))
+            return failure("(%g,%g) is %d, double-precision ray cast says %d", x, y, int(inside), exact & 1);
+    }
+    return "";
+}
+
+// Is p within 1e-6 of any edge of polygon?
+template <class Vertex>
+bool polygonEdgeNear(const std::vector<Vertex> &polygon, const Vertex &p) {
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        double dx = polygon[i].x - polygon[j].x, dy = polygon[i].y - polygon[j].y;
+        double len2 = dx * dx + dy * dy;
+        double t = len2 > 0.0 ? ((p.x - polygon[j].x) * dx + (p.y - polygon[j].y) * dy) / len2 : 0.0;
+        t = std::max(0.0, std::min(1.0, t));
+        if (std::hypot(polygon[j].x + t * dx - p.x, polygon[j].y + t * dy - p.y) < 1e-6) return true;
+    }
+    return false;
+}
+
+// Triangulations of random simple polygons (star-shaped ones with many
+// split and merge vertices, and two-sided histograms full of equal y values)
+// must be n - 2 counter-clockwise triangles that add up to the polygon's
+// area and cover every grid point inside it exactly once
+Failure checkTriangulation(std::mt19937 &rng) {
+    struct Vertex {
+        double x, y;
+    };
+    std::uniform_int_distribution<int> pick(0, 3), sizePick(3, 150), height(1, 12);
+    std::vector<Vertex> polygon;
+    int n = sizePick(rng);
+    int shape = pick(rng);
+    if (shape < 2) {
+        // Star-shaped: sorted angles, radii anywhere from 5 to 60
+        std::uniform_real_distribution<double> angle(0.0, 6.283185307179586), radius(5.0, 60.0);
+        std::vector<double> angles(n);
+        for (double &a : angles) a = angle(rng);
+        std::sort(angles.begin(), angles.end());
+        for (double a : angles) {
+            double r = radius(rng);
+            polygon.push_back({r * std::cos(a), r * std::sin(a)});
+        }
+        // Simple only when every angular gap is below half a turn
+        if (std::unique(angles.begin(), angles.end()) != angles.end()) return "";
+        for (int i = 0; i < n; i++) {
+            double gap = (i + 1 < n ? angles[i + 1] : angles[0] + 6.283185307179586) - angles[i];
+            if (gap >= 3.14159) return "";
+        }
+    }
+    else {
+        // Columns 0..k with random bottom and top: every column edge is horizontal
+        int k = std::max(1, n / 4);
+        std::vector<int> top(k), bottom(k);
+        for (int i = 0; i < k; i++) {
+            top[i] = height(rng);
+            bottom[i] = -height(rng);
+        }
+        for (int i = 0; i < k; i++) {
+            polygon.push_back({double(i), double(bottom[i])});
+            polygon.push_back({double(i + 1), double(bottom[i])});
+        }
+        for (int i = k - 1; i >= 0; i--) {
+            polygon.push_back({double(i + 1), double(top[i])});
+            polygon.push_back({double(i), double(top[i])});
+        }
+        if (shape == 3) {
+            for (Vertex &v : polygon) std::swap(v.x, v.y); // Columns become rows
+        }
+        n = int(polygon.size());
+    }
+    if (pick(rng) == 0) std::reverse(polygon.begin(), polygon.end()); // Clockwise input
+
+    double area = std::fabs(polygonOrientation(polygon.data(), polygon.size())) / 2.0;
+    for (int method = 0; method < 2; method++) {
+        const char *name = method ? "monotone" : "ear clipping";
+        std::vector<uint32_t> indices;
+        bool ok = method ? triangulateMonotone(polygon.data(), polygon.size(), indices)
+                         : triangulateEarClipping(polygon.data(), polygon.size(), indices);
+        if (!ok) return failure("%s rejected a simple %d-gon (shape %d)", name, n, shape);
+        if (indices.size() % 3 != 0 || indices.size() > 3 * size_t(n - 2))
+            return failure("%s: %zu indices for a %d-gon", name, indices.size(), n);
+        double sum = 0.0;
+        for (size_t t = 0; t < indices.size(); t += 3) {
+            double o = triangleOrientation(polygon[indices[t]], polygon[indices[t + 1]], polygon[indices[t + 2]]);
+            if (o <= 0.0) return failure("%s: triangle %zu is not counter-clockwise (%d-gon)", name, t / 3, n);
+            sum += o / 2.0;
+        }
+        if (std::fabs(sum - area) > 1e-9 * std::max(1.0, area))
+            return failure("%s: triangles cover %.6f of area %.6f (%d-gon, shape %d)", name, sum, area, n, shape);
+
+        // Grid points off the edges and diagonals (odd offsets keep them off the
+        // integer lattice): inside the polygon <=> in exactly one triangle
+        PolygonEdgesSoA edges;
+        edges.addContour(polygon.data(), polygon.size());
+        edges.pad();
+        for (double y = -61.2371; y <= 61.0; y += 2.5) {
+            for (double x = -61.2613; x <= 61.0; x += 2.5) {
+                Vertex p = {x, y};
+                int covering = 0;
+                for (size_t t = 0; t < indices.size(); t += 3) {
+                    const Vertex &a = polygon[indices[t]], &b = polygon[indices[t + 1]], &c = polygon[indices[t + 2]];
+                    if (triangleOrientation(a, b, p) > 0.0 && triangleOrientation(b, c, p) > 0.0 &&
+                        triangleOrientation(c, a, p) > 0.0)
+                        covering++;
+                }
+                int expected = pointInPolygon(edges, float(x), float(y)) ? 1 : 0;
+                if (covering != expected && covering < 2 && !polygonEdgeNear(polygon, p))
+                    return failure("%s: (%g,%g) is in %d triangles, expected %d (%d-gon, shape %d)", name, x, y,
+                                   covering, expected, n, shape);
+                if (covering > 1) return failure("%s: triangles overlap at (%g,%g) (%d-gon)", name, x, y, n);
+            }
+        }
+    }
+    return "";
+}
+
+// Composed affine transforms must match the pieces applied one after the
+// other in double precision, and the SIMD paths (SoA, interleaved, in place)
+// must give exactly what Affine2D::apply() gives point by point
+Failure checkAffine(std::mt19937 &rng) {
+    struct Vertex {
+        float x, y;
+    };
+    std::uniform_real_distribution<float> coord(-1000.0f, 1000.0f), shift(-100.0f, 100.0f), factor(-4.0f, 4.0f);
+    std::uniform_real_distribution<double> angle(-7.0, 7.0);
+    std::uniform_int_distribution<int> countPick(0, 100);
+    float dx = shift(rng), dy = shift(rng), sx = factor(rng), sy = factor(rng), cx = shift(rng), cy = shift(rng);
+    double theta = angle(rng);
+    Affine2D m = Affine2D::translation(dx, dy)
+                     .then(Affine2D::scaling(sx, sy))
+                     .then(Affine2D::rotationAbout(theta, cx, cy));
+
+    size_t count = size_t(countPick(rng));
+    PointsSoA points;
+    std::vector<Vertex> vertices(count);
+    for (size_t i = 0; i < count; i++) {
+        vertices[i] = {coord(rng), coord(rng)};
+        points.push_back(vertices[i].x, vertices[i].y);
+    }
+    PointsSoA moved;
+    transformPoints(m, points, moved);
+    std::vector<Vertex> movedVertices(count);
+    transformPoints(m, vertices.data(), movedVertices.data(), count);
+    PointsSoA inPlace = points;
+    transformPointsInPlace(m, inPlace);
+    std::vector<Vertex> inPlaceVertices = vertices;
+    transformPointsInPlace(m, inPlaceVertices.data(), count);
+
+    double cosT = std::cos(theta), sinT = std::sin(theta);
+    for (size_t i = 0; i < count; i++) {
+        float x = points.x[i], y = points.y[i];
+        float ex, ey;
+        m.apply(x, y, ex, ey);
+        if (moved.x[i] != ex || moved.y[i] != ey)
+            return failure("SoA (%g,%g) -> (%.9g,%.9g), apply() gives (%.9g,%.9g)", x, y, moved.x[i], moved.y[i], ex, ey);
+        if (movedVertices[i].x != ex || movedVertices[i].y != ey)
+            return failure("interleaved (%g,%g) -> (%.9g,%.9g), apply() gives (%.9g,%.9g)", x, y, movedVertices[i].x,
+                           movedVertices[i].y, ex, ey);
+        if (inPlace.x[i] != ex || inPlace.y[i] != ey || inPlaceVertices[i].x != ex || inPlaceVertices[i].y != ey)
+            return failure("in-place transform of (%g,%g) differs from apply()", x, y);
+
+        // Translate, scale, then rotate about (cx, cy), step by step
+        double rx = (double(x) + dx) * sx - cx, ry = (double(y) + dy) * sy - cy;
+        double wantX = rx * cosT - ry * sinT + cx, wantY = rx * sinT + ry * cosT + cy;
+        double scale = 1e-5 * (std::fabs(wantX) + std::fabs(wantY) + 1000.0); // float rounding of the composed matrix
+        if (std::fabs(ex - wantX) > scale || std::fabs(ey - wantY) > scale)
+            return failure("(%g,%g) -> (%.9g,%.9g), step by step (%.9g,%.9g)", x, y, ex, ey, wantX, wantY);
+    }
+    return "";
+}
+
+// Exact orientation and incircle signs for integer points (|coordinates| < 2^23)
+int exactOrient(long long ax, long long ay, long long bx, long long by, long long cx, long long cy) {
+    __int128 det = (__int128)(ax - cx) * (by - cy) - (__int128)(ay - cy) * (bx - cx);
+    return det > 0 ? 1 : (det < 0 ? -1 : 0);
+}
+
+int exactIncircle(long long ax, long long ay, long long bx, long long by, long long cx, long long cy, long long dx,
+                  long long dy) {
+    __int128 adx = ax - dx, ady = ay - dy, bdx = bx - dx, bdy = by - dy, cdx = cx - dx, cdy = cy - dy;
+    __int128 det = (adx * adx + ady * ady) * (bdx * cdy - cdx * bdy) + (bdx * bdx + bdy * bdy) * (cdx * ady - adx * cdy) +
+                   (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady);
+    return det > 0 ? 1 : (det < 0 ? -1 : 0);
+}
+
+int signOf(double v) { return v > 0.0 ? 1 : (v < 0.0 ? -1 : 0); }
+
+Failure checkPredicates(std::mt19937 &rng) {
+    std::uniform_int_distribution<long long> far(-(1LL << 22), 1LL << 22), near(-1000, 1000), nudge(-1, 1);
+    std::uniform_int_distribution<int> kind(0, 2);
+
+    // Integer inputs: random, exactly collinear or cocircular, or one unit off
+    TrianglesSoA triangles;
+    std::vector<double> qx, qy;
+    std::vector<long long> coords; // ax ay bx by cx cy dx dy per query
+    for (int q = 0; q < 64; q++) {
+        long long v[8];
+        int k = kind(rng);
+        if (k == 0) {
+            for (long long &c : v) c = far(rng);
+        }
+        else if (k == 1) {
+            // a, b, c on one line, d near it
+            long long ox = far(rng), oy = far(rng), ux = near(rng), uy = near(rng);
+            long long t[4] = {near(rng), near(rng), near(rng), near(rng)};
+            for (int i = 0; i < 4; i++) {
+                v[2 * i] = ox + t[i] * ux;
+                v[2 * i + 1] = oy + t[i] * uy;
+            }
+            v[4] += nudge(rng);
+            v[7] += nudge(rng);
+        }
+        else {
+            // Four of the eight lattice points (+-u, +-w), (+-w, +-u) about a centre
+            long long ox = far(rng), oy = far(rng), u = near(rng), w = near(rng);
+            const long long pattern[8][2] = {{u, w}, {-u, w}, {u, -w}, {-u, -w}, {w, u}, {-w, u}, {w, -u}, {-w, -u}};
+            std::uniform_int_distribution<int> pick(0, 7);
+            for (int i = 0; i < 4; i++) {
+                const long long *p = pattern[pick(rng)];
+                v[2 * i] = ox + p[0];
+                v[2 * i + 1] = oy + p[1];
+            }
+            v[6] += nudge(rng);
+        }
+        coords.insert(coords.end(), v, v + 8);
+        triangles.push_back(double(v[0]), double(v[1]), double(v[2]), double(v[3]), double(v[4]), double(v[5]));
+        qx.push_back(double(v[6]));
+        qy.push_back(double(v[7]));
+    }
+
+    std::vector<int8_t> batch(triangles.size());
+    incircleBatch(triangles, qx.data(), qy.data(), batch.data());
+    std::vector<Circumcircle> circles(triangles.size());
+    circumcircleBatch(triangles, circles.data());
+    for (size_t q = 0; q < triangles.size(); q++) {
+        const long long *v = &coords[8 * q];
+        double d[8];
+        for (int i = 0; i < 8; i++) d[i] = double(v[i]);
+        int wantOrient = exactOrient(v[0], v[1], v[2], v[3], v[4], v[5]);
+        int wantIn = exactIncircle(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+        int gotOrient = signOf(orient2d(d[0], d[1], d[2], d[3], d[4], d[5]));
+        int gotIn = signOf(incircle(d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7]));
+        if (gotOrient != wantOrient)
+            return failure("orient2d (%lld,%lld) (%lld,%lld) (%lld,%lld) sign %d, exact %d", v[0], v[1], v[2], v[3], v[4],
+                           v[5], gotOrient, wantOrient);
+        if (gotIn != wantIn || batch[q] != wantIn)
+            return failure("incircle (%lld,%lld) (%lld,%lld) (%lld,%lld) / (%lld,%lld) sign %d, batch %d, exact %d", v[0],
+                           v[1], v[2], v[3], v[4], v[5], v[6], v[7], gotIn, int(batch[q]), wantIn);
+
+        Circumcircle one = circumcircle(d[0], d[1], d[2], d[3], d[4], d[5]);
+        if (std::isinf(one.r2) != (wantOrient == 0) || std::isinf(circles[q].r2) != (wantOrient == 0))
+            return failure("circumcircle of (%lld,%lld) (%lld,%lld) (%lld,%lld): radius^2 %g, batch %g, orientation %d",
+                           v[0], v[1], v[2], v[3], v[4], v[5], one.r2, circles[q].r2, wantOrient);
+        if (wantOrient == 0) continue;
+        if (std::fabs(one.x - circles[q].x) > 1e-9 * (std::fabs(one.x) + 1.0) ||
+            std::fabs(one.y - circles[q].y) > 1e-9 * (std::fabs(one.y) + 1.0) ||
+            std::fabs(one.r2 - circles[q].r2) > 1e-9 * one.r2)
+            return failure("circumcircle batch (%.17g,%.17g,%.17g), scalar (%.17g,%.17g,%.17g)", circles[q].x,
+                           circles[q].y, circles[q].r2, one.x, one.y, one.r2);
+        // Well-shaped triangles: the centre is equidistant from all three vertices
+        double e1 = std::hypot(d[2] - d[0], d[3] - d[1]), e2 = std::hypot(d[4] - d[0], d[5] - d[1]);
+        double area = std::fabs((d[2] - d[0]) * (d[5] - d[1]) - (d[3] - d[1]) * (d[4] - d[0]));
+        if (area < 0.1 * e1 * e2) continue;
+        for (int i = 0; i < 3; i++) {
+            double r2 = (d[2 * i] - one.x) * (d[2 * i] - one.x) + (d[2 * i + 1] - one.y) * (d[2 * i + 1] - one.y);
+            if (std::fabs(r2 - one.r2) > 1e-9 * one.r2)
+                return failure("circumcircle (%.17g,%.17g) radius^2 %.17g, vertex %d at %.17g", one.x, one.y, one.r2, i, r2);
+        }
+    }
+
+    // Non-integer, nearly collinear inputs: exact signs must not depend on
+    // the order the points are given in
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+    for (int q = 0; q < 32; q++) {
+        double ax = unit(rng) * 1e3, ay = unit(rng) * 1e3, bx = unit(rng) * 1e3, by = unit(rng) * 1e3;
+        double p[4][2] = {{ax, ay}, {bx, by}, {}, {}};
+        for (int i = 2; i < 4; i++) {
+            double t = unit(rng) * 2.0;
+            p[i][0] = ax + t * (bx - ax);
+            p[i][1] = ay + t * (by - ay);
+        }
+        int o = signOf(orient2d(p[0][0], p[0][1], p[1][0], p[1][1], p[2][0], p[2][1]));
+        if (signOf(orient2d(p[1][0], p[1][1], p[2][0], p[2][1], p[0][0], p[0][1])) != o ||
+            signOf(orient2d(p[1][0], p[1][1], p[0][0], p[0][1], p[2][0], p[2][1])) != -o)
+            return failure("orient2d of (%.17g,%.17g) (%.17g,%.17g) (%.17g,%.17g) changes with the vertex order", p[0][0],
+                           p[0][1], p[1][0], p[1][1], p[2][0], p[2][1]);
+        int c = signOf(incircle(p[0][0], p[0][1], p[1][0], p[1][1], p[2][0], p[2][1], p[3][0], p[3][1]));
+        if (signOf(incircle(p[1][0], p[1][1], p[2][0], p[2][1], p[0][0], p[0][1], p[3][0], p[3][1])) != c ||
+            signOf(incircle(p[1][0], p[1][1], p[0][0], p[0][1], p[2][0], p[2][1], p[3][0], p[3][1])) != -c ||
+            signOf(incircle(p[3][0], p[3][1], p[1][0], p[1][1], p[2][0], p[2][1], p[0][0], p[0][1])) != -c)
+            return failure("incircle of nearly collinear points changes with the vertex order (first at %.17g,%.17g)",
+                           p[0][0], p[0][1]);
+    }
+    return "";
+}
+
+Failure checkDelaunay(std::mt19937 &rng) {
+    struct Vertex {
+        long long x, y;
+    };
+    std::uniform_int_distribution<int> kind(0, 3), countPick(0, 200);
+    std::uniform_int_distribution<long long> small(-12, 12), large(-(1LL << 21), 1LL << 21);
+    int k = kind(rng);
+    size_t count = size_t(countPick(rng));
+    std::vector<Vertex> points(count);
+    long long ux = small(rng), uy = small(rng), ox = large(rng), oy = large(rng);
+    for (size_t i = 0; i < count; i++) {
+        Vertex &p = points[i];
+        if (k == 0) p = {small(rng), small(rng)}; // Dense grid: repeats, collinear and cocircular points
+        else if (k == 1) p = {large(rng), large(rng)};
+        else if (k == 2) {
+            long long t = small(rng); // All on one line, one in four just off it
+            p = {ox + t * ux, oy + t * uy};
+            if (i % 4 == 3) p.x += small(rng) % 2;
+        }
+        else p = {ox + small(rng) * 1000, oy + small(rng)}; // Long thin rows
+    }
+
+    DelaunayTriangulation dt;
+    bool incremental = (rng() & 1) != 0;
+    if (incremental) {
+        for (const Vertex &p : points) dt.insert(double(p.x), double(p.y));
+    }
+    else dt.build(points.data(), count);
+
+    auto px = [&](int v) { return (long long)dt.x(v); };
+    auto py = [&](int v) { return (long long)dt.y(v); };
+    const std::vector<DelaunayTriangulation::Triangle> &tris = dt.triangles();
+    std::set<std::pair<long long, long long>> distinct, used;
+    for (const Vertex &p : points) distinct.insert({p.x, p.y});
+    size_t finite = 0, ghosts = 0;
+    for (size_t t = 0; t < tris.size(); t++) {
+        const DelaunayTriangulation::Triangle &tri = tris[t];
+        if (tri.dead) continue;
+        for (int e = 0; e < 3; e++) {
+            // Neighbours point back and share the edge the other way round
+            const DelaunayTriangulation::Triangle &nb = tris[tri.n[e]];
+            int a = tri.v[(e + 1) % 3], b = tri.v[(e + 2) % 3], back = -1;
+            for (int j = 0; j < 3; j++)
+                if (nb.n[j] == int(t)) back = j;
+            if (nb.dead || back < 0 || nb.v[(back + 1) % 3] != b || nb.v[(back + 2) % 3] != a)
+                return failure("%s: triangle %d and its neighbour %d do not share edge %d-%d", incremental ? "insert" : "build",
+                               int(t), tri.n[e], a, b);
+        }
+        if (DelaunayTriangulation::isGhost(tri)) {
+            ghosts++;
+            int k0 = tri.v[0] == -1 ? 0 : (tri.v[1] == -1 ? 1 : 2);
+            int a = tri.v[(k0 + 1) % 3], b = tri.v[(k0 + 2) % 3];
+            for (const Vertex &p : points)
+                if (exactOrient(px(a), py(a), px(b), py(b), p.x, p.y) > 0)
+                    return failure("(%lld,%lld) is outside hull edge (%lld,%lld)-(%lld,%lld)", p.x, p.y, px(a), py(a),
+                                   px(b), py(b));
+            continue;
+        }
+        finite++;
+        const int *v = tri.v;
+        for (int i = 0; i < 3; i++) used.insert({px(v[i]), py(v[i])});
+        if (exactOrient(px(v[0]), py(v[0]), px(v[1]), py(v[1]), px(v[2]), py(v[2])) <= 0)
+            return failure("triangle (%lld,%lld) (%lld,%lld) (%lld,%lld) is not counter-clockwise", px(v[0]), py(v[0]),
+                           px(v[1]), py(v[1]), px(v[2]), py(v[2]));
+        for (int e = 0; e < 3; e++) {
+            // Locally Delaunay: the far vertex of each neighbour is not inside the circumcircle
+            const DelaunayTriangulation::Triangle &nb = tris[tri.n[e]];
+            if (DelaunayTriangulation::isGhost(nb)) continue;
+            for (int j = 0; j < 3; j++) {
+                int w = nb.v[j];
+                if (w == v[0] || w == v[1] || w == v[2]) continue;
+                if (exactIncircle(px(v[0]), py(v[0]), px(v[1]), py(v[1]), px(v[2]), py(v[2]), px(w), py(w)) > 0)
+                    return failure("(%lld,%lld) is inside the circumcircle of (%lld,%lld) (%lld,%lld) (%lld,%lld)", px(w),
+                                   py(w), px(v[0]), py(v[0]), px(v[1]), py(v[1]), px(v[2]), py(v[2]));
+            }
+        }
+    }
+    if (finite == 0) {
+        // Only when every point is on one line
+        if (distinct.empty()) return "";
+        std::pair<long long, long long> a = *distinct.begin(), b = *distinct.rbegin();
+        for (const Vertex &p : points)
+            if (exactOrient(a.first, a.second, b.first, b.second, p.x, p.y) != 0)
+                return failure("no triangles for %d points that are not collinear", int(count));
+        return "";
+    }
+    if (used != distinct)
+        return failure("%d of %d distinct points are vertices", int(used.size()), int(distinct.size()));
+    if (finite != 2 * distinct.size() - 2 - ghosts)
+        return failure("%d triangles for %d points and %d hull edges", int(finite), int(distinct.size()), int(ghosts));
+    return "";
+}
+
+Failure checkArcTessellation(std::mt19937 &rng) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<int> pixels(50, 2000);
+    double span = std::pow(10.0, unit(rng) * 4.0 - 2.0); // World units across the view
+    OrthoView view = {-span / 2, span / 2, -span / 3, span / 3, pixels(rng), pixels(rng)};
+    double radius = span * std::pow(10.0, unit(rng) * 4.0 - 3.5);
+    double tolerance = 0.05 + unit(rng);
+    double scale = view.pixelsPerUnit();
+    int level = arcLevel(radius, view, tolerance);
+
+    // Chord error of the chosen level within tolerance, and of the level below not
+    double step = 2.0 * 3.14159265358979323846 / double(1 << level);
+    double sag = radius * scale * (1.0 - std::cos(step / 2.0));
+    if (level < ARC_MAX_LEVEL && sag > tolerance)
+        return failure("radius %g px: level %d strays %g px, tolerance %g", radius * scale, level, sag, tolerance);
+    if (level > ARC_MIN_LEVEL && radius * scale * (1.0 - std::cos(step)) <= tolerance)
+        return failure("radius %g px: level %d is finer than tolerance %g needs", radius * scale, level, tolerance);
+
+    float cx = float(unit(rng) * span), cy = float(unit(rng) * span);
+    std::vector<float> circle;
+    if (tessellateCircle(cx, cy, float(radius), level, circle) != size_t(1) << level)
+        return failure("level %d circle has %d points", level, int(circle.size() / 2));
+
+    // Pie: consecutive arcs share their ends; every point on the circle, in
+    // order, no gap wider than a step
+    int slices = 1 + int(unit(rng) * 12);
+    std::vector<double> cuts = {unit(rng) * 6.0};
+    for (int i = 0; i < slices; i++) cuts.push_back(cuts.back() + unit(rng) * 2.0 * 3.14159265358979323846 / slices);
+    float lastX = 0.0f, lastY = 0.0f;
+    for (int i = 0; i < slices; i++) {
+        std::vector<float> xy;
+        size_t n = tessellateArc(cx, cy, float(radius), cuts[i], cuts[i + 1], level, xy);
+        if (n < 2 || xy.size() != 2 * n) return failure("arc %g..%g gave %d points", cuts[i], cuts[i + 1], int(n));
+        if (i > 0 && (xy[0] != lastX || xy[1] != lastY))
+            return failure("arc %d starts at (%g,%g), previous ended at (%g,%g)", i, xy[0], xy[1], lastX, lastY);
+        lastX = xy[2 * n - 2];
+        lastY = xy[2 * n - 1];
+        for (size_t k = 0; k < n; k++) {
+            double dx = xy[2 * k] - cx, dy = xy[2 * k + 1] - cy;
+            double r = std::hypot(dx, dy), slack = 1e-5 * (radius + std::fabs(cx) + std::fabs(cy));
+            if (std::fabs(r - radius) > slack) return failure("arc point %d at radius %g, want %g", int(k), r, radius);
+            if (k == 0) continue;
+            // Angle turned since the previous point
+            double turn = std::atan2(dy, dx) - std::atan2(xy[2 * k - 1] - cy, xy[2 * k - 2] - cx);
+            turn -= 2.0 * 3.14159265358979323846 * std::floor(turn / (2.0 * 3.14159265358979323846) + 1e-9);
+            if (r > 1e3 * slack && (turn > step * (1.0 + 1e-3) + 1e-4 || turn < 0.0))
+                return failure("arc %g..%g: step %g between points %d and %d, level step %g", cuts[i], cuts[i + 1], turn,
+                               int(k - 1), int(k), step);
+        }
+    }
+    return "";
+}
+
+Failure checkPieGeometry(std::mt19937 &rng) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    const double pi = 3.14159265358979323846;
+    PieChart chart;
+    chart.cx = float(unit(rng) * 4.0 - 2.0);
+    chart.cy = float(unit(rng) * 4.0 - 2.0);
+    chart.radius = float(0.1 + unit(rng));
+    chart.holeRadius = unit(rng) < 0.3 ? float(unit(rng) * 0.8 * chart.radius) : 0.0f;
+    chart.startAngle = unit(rng) * 2.0 * pi;
+    chart.separators = unit(rng) < 0.8;
+    chart.rim = unit(rng) < 0.8;
+    int count = int(unit(rng) * 12);
+    for (int i = 0; i < count; i++) chart.values.push_back(unit(rng) < 0.15 ? 0.0f : float(unit(rng) * 100.0));
+    int level = ARC_MIN_LEVEL + int(unit(rng) * (ARC_MAX_LEVEL - ARC_MIN_LEVEL - 3));
+    const bool donut = chart.holeRadius > 0.0f;
+
+    PieGeometry g;
+    buildPieGeometry(chart, level, g);
+    if (g.vertices.size() != PieGeometry::vertexCapacity(count, level, donut) ||
+        g.fill.size() != PieGeometry::fillCapacity(count, level, donut) ||
+        g.lines.size() != PieGeometry::lineCapacity(count, level, donut))
+        return failure("%d slices at level %d: buffers not at capacity", count, level);
+    if (g.usedVertices > g.vertices.size() || g.usedFill > g.fill.size() || g.usedLines > g.lines.size())
+        return failure("%d slices at level %d overflow their capacity", count, level);
+    for (size_t k = 0; k < g.fill.size(); k++)
+        if (g.fill[k] >= g.usedVertices && !(k >= g.usedFill && g.fill[k] == 0))
+            return failure("fill index %d is %u of %d vertices", int(k), g.fill[k], int(g.usedVertices));
+    for (size_t k = 0; k < g.lines.size(); k++)
+        if (g.lines[k] >= g.usedVertices && !(k >= g.usedLines && g.lines[k] == 0))
+            return failure("line index %d is %u of %d vertices", int(k), g.lines[k], int(g.usedVertices));
+
+    // Slices in order, each starting where the previous one ends, on the circle
+    for (int i = 1; i < count; i++) {
+        const PieSliceRange &a = g.ranges[i - 1], &b = g.ranges[i];
+        if (b.firstVertex < a.firstVertex || b.firstFill < a.firstFill || b.firstLine < a.firstLine)
+            return failure("slice %d range before slice %d", i, i - 1);
+        if (g.slices[i].start != g.slices[i - 1].end)
+            return failure("slice %d starts at %g, slice %d ends at %g", i, g.slices[i].start, i - 1, g.slices[i - 1].end);
+    }
+
+    // Triangles counter-clockwise and covering the inscribed pie, never more
+    // than the true one
+    double area = 0.0;
+    for (size_t k = 0; k < g.usedFill; k += 3) {
+        const PieVertex &p = g.vertices[g.fill[k]], &q = g.vertices[g.fill[k + 1]], &r = g.vertices[g.fill[k + 2]];
+        double twice = (double(q.x) - p.x) * (double(r.y) - p.y) - (double(q.y) - p.y) * (double(r.x) - p.x);
+        if (twice < -1e-5) return failure("triangle %d is clockwise (%g)", int(k / 3), twice);
+        area += twice / 2.0;
+    }
+    double total = pieTotal(chart);
+    if (total > 0.0) {
+        double n = double(1 << level);
+        auto inscribed = [&](double r) { return n / 2.0 * r * r * std::sin(2.0 * pi / n); };
+        double r = chart.radius, h = chart.holeRadius;
+        double low = inscribed(r) - pi * h * h, high = pi * r * r - (donut ? inscribed(h) : 0.0);
+        double slack = 1e-4 * (r * r + 1.0);
+        if (area < low - slack || area > high + slack)
+            return failure("%d slices at level %d cover %g, want %g..%g", count, level, area, low, high);
+    }
+
+    // Changing values and laying out from the first changed slice on gives
+    // what a build from scratch gives, and touches nothing before that slice.
+    // The running total is adjusted in float, as a caller might, so it
+    // drifts from the sum.
+    if (unit(rng) < 0.5) chart.fullTurn = total * (1.0 + unit(rng));
+    buildPieGeometry(chart, level, g, total);
+    for (int round = 0; round < 4 && count > 0; round++) {
+        size_t first = size_t(unit(rng) * count);
+        double turn = g.turn;
+        for (size_t i = first; i < size_t(count); i++) {
+            if (unit(rng) < 0.3) {
+                float v = unit(rng) < 0.1 ? 0.0f : float(unit(rng) * 100.0);
+                total += double(v - chart.values[i]);
+                chart.values[i] = v;
+            }
+        }
+        PieGeometry before = g, fresh;
+        PieGeometryChange c = updatePieGeometry(chart, total, first, g);
+        buildPieGeometry(chart, level, fresh);
+        if (g.usedVertices != fresh.usedVertices || g.usedFill != fresh.usedFill || g.usedLines != fresh.usedLines ||
+            g.fill != fresh.fill || g.lines != fresh.lines)
+            return failure("update from slice %d of %d differs from a fresh build", int(first), count);
+        for (size_t k = 0; k < g.usedVertices; k++)
+            if (std::memcmp(&g.vertices[k], &fresh.vertices[k], sizeof(PieVertex)) != 0)
+                return failure("update from slice %d: vertex %d differs from a fresh build", int(first), int(k));
+        if (g.turn != turn) continue; // Every slice moved
+        size_t keep = g.ranges[first].firstVertex;
+        if (c.firstVertex != keep || c.endVertex != g.usedVertices)
+            return failure("update from slice %d reports vertices %d..%d, slice starts at %d", int(first),
+                           int(c.firstVertex), int(c.endVertex), int(keep));
+        for (size_t k = 0; k < keep; k++)
+            if (std::memcmp(&g.vertices[k], &before.vertices[k], sizeof(PieVertex)) != 0)
+                return failure("update from slice %d changed vertex %d of an earlier slice", int(first), int(k));
+        for (size_t k = 0; k < g.fill.size(); k++)
+            if (g.fill[k] != before.fill[k] && (k < c.firstFill || k >= c.endFill))
+                return failure("update from slice %d changed fill index %d outside %d..%d", int(first), int(k),
+                               int(c.firstFill), int(c.endFill));
+        for (size_t k = 0; k < g.lines.size(); k++)
+            if (g.lines[k] != before.lines[k] && (k < c.firstLine || k >= c.endLine))
+                return failure("update from slice %d changed line index %d outside %d..%d", int(first), int(k),
+                               int(c.firstLine), int(c.endLine));
+    }
+    return "";
+}
+
+// ---------------------------------------------------------------------------
+
+struct OracleCheck {
+    const char *name;
+    Failure (*run)(std::mt19937 &rng);
+    int cost = 1; // Runs trials / cost times; for checks that draw many segments per trial
+};
+
+int main(int argc, char **argv) {
+    int trials = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2000;
+    unsigned seed = argc > 2 ? unsigned(std::strtoul(argv[2], nullptr, 10)) : 12345u;
+
+    const OracleCheck checks[] = {
+        {"line DDA", checkDDA},
+        {"line DDA batch (SIMD)", checkDDABatch},
+        {"line Bresenham", checkBresenham},
+        {"line Bresenham spans", checkBresenhamSpans},
+        {"line Bresenham spans clipped", checkBresenhamSpansClipped},
+        {"line Bresenham clipped", checkBresenhamClipped},
+        {"line DDA clipped", checkDDAClipped},
+        {"line midpoint", checkMidpoint},
+        {"line midpoint clipped", checkMidpointClipped},
+        {"line tiled", checkTiled, 100},
+        {"line strip streaming", checkStripLayout},
+        {"line Wu (float)", checkWuFloat},
+        {"line Wu (16.16)", checkWuFixed},
+        {"line Gupta-Sproull 3x3", checkGuptaSproull3x3},
+        {"line Gupta-Sproull table", checkGuptaSproullTable},
+        {"circle Bresenham", checkCircleBresenham},
+        {"circle stamp", checkCircleStamp},
+        {"circle ordered outline", checkCircleOrdered},
+        {"ellipse midpoint", checkEllipseMidpoint},
+        {"ellipse spans and batch", checkEllipseSpans},
+        {"parabola midpoint", checkParabolaMidpoint},
+        {"conic walk (clipped)", checkConic},
+        {"flood fill", checkFloodFill},
+        {"region fill (tiled union-find)", checkRegionFill},
+        {"polygon scanline fill", checkScanlinePolygon},
+        {"point in polygon (SIMD, slabs)", checkPointInPolygon},
+        {"polygon triangulation", checkTriangulation},
+        {"affine transform (SIMD)", checkAffine},
+        {"circumcircle predicates (SIMD)", checkPredicates},
+        {"Delaunay triangulation", checkDelaunay, 10},
+        {"arc tessellation (LOD)", checkArcTessellation},
+        {"pie chart geometry", checkPieGeometry},
+    };
+
+    int failed = 0;
+    for (const OracleCheck &check : checks) {
+        std::mt19937 rng(seed);
+        int runs = std::max(1, trials / check.cost);
+        Failure first;
+        int failures = 0;
+        for (int i = 0; i < runs; i++) {
+            Failure f = check.run(rng);
+            if (!f.empty() && failures++ == 0) first = f;
+        }
+        if (failures) {
+            failed++;
+            std::printf("FAIL  %-30s %d/%d  first: %s\n", check.name, failures, runs, first.c_str());
+        }
+        else {
+            std::printf("ok    %-30s %d trials\n", check.name, runs);
+        }
+    }
+    std::printf("%s\n", failed ? "Some rasterizers disagree with the oracle." : "All rasterizers match the oracle.");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,272 @@
+// *******************************
+// PolylineStream.h
+//
+// Streams line strips to a core-profile OpenGL context through one
+// vertex buffer used as a ring of three regions (triple buffering).
+//
+// Each vertex is written once, straight into mapped buffer memory:
+//   - With GL 4.4 or ARB_buffer_storage the whole ring is created with
+//     glBufferStorage and mapped a single time (persistent, coherent).
+//   - Otherwise (e.g. a GL 3.3 core context on macOS) the buffer is
+//     allocated with glBufferData and each region is mapped with
+//     glMapBufferRange(..., GL_MAP_UNSYNCHRONIZED_BIT) while it is filled.
+//     If the driver refuses that mapping, regions are filled in a CPU
+//     staging array and uploaded with glBufferSubData instead.
+// In both cases a fence is placed after the draw that reads a region, and
+// the region is only written again once that fence has signalled, so the
+// CPU never writes memory the GPU is still reading and never waits on a
+// draw that was issued less than two regions ago.
+//
+// Usage, between glUseProgram() and the buffer swap:
+//     stream.beginStrip(r, g, b);
+//     stream.addVertex(x, y);  ...
+//     stream.endStrip();
+//     ...
+//     stream.draw();           // Issues the pending strips
+// A region that fills up mid-frame is drawn at once and the open strip
+// continues in the next region, so frames may hold any number of vertices.
+// Which slots each strip takes is worked out by StripLayout.h.
+// *******************************
+
+#pragma once
+
+#include <stdio.h>
+#include <vector>
+
+#include "StripLayout.h"
+
+// One streamed vertex: position in attribute vertPos, color in vertColor
+struct StreamVertex
+{
+    float x, y;
+    unsigned char rgba[4];
+};
+
+class PolylineStream
+{
+public:
+    static const int NumRegions = 3;
+
+    // Creates the VAO and the ring buffer; vertPos_loc and vertColor_loc are
+    // the shader's attribute locations.
+    void setup(GLuint vertPos_loc, GLuint vertColor_loc, int verticesPerRegion = 1 << 18);
+    void cleanup();
+
+    bool isPersistent() const { return persistent; }
+    long long verticesStreamed() const { return streamed; }
+
+    void beginStrip(float r, float g, float b);
+    void addVertex(float x, float y);
+    void endStrip();
+
+    // Draw every strip added since the last draw() with glMultiDrawArrays.
+    void draw();
+
+private:
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    bool persistent = false;
+    int regionVerts = 0;
+    StreamVertex *ring = nullptr;     // Persistent mapping of the whole ring
+    StreamVertex *current = nullptr;  // Mapping of the region being filled (null: none yet)
+    std::vector<StreamVertex> staging; // Region being filled when regions cannot be mapped
+    GLsync fence[NumRegions] = {};
+    int region = 0;
+    StripLayout layout;               // Slots of the strips in the current region
+    StreamVertex vertex = {0.0f, 0.0f, {255, 255, 255, 255}}; // Last vertex written (mapped memory is write-only)
+    long long streamed = 0;
+
+    bool beginRegion();
+    void submitRegion();
+};
+
+inline void PolylineStream::setup(GLuint vertPos_loc, GLuint vertColor_loc, int verticesPerRegion)
+{
+    regionVerts = verticesPerRegion;
+    layout.setup(regionVerts);
+    GLsizeiptr ringBytes = GLsizeiptr(NumRegions) * regionVerts * sizeof(StreamVertex);
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+    persistent = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+    if (persistent)
+    {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, ringBytes, NULL, flags);
+        ring = (StreamVertex *)glMapBufferRange(GL_ARRAY_BUFFER, 0, ringBytes, flags);
+        if (ring == NULL)
+        {
+            // Buffer storage is immutable: start over with a plain buffer
+            printf("PolylineStream: persistent mapping failed, mapping per region instead.\n");
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glDeleteBuffers(1, &vbo);
+            glGenBuffers(1, &vbo);
+            glBindBuffer(GL_ARRAY_BUFFER, vbo);
+            persistent = false;
+        }
+    }
+    if (!persistent)
+    {
+        glBufferData(GL_ARRAY_BUFFER, ringBytes, NULL, GL_STREAM_DRAW);
+    }
+
+    // Positions are two floats, colors four normalized bytes (the shader reads r,g,b)
+    glVertexAttribPointer(vertPos_loc, 2, GL_FLOAT, GL_FALSE, sizeof(StreamVertex), (void *)0);
+    glEnableVertexAttribArray(vertPos_loc);
+    glVertexAttribPointer(vertColor_loc, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(StreamVertex), (void *)(2 * sizeof(float)));
+    glEnableVertexAttribArray(vertColor_loc);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+inline void PolylineStream::cleanup()
+{
+    for (int i = 0; i < NumRegions; i++)
+    {
+        if (fence[i])
+        {
+            glDeleteSync(fence[i]);
+            fence[i] = 0;
+        }
+    }
+    if (persistent && ring)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    glDeleteBuffers(1, &vbo);
+    glDeleteVertexArrays(1, &vao);
+    ring = current = nullptr;
+    staging.clear();
+}
+
+// Wait until the GPU has finished the last draw from this region, then make
+// it writable. Returns whether the open strip's last vertex has to be
+// written again (see StripLayout.h).
+inline bool PolylineStream::beginRegion()
+{
+    if (fence[region])
+    {
+        GLenum status = glClientWaitSync(fence[region], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+        while (status == GL_TIMEOUT_EXPIRED)
+        {
+            status = glClientWaitSync(fence[region], 0, 1000000000);
+        }
+        glDeleteSync(fence[region]);
+        fence[region] = 0;
+    }
+
+    if (persistent)
+    {
+        current = ring + region * regionVerts;
+    }
+    else if (!staging.empty())
+    {
+        current = staging.data();
+    }
+    else
+    {
+        // The fence already ordered the writes, so the driver need not synchronize
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        current = (StreamVertex *)glMapBufferRange(GL_ARRAY_BUFFER, GLintptr(region) * regionVerts * sizeof(StreamVertex),
+                                                   GLsizeiptr(regionVerts) * sizeof(StreamVertex),
+                                                   GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        if (current == NULL)
+        {
+            // From now on every region is written here and uploaded in submitRegion()
+            printf("PolylineStream: mapping a region failed, uploading from a staging copy instead.\n");
+            staging.resize(regionVerts);
+            current = staging.data();
+        }
+    }
+    return layout.openRegion(region * regionVerts);
+}
+
+// Draw the strips of the current region, fence it and move on to the next region
+inline void PolylineStream::submitRegion()
+{
+    layout.closeRegion();
+
+    if (!persistent)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        if (staging.empty())
+        {
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
+        else
+        {
+            glBufferSubData(GL_ARRAY_BUFFER, GLintptr(region) * regionVerts * sizeof(StreamVertex),
+                            GLsizeiptr(layout.usedVertices()) * sizeof(StreamVertex), staging.data());
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    if (!layout.firsts().empty())
+    {
+        glBindVertexArray(vao);
+        glMultiDrawArrays(GL_LINE_STRIP, layout.firsts().data(), layout.counts().data(), GLsizei(layout.firsts().size()));
+        glBindVertexArray(0);
+    }
+    fence[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    streamed += layout.usedVertices();
+    layout.clearDraws();
+    current = nullptr;
+    region = (region + 1) % NumRegions;
+}
+
+inline void PolylineStream::beginStrip(float r, float g, float b)
+{
+    vertex.rgba[0] = (unsigned char)(r * 255.0f + 0.5f);
+    vertex.rgba[1] = (unsigned char)(g * 255.0f + 0.5f);
+    vertex.rgba[2] = (unsigned char)(b * 255.0f + 0.5f);
+    if (current == nullptr)
+    {
+        beginRegion();
+    }
+    layout.beginStrip();
+}
+
+inline void PolylineStream::addVertex(float x, float y)
+{
+    if (current == nullptr)
+    {
+        beginRegion();
+        layout.beginStrip();
+    }
+    else if (layout.full())
+    {
+        // Region full: draw it and continue the strip from its last vertex,
+        // if it has one yet
+        submitRegion();
+        if (beginRegion())
+        {
+            current[layout.add()] = vertex;
+        }
+    }
+
+    vertex.x = x;
+    vertex.y = y;
+    current[layout.add()] = vertex;
+}
+
+inline void PolylineStream::endStrip()
+{
+    layout.endStrip();
+}
+
+inline void PolylineStream::draw()
+{
+    if (current != nullptr)
+    {
+        endStrip();
+        submitRegion();
+    }
+}
@@ -19,6 +19,10 @@
  */
 
 // Use space to toggle what image is shown.
+// The next to last image is a concave star, triangulated once with
+//   Triangulate.h and drawn from an element (index) buffer.
+// The last image streams animated line strips through PolylineStream.h
+//   and prints the vertex rate once a second.
 // Use Escape or 'X' or 'x' to exit.
 
 // These libraries are needed to link the program (Visual Studio specific)
@@ -39,6 +43,12 @@ bool check_for_opengl_errors(); // Function prototype (should really go in a hea
 // Enable standard input and output via printf(), etc.
 // Put this include *after* the includes for glew and GLFW!
 #include <stdio.h>
+#include <math.h>
+
+#include <vector>
+
+#include "PolylineStream.h"
+#include "../CAT1 OpenGl/QUESTION 4- Polygon drawing/Triangulate.h"
 
 
 //from ShaderMgrSDM.cpp
@@ -208,25 +218,37 @@ GLuint check_link_status(GLuint program)
 // ********************
 
 int CurrentMode = 0; // Controls what is drawn.
+const int NumModes = 8;
+const int iConcaveMode = 6; // Mode that fills the concave star
+const int iStreamMode = 7;  // Mode that animates the streamed polylines
 
 // ************************
 // General data helping with setting up VAO (Vertex Array Objects)
 //    and Vertex Buffer Objects.
 // ***********************
 
-const int NumObjects = 3;
+const int NumObjects = 4;
 const int iPoints = 0;
 const int iLines = 1;
 const int iTriangles = 2;
+const int iConcave = 3;
 
 unsigned int myVBO[NumObjects]; // Vertex Buffer Object - holds an array of data
 unsigned int myVAO[NumObjects]; // Vertex Array Object - holds info about how the vertex data is formatted
+unsigned int myEBO;             // Element Buffer Object - holds the triangle indices of the concave star
+int concaveIndexCount = 0;
 
 // We create one shader program: it consists of a vertex shader and a fragment shader
 unsigned int shaderProgram1;
 const unsigned int vertPos_loc = 0;   // Corresponds to "location = 0" in the verter shader definition
 const unsigned int vertColor_loc = 1; // Corresponds to "location = 1" in the verter shader definition
 
+// Line strips regenerated every frame are streamed through a ring buffer
+//    instead of being loaded once into a VBO with glBufferData.
+PolylineStream lineStream;
+const int NumStreamStrips = 256;      // Line strips per frame
+const int StreamStripVerts = 4096;    // Vertices per line strip
+
 
 // *************************
 // mySetupGeometries defines the scene data, especially vertex  positions and colors.
@@ -383,8 +405,67 @@ void mySetupGeometries()
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
 
+    // FOURTH GEOMETRY: A concave star, which GL_TRIANGLE_FAN cannot fill.
+    // Triangulate it once; the triangles are indices into its ten vertices,
+    //    kept in an element buffer that the VAO remembers.
+    struct StarVertex
+    {
+        float x, y;
+    };
+    StarVertex starVerts[10];
+    for (int i = 0; i < 10; i++)
+    {
+        float angle = 1.5707963f + i * 0.62831853f; // Start at the top, 36 degrees apart
+        float radius = (i % 2 == 0) ? 0.85f : 0.35f;
+        starVerts[i].x = radius * cosf(angle);
+        starVerts[i].y = radius * sinf(angle);
+    }
+    std::vector<uint32_t> starIndices;
+    triangulatePolygon(starVerts, 10, starIndices);
+    concaveIndexCount = (int)starIndices.size();
+
+    glGenBuffers(1, &myEBO);
+    glBindVertexArray(myVAO[iConcave]);
+    glBindBuffer(GL_ARRAY_BUFFER, myVBO[iConcave]);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(starVerts), starVerts, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, myEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, starIndices.size() * sizeof(uint32_t), starIndices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(vertPos_loc, 2, GL_FLOAT, GL_FALSE, sizeof(StarVertex), (void *)0);
+    glEnableVertexAttribArray(vertPos_loc);
+    glBindVertexArray(0); // Unbind the VAO first: it keeps the element buffer binding
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    // FIFTH GEOMETRY: Streamed line strips. Only the ring buffer is set up here;
+    //    the vertices are written every frame in myStreamScene().
+    lineStream.setup(vertPos_loc, vertColor_loc);
+    printf("Streaming line strips with %s.\n",
+           lineStream.isPersistent() ? "a persistently mapped buffer" : "glMapBufferRange per region");
+
     check_for_opengl_errors(); // Really a great idea to check for errors -- esp. good for debugging!
 }
+
+// *************************************
+// myStreamScene() writes NumStreamStrips animated sine curves into the
+//    stream and draws them. Nothing is kept between frames.
+// *************************************
+void myStreamScene(double time)
+{
+    for (int i = 0; i < NumStreamStrips; i++)
+    {
+        float s = (float)i / (NumStreamStrips - 1); // 0..1 across the strips
+        float offset = -0.9f + 1.8f * s;
+        float phase = (float)time * (1.0f + s) + 6.0f * s;
+        lineStream.beginStrip(s, 1.0f - s, 0.6f);
+        for (int j = 0; j < StreamStripVerts; j++)
+        {
+            float x = -1.0f + 2.0f * j / (StreamStripVerts - 1);
+            lineStream.addVertex(x, offset + 0.05f * sinf(8.0f * x + phase));
+        }
+        lineStream.endStrip();
+    }
+    lineStream.draw();
+}
 // *************************************
 // Main routine for rendering the scene
 // myRenderScene() is called every time the scene needs to be redrawn.
@@ -438,6 +519,16 @@ void myRenderScene()
         glVertexAttrib3f(vertColor_loc, 1.0f, 0.5f, 0.2f); // An orange-red color (R, G, B values).
         glDrawArrays(GL_POINTS, 0, 3);
         break;
+    case iConcaveMode:
+        // Draw the triangulated star from its element buffer
+        glBindVertexArray(myVAO[iConcave]);
+        glVertexAttrib3f(vertColor_loc, 1.0f, 0.8f, 0.1f); // Gold color (R, G, B values).
+        glDrawElements(GL_TRIANGLES, concaveIndexCount, GL_UNSIGNED_INT, (void *)0);
+        break;
+    case iStreamMode:
+        // Draw streamed line strips (colors are per vertex)
+        myStreamScene(glfwGetTime());
+        break;
     }
 
     glBindVertexArray(0);      // Not necessary, but a good idea
@@ -468,7 +559,7 @@ void key_callback(GLFWwindow *window, int key, int scancode, int action, int mod
     }
     else if (key == GLFW_KEY_SPACE)
     {
-        CurrentMode = (CurrentMode + 1) % 6; // Takes on values from 0 to 5
+        CurrentMode = (CurrentMode + 1) % NumModes; // Takes on values from 0 to NumModes-1
     }
 }
 
@@ -583,6 +674,10 @@ int main()
 
     my_setup_SceneData();
 
+    // Vertex rate of the streamed mode, reported once a second
+    double reportTime = glfwGetTime();
+    long long reportVerts = 0;
+
     // Loop while program is not terminated.
     while (!glfwWindowShouldClose(window))
     {
@@ -591,11 +686,29 @@ int main()
         glfwSwapBuffers(window); // Displays what was just rendered (using double buffering).
 
         // Poll events (key presses, mouse events)
-        glfwWaitEvents(); // Use this if no animation.
-                          // glfwWaitEventsTimeout(1.0/60.0);	// Use this to animate at 60 frames/sec (timing is NOT reliable)
-        //  glfwPollEvents();				// Use this version when animating as fast as possible
+        if (CurrentMode == iStreamMode)
+        {
+            glfwPollEvents(); // Animate the streamed lines as fast as possible
+            double now = glfwGetTime();
+            if (now - reportTime >= 1.0)
+            {
+                long long verts = lineStream.verticesStreamed();
+                printf("Streamed %.1f million line vertices/sec.\n", (verts - reportVerts) / (now - reportTime) / 1e6);
+                reportTime = now;
+                reportVerts = verts;
+            }
+        }
+        else
+        {
+            glfwWaitEvents(); // Use this if no animation.
+                              // glfwWaitEventsTimeout(1.0/60.0);	// Use this to animate at 60 frames/sec (timing is NOT reliable)
+            reportTime = glfwGetTime();
+            reportVerts = lineStream.verticesStreamed();
+        }
     }
 
+    lineStream.cleanup();
+    glDeleteBuffers(1, &myEBO);
     glfwTerminate();
     return 0;
 }
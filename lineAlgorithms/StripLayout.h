@@ -0,0 +1,90 @@
+// *******************************
+// StripLayout.h
+//
+// Bookkeeping of PolylineStream.h without the GL calls: which slots of a
+// ring region the vertices of each line strip take, and which strips a
+// region draws.
+//
+// A strip that does not fit in a region continues in the next one. That
+// region starts with the strip's last vertex again so no segment is lost,
+// unless the strip has no vertex yet (it was begun on a full region); then
+// the strip simply starts at slot 0.
+//
+// Driving it (as PolylineStream does):
+//     openRegion(base)            // Region mapped; base = first vertex in the ring
+//     beginStrip(); slot = add(); ... endStrip();
+//     when full(): closeRegion(), draw firsts()/counts(), clearDraws(),
+//                  then if openRegion(next) write the carried vertex to add()
+// *******************************
+
+#pragma once
+
+#include <vector>
+
+class StripLayout
+{
+public:
+    void setup(int verticesPerRegion) { regionVerts = verticesPerRegion; }
+
+    // Start filling a region whose first vertex is base in the ring. Returns
+    // whether the open strip's last vertex must be written again to add()
+    // before the next one.
+    bool openRegion(int base)
+    {
+        bool carry = stripStart >= 0 && used > stripStart;
+        regionBase = base;
+        used = 0;
+        if (stripStart >= 0)
+        {
+            stripStart = 0;
+        }
+        return carry;
+    }
+
+    // Record the open strip's part of the current region for drawing
+    void closeRegion() { record(); }
+
+    void beginStrip() { stripStart = used; }
+    bool stripOpen() const { return stripStart >= 0; }
+
+    void endStrip()
+    {
+        record();
+        stripStart = -1;
+    }
+
+    bool full() const { return used == regionVerts; }
+
+    // Slot of the next vertex in the current region (which must not be full)
+    int add() { return used++; }
+
+    int usedVertices() const { return used; }
+
+    // Strips to draw, as ring offsets and vertex counts for glMultiDrawArrays
+    const std::vector<int> &firsts() const { return drawFirsts; }
+    const std::vector<int> &counts() const { return drawCounts; }
+
+    void clearDraws()
+    {
+        drawFirsts.clear();
+        drawCounts.clear();
+    }
+
+private:
+    int regionVerts = 0;
+    int regionBase = 0;
+    int used = 0;        // Vertices written in the current region
+    int stripStart = -1; // First vertex of the open strip, or -1
+    std::vector<int> drawFirsts;
+    std::vector<int> drawCounts;
+
+    // A strip with one vertex in the region draws no segment there
+    void record()
+    {
+        if (stripStart >= 0 && used - stripStart >= 2)
+        {
+            drawFirsts.push_back(regionBase + stripStart);
+            drawCounts.push_back(used - stripStart);
+        }
+    }
+};